@@ -0,0 +1,620 @@
+/**
+* @file  OS_port_host.c
+* @brief Port del SO para simulacion en Linux/POSIX
+* @note  Reemplaza a OS_port.c, PendSVHandler.S y OS_irq.c del port Cortex-M4
+* @note  Copyright 2019 - Esp. Ing. Matias Alvarez.
+*/
+
+/*==================[inclusions]=============================================*/
+#define _GNU_SOURCE
+#include "OS_port.h"
+#include "OS_irq.h"
+#include <signal.h>
+#include <ucontext.h>
+#include <pthread.h>
+#include <sys/time.h>
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+/*==================[macros]=================================================*/
+/**
+* @def HOST_TICK_SIGNAL
+* @brief Señal que simula la interrupcion del SysTick
+*/
+#define HOST_TICK_SIGNAL    SIGALRM
+
+/**
+* @def HOST_IRQ_SIGNAL
+* @brief Señal que simula las interrupciones de perifericos
+*/
+#define HOST_IRQ_SIGNAL     SIGUSR1
+
+/**
+* @def HOST_IRQ_WORDS
+* @brief Cantidad de palabras del bitmap de IRQs pendientes
+*/
+#define HOST_IRQ_WORDS      ( (OS_PORT_HOST_MAX_IRQ + 31) / 32 )
+/*==================[typedef]================================================*/
+
+/*==================[internal data declaration]==============================*/
+/**
+* @var static ucontext_t hostTaskContext[OS_MAX_TASK + 1]
+* @brief Contexto de cada tarea, incluyendo la idle task
+*/
+static ucontext_t hostTaskContext[OS_MAX_TASK + 1];
+
+/**
+* @var static ucontext_t hostMainContext
+* @brief Contexto de main(), desde el cual se arranca el scheduler
+*/
+static ucontext_t hostMainContext;
+
+/**
+* @var static taskFunction_t hostTaskFx[OS_MAX_TASK + 1]
+* @brief Funcion de cada tarea - makecontext() solo admite argumentos enteros
+*/
+static taskFunction_t hostTaskFx[OS_MAX_TASK + 1];
+
+/**
+* @var static void * hostTaskParameters[OS_MAX_TASK + 1]
+* @brief Parametros de cada tarea
+*/
+static void * hostTaskParameters[OS_MAX_TASK + 1];
+
+/**
+* @var static void (*hostReturnHook)(void)
+* @brief Funcion a ejecutarse si una tarea retorna
+*/
+static void (*hostReturnHook)(void);
+
+/**
+* @var static uint8_t hostRunningTask
+* @brief Tarea cuyo contexto esta cargado, OS_INVALID_TASK mientras corre main()
+*/
+static uint8_t hostRunningTask = OS_INVALID_TASK;
+
+/**
+* @var static volatile sig_atomic_t hostInIsr
+* @brief Indica si se esta ejecutando una IRQ simulada
+*/
+static volatile sig_atomic_t hostInIsr;
+
+/**
+* @var static volatile sig_atomic_t hostPendSwitch
+* @brief Equivalente al bit PENDSVSET - Cambio de contexto pendiente
+*/
+static volatile sig_atomic_t hostPendSwitch;
+
+/**
+* @var static volatile sig_atomic_t hostExclusive
+* @brief Monitor exclusivo de __LDREXW()/__STREXW() - Se limpia al entrar a una IRQ
+*/
+static volatile sig_atomic_t hostExclusive;
+
+/**
+* @var static sigset_t hostIrqSet
+* @brief Señales que simulan interrupciones
+*/
+static sigset_t hostIrqSet;
+
+/**
+* @var static pthread_t hostOsThread
+* @brief Hilo en el que corre el SO
+*/
+static pthread_t hostOsThread;
+
+/**
+* @var static uint8_t hostInitDone
+* @brief Indica si ya se instalaron los manejadores de señales
+*/
+static uint8_t hostInitDone;
+
+/**
+* @var static irqCbFunction_t hostIrqCb[OS_PORT_HOST_MAX_IRQ]
+* @brief Callbacks de las IRQs simuladas
+*/
+static irqCbFunction_t hostIrqCb[OS_PORT_HOST_MAX_IRQ];
+
+/**
+* @var static volatile uint32_t hostIrqPending[HOST_IRQ_WORDS]
+* @brief Bitmap de IRQs simuladas pendientes
+*/
+static volatile uint32_t hostIrqPending[HOST_IRQ_WORDS];
+/*==================[internal functions declaration]=========================*/
+void SysTick_Handler(void);
+
+static void hostSwitch(void);
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+* @fn static ucontext_t * hostContext(uint8_t taskId)
+* @brief Devuelve el contexto de una tarea
+* @param taskId : id de la tarea, OS_INVALID_TASK para el contexto de main()
+* @return Puntero al contexto
+*/
+static ucontext_t * hostContext(uint8_t taskId)
+{
+    return (OS_INVALID_TASK == taskId) ? &hostMainContext : &(hostTaskContext[taskId]);
+}
+
+/**
+* @fn static uint8_t hostIrqDisabled(void)
+* @brief Devuelve si las interrupciones simuladas estan deshabilitadas
+* @param Ninguno
+* @return true(1) si estan deshabilitadas, false(0) caso contrario
+*/
+static uint8_t hostIrqDisabled(void)
+{
+    sigset_t mask;
+
+    pthread_sigmask(SIG_BLOCK, NULL, &mask);
+
+    return sigismember(&mask, HOST_TICK_SIGNAL);
+}
+
+/**
+* @fn static void hostIsrEnter(void)
+* @brief Entrada a una IRQ simulada
+* @param Ninguno
+* @return Nada
+*/
+static void hostIsrEnter(void)
+{
+    hostInIsr++;
+    /* Como en el procesador, la entrada a una excepcion limpia el monitor exclusivo */
+    hostExclusive = 0;
+}
+
+/**
+* @fn static void hostIsrExit(void)
+* @brief Salida de una IRQ simulada - Ejecuta la pendSV si quedo pendiente
+* @param Ninguno
+* @return Nada
+*/
+static void hostIsrExit(void)
+{
+    hostInIsr--;
+    if(0 == hostInIsr && hostPendSwitch)
+    {
+        hostSwitch();
+    }
+}
+
+/**
+* @fn static void hostTickHandler(int signal)
+* @brief Manejador de la señal que simula el SysTick
+* @param signal : Señal recibida
+* @return Nada
+*/
+static void hostTickHandler(int signal)
+{
+    (void)signal;
+
+    hostIsrEnter();
+    SysTick_Handler();
+    hostIsrExit();
+}
+
+/**
+* @fn static void hostIrqHandler(int signal)
+* @brief Manejador de la señal que simula las IRQs de perifericos
+* @param signal : Señal recibida
+* @return Nada
+* @note Atiende todas las IRQs pendientes, de menor a mayor numero
+*/
+static void hostIrqHandler(int signal)
+{
+    uint8_t   w;        /**< Palabra del bitmap */
+    uint32_t  bits;     /**< IRQs pendientes de la palabra */
+    IRQn_Type IRQn;     /**< IRQ a atender */
+
+    (void)signal;
+
+    hostIsrEnter();
+    #if ( OS_USE_TASK_STATS == 1 )
+        osIsrEnter();
+    #endif
+
+    for(w = 0; w < HOST_IRQ_WORDS; w++)
+    {
+        /* Tomamos y limpiamos las IRQs pendientes de forma atomica */
+        bits = __atomic_exchange_n(&(hostIrqPending[w]), 0, __ATOMIC_SEQ_CST);
+        while(0 != bits)
+        {
+            IRQn = (w * 32) + __builtin_ctz(bits);
+            bits &= bits - 1;
+            if(NULL != hostIrqCb[IRQn])
+            {
+                hostIrqCb[IRQn]();
+            }
+        }
+    }
+
+    #if ( OS_USE_TASK_STATS == 1 )
+        osIsrExit();
+    #endif
+    hostIsrExit();
+}
+
+/**
+* @fn static void hostInit(void)
+* @brief Instala los manejadores de las señales que simulan interrupciones
+* @param Ninguno
+* @return Nada
+*/
+static void hostInit(void)
+{
+    struct sigaction action;
+
+    if(hostInitDone)
+    {
+        return;
+    }
+    hostInitDone = 1;
+
+    hostOsThread = pthread_self();
+
+    sigemptyset(&hostIrqSet);
+    sigaddset(&hostIrqSet, HOST_TICK_SIGNAL);
+    sigaddset(&hostIrqSet, HOST_IRQ_SIGNAL);
+
+    /* Las IRQs simuladas no se anidan entre si */
+    action.sa_mask  = hostIrqSet;
+    action.sa_flags = SA_RESTART;
+
+    action.sa_handler = hostTickHandler;
+    sigaction(HOST_TICK_SIGNAL, &action, NULL);
+
+    action.sa_handler = hostIrqHandler;
+    sigaction(HOST_IRQ_SIGNAL, &action, NULL);
+}
+
+/**
+* @fn static void hostSwitch(void)
+* @brief Equivalente a la pendSV - Llama al scheduler y carga el contexto de la tarea elegida
+* @param Ninguno
+* @return Nada
+* @note El contexto saliente queda detenido dentro de esta funcion y retoma desde aqui
+*/
+static void hostSwitch(void)
+{
+    sigset_t prevMask;                       /**< Mascara de señales del contexto saliente */
+    uint8_t  prevTask = hostRunningTask;     /**< Tarea saliente */
+    uint8_t  nextTask;                       /**< Tarea entrante */
+
+    /* Como la pendSV, el scheduler corre con las interrupciones deshabilitadas */
+    pthread_sigmask(SIG_BLOCK, &hostIrqSet, &prevMask);
+
+    hostPendSwitch = 0;
+    /* El contexto lo guarda ucontext, no el stack pointer */
+    taskSchedule(0);
+    nextTask = osGetCurrentTask();
+
+    if(nextTask != prevTask)
+    {
+        hostRunningTask = nextTask;
+        swapcontext(hostContext(prevTask), hostContext(nextTask));
+    }
+
+    pthread_sigmask(SIG_SETMASK, &prevMask, NULL);
+}
+
+/**
+* @fn static void hostTaskEntry(int taskId)
+* @brief Punto de entrada de todas las tareas
+* @param taskId : id de la tarea
+* @return NUNCA RETORNA
+*/
+static void hostTaskEntry(int taskId)
+{
+    /* Las tareas arrancan con las interrupciones habilitadas, como al salir de la pendSV */
+    osPortHostEnableIrq();
+
+    hostTaskFx[taskId](hostTaskParameters[taskId]);
+
+    hostReturnHook();
+}
+/*==================[external functions definition]==========================*/
+/**
+* @fn uint32_t osPortInitStack(uint8_t taskId, uint32_t * stack, uint32_t stackSize, taskFunction_t taskFx,
+                         void * parameters, void (*returnHook)(void))
+* @brief Funcion que arma el contexto inicial de una tarea sobre su stack
+* @param taskId     : id de la tarea
+* @param stack      : Puntero al stack de la tarea
+* @param stackSize  : Tamaño del stack de la tarea en bytes
+* @param taskFx     : Prototipo de la tarea
+* @param parameters : Puntero a los parametros a pasarle a la tarea
+* @param returnHook : Funcion a ejecutarse si la tarea retorna
+* @return 0 - El contexto se guarda en un ucontext_t y no en el stack pointer
+* @warning NO DEBE SER USADA POR EL USUARIO
+*/
+uint32_t osPortInitStack(uint8_t taskId, uint32_t * stack, uint32_t stackSize, taskFunction_t taskFx,
+                         void * parameters, void (*returnHook)(void))
+{
+    hostInit();
+
+    hostTaskFx[taskId]         = taskFx;
+    hostTaskParameters[taskId] = parameters;
+    hostReturnHook             = returnHook;
+
+    getcontext(&(hostTaskContext[taskId]));
+    hostTaskContext[taskId].uc_stack.ss_sp   = stack;
+    hostTaskContext[taskId].uc_stack.ss_size = stackSize;
+    hostTaskContext[taskId].uc_link          = NULL;
+    /* El contexto se carga desde el scheduler, con las interrupciones deshabilitadas */
+    sigaddset(&(hostTaskContext[taskId].uc_sigmask), HOST_TICK_SIGNAL);
+    sigaddset(&(hostTaskContext[taskId].uc_sigmask), HOST_IRQ_SIGNAL);
+    makecontext(&(hostTaskContext[taskId]), (void (*)(void))hostTaskEntry, 1, (int)taskId);
+
+    return 0;
+}
+
+/**
+* @fn void osPortStartTick(uint32_t tickRateHz)
+* @brief Funcion que arranca el tick del sistema con un timer de intervalo
+* @param tickRateHz : Frecuencia del tick del sistema
+* @return Nada
+* @warning NO DEBE SER USADA POR EL USUARIO
+*/
+void osPortStartTick(uint32_t tickRateHz)
+{
+    struct itimerval timer;
+
+    hostInit();
+
+    timer.it_interval.tv_sec  = 0;
+    timer.it_interval.tv_usec = 1000000 / tickRateHz;
+    timer.it_value            = timer.it_interval;
+    setitimer(ITIMER_REAL, &timer, NULL);
+}
+
+/**
+* @fn void osPortCycleCounterInit(void)
+* @brief Funcion que habilita el contador de ciclos - En el host no hace falta
+* @param Ninguno
+* @return Nada
+* @warning NO DEBE SER USADA POR EL USUARIO
+*/
+void osPortCycleCounterInit(void)
+{
+    /* DO NOTHING */
+}
+
+/**
+* @fn uint32_t osPortHostCycleCount(void)
+* @brief Equivalente a la lectura del contador de ciclos del DWT
+* @param Ninguno
+* @return Nanosegundos del reloj monotonico, truncados a 32 bits
+*/
+uint32_t osPortHostCycleCount(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint32_t)((uint64_t)now.tv_sec * 1000000000ULL + now.tv_nsec);
+}
+
+/**
+* @fn void osPortHostDisableIrq(void)
+* @brief Equivalente a __disable_irq()
+* @param Ninguno
+* @return Nada
+* @note Dentro de una IRQ simulada no tiene efecto, las IRQs simuladas no se anidan
+*/
+void osPortHostDisableIrq(void)
+{
+    if(0 == hostInIsr)
+    {
+        pthread_sigmask(SIG_BLOCK, &hostIrqSet, NULL);
+    }
+}
+
+/**
+* @fn void osPortHostEnableIrq(void)
+* @brief Equivalente a __enable_irq() - Ejecuta la pendSV si quedo pendiente
+* @param Ninguno
+* @return Nada
+* @note Dentro de una IRQ simulada no tiene efecto, las IRQs simuladas no se anidan
+*/
+void osPortHostEnableIrq(void)
+{
+    if(0 == hostInIsr)
+    {
+        pthread_sigmask(SIG_UNBLOCK, &hostIrqSet, NULL);
+        if(hostPendSwitch)
+        {
+            hostSwitch();
+        }
+    }
+}
+
+/**
+* @fn uint32_t osPortHostGetMask(void)
+* @brief Equivalente a __get_BASEPRI()
+* @param Ninguno
+* @return OS_PORT_SYSCALL_MASK si las IRQs simuladas estan bloqueadas, 0 si no
+* @note Dentro de una IRQ simulada las IRQs simuladas siempre estan bloqueadas
+*/
+uint32_t osPortHostGetMask(void)
+{
+    sigset_t current;
+
+    if(0 != hostInIsr)
+    {
+        return OS_PORT_SYSCALL_MASK;
+    }
+
+    pthread_sigmask(SIG_BLOCK, NULL, &current);
+
+    return sigismember(&current, HOST_TICK_SIGNAL) ? OS_PORT_SYSCALL_MASK : 0;
+}
+
+/**
+* @fn void osPortHostSetMask(uint32_t mask)
+* @brief Equivalente a __set_BASEPRI()
+* @param mask : 0 desbloquea las IRQs simuladas, cualquier otro valor las bloquea
+* @return Nada
+* @note Dentro de una IRQ simulada no tiene efecto, las IRQs simuladas no se anidan
+*/
+void osPortHostSetMask(uint32_t mask)
+{
+    if(0 != mask)
+    {
+        osPortHostDisableIrq();
+    }
+    else
+    {
+        osPortHostEnableIrq();
+    }
+}
+
+/**
+* @fn void osPortHostWaitForIrq(void)
+* @brief Equivalente a __WFI() - Duerme el hilo hasta la proxima IRQ simulada
+* @param Ninguno
+* @return Nada
+*/
+void osPortHostWaitForIrq(void)
+{
+    sigset_t prevMask;  /**< Mascara de señales previa */
+    sigset_t waitMask;  /**< Mascara de señales durante la espera */
+
+    /* Bloqueamos y esperamos de forma atomica para no perder una IRQ entre ambas operaciones */
+    pthread_sigmask(SIG_BLOCK, &hostIrqSet, &prevMask);
+    waitMask = prevMask;
+    sigdelset(&waitMask, HOST_TICK_SIGNAL);
+    sigdelset(&waitMask, HOST_IRQ_SIGNAL);
+    sigsuspend(&waitMask);
+    pthread_sigmask(SIG_SETMASK, &prevMask, NULL);
+}
+
+/**
+* @fn void osPortHostPendSwitch(void)
+* @brief Equivalente a setear el bit PENDSVSET
+* @param Ninguno
+* @return Nada
+* @note Desde una tarea con las interrupciones habilitadas el cambio de contexto es inmediato
+*/
+void osPortHostPendSwitch(void)
+{
+    hostPendSwitch = 1;
+
+    if(0 == hostInIsr && !hostIrqDisabled())
+    {
+        hostSwitch();
+    }
+}
+
+/**
+* @fn uint32_t osPortHostLdrex(volatile uint32_t * addr)
+* @brief Equivalente a __LDREXW()
+* @param addr : Direccion a leer
+* @return Valor leido
+*/
+uint32_t osPortHostLdrex(volatile uint32_t * addr)
+{
+    hostExclusive = 1;
+
+    return *addr;
+}
+
+/**
+* @fn uint32_t osPortHostStrex(uint32_t value, volatile uint32_t * addr)
+* @brief Equivalente a __STREXW()
+* @param value : Valor a escribir
+* @param addr  : Direccion a escribir
+* @return 0 si se escribio, 1 si una IRQ simulada limpio el monitor exclusivo desde el __LDREXW()
+*/
+uint32_t osPortHostStrex(uint32_t value, volatile uint32_t * addr)
+{
+    sigset_t prevMask;
+    uint32_t retVal = 1;
+
+    pthread_sigmask(SIG_BLOCK, &hostIrqSet, &prevMask);
+
+    if(hostExclusive)
+    {
+        *addr = value;
+        retVal = 0;
+    }
+    hostExclusive = 0;
+
+    pthread_sigmask(SIG_SETMASK, &prevMask, NULL);
+
+    return retVal;
+}
+
+/**
+* @fn void osPortHostClrex(void)
+* @brief Equivalente a __CLREX()
+* @param Ninguno
+* @return Nada
+*/
+void osPortHostClrex(void)
+{
+    hostExclusive = 0;
+}
+
+/**
+* @fn osReturn_t irqAttach(IRQn_Type IRQn, irqCbFunction_t irqCbPointer, uint32_t priority)
+* @brief Adjunta un callback a una dada IRQ simulada
+* @params IRQn : Numero de interrupcion
+* @params irqCbPointer : Callback a adjuntar
+* @params priority : No se usa - Las IRQs simuladas no se anidan entre si
+* @return OS_RESULT_ERROR si ya habia un callback adjuntado, OS_RESULT_OK caso contrario
+*/
+osReturn_t irqAttach(IRQn_Type IRQn, irqCbFunction_t irqCbPointer, uint32_t priority)
+{
+    osReturn_t retVal = OS_RESULT_ERROR;
+
+    hostInit();
+
+    if(0 <= IRQn && OS_PORT_HOST_MAX_IRQ > IRQn && NULL == hostIrqCb[IRQn])
+    {
+        hostIrqCb[IRQn] = irqCbPointer;
+        retVal = OS_RESULT_OK;
+    }
+
+    return retVal;
+}
+
+/**
+* @fn osReturn_t irqDetach(IRQn_Type IRQn)
+* @brief Desadjunta un callback a una dada IRQ simulada
+* @params IRQn : Numero de interrupcion
+* @return OS_RESULT_ERROR si NO habia un callback adjuntado, OS_RESULT_OK caso contrario
+*/
+osReturn_t irqDetach(IRQn_Type IRQn)
+{
+    osReturn_t retVal = OS_RESULT_ERROR;
+
+    if(0 <= IRQn && OS_PORT_HOST_MAX_IRQ > IRQn && NULL != hostIrqCb[IRQn])
+    {
+        hostIrqCb[IRQn] = NULL;
+        retVal = OS_RESULT_OK;
+    }
+
+    return retVal;
+}
+
+/**
+* @fn void irqInject(IRQn_Type IRQn)
+* @brief Genera una IRQ simulada
+* @params IRQn : Numero de interrupcion
+* @return Nada
+* @note Puede ser llamada desde tareas, IRQs simuladas u otros hilos. Desde una tarea con las
+        interrupciones habilitadas la IRQ se atiende antes de retornar
+*/
+void irqInject(IRQn_Type IRQn)
+{
+    if(0 <= IRQn && OS_PORT_HOST_MAX_IRQ > IRQn)
+    {
+        __atomic_fetch_or(&(hostIrqPending[IRQn / 32]), 1UL << (IRQn & 31), __ATOMIC_SEQ_CST);
+        pthread_kill(hostOsThread, HOST_IRQ_SIGNAL);
+    }
+}
+/*==================[end of file]============================================*/
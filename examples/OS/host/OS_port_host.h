@@ -0,0 +1,113 @@
+/**
+* @file  OS_port_host.h
+* @brief Port del SO para simulacion en Linux/POSIX
+* @note  Provee las primitivas CMSIS que usa el SO, de forma que el kernel compile sin cambios:
+         - Las tareas son contextos ucontext sobre el stack provisto por el usuario
+         - Las interrupciones son señales: SIGALRM es el SysTick y SIGUSR1 las IRQs simuladas
+         - Deshabilitar interrupciones es bloquear dichas señales
+         - La pendSV se ejecuta al habilitar interrupciones o al salir de la IRQ simulada
+* @note  Todo el SO corre en un unico hilo. Si la aplicacion crea otros hilos, estos deben
+         bloquear SIGALRM y SIGUSR1 y generar IRQs con irqInject()
+* @note  Copyright 2019 - Esp. Ing. Matias Alvarez.
+*/
+#ifndef _OS_PORT_HOST_H_
+#define _OS_PORT_HOST_H_
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+/*==================[macros]=================================================*/
+/**
+* @def OS_PORT_HOST_MAX_IRQ
+* @brief Cantidad de IRQs simuladas
+* @note Igual a la cantidad de IRQs del LPC4337
+*/
+#define OS_PORT_HOST_MAX_IRQ            53
+
+/**
+* @def OS_PORT_PEND_SWITCH()
+* @brief Deja pendiente el cambio de contexto desde una tarea
+*/
+#define OS_PORT_PEND_SWITCH()           osPortHostPendSwitch()
+
+/**
+* @def OS_PORT_PEND_SWITCH_FROM_ISR()
+* @brief Deja pendiente el cambio de contexto desde una IRQ
+*/
+#define OS_PORT_PEND_SWITCH_FROM_ISR()  osPortHostPendSwitch()
+
+/**
+* @def OS_PORT_CYCLE_COUNT()
+* @brief Equivalente al contador de ciclos del DWT - En el host cuenta nanosegundos
+*/
+#define OS_PORT_CYCLE_COUNT()           osPortHostCycleCount()
+
+/**
+* @def OS_PORT_SYSCALL_MASK
+* @brief Mascara que enmascara las IRQs que llaman al SO
+* @note En el host todas las IRQs simuladas llaman al SO, por lo que equivale a bloquearlas todas
+*/
+#define OS_PORT_SYSCALL_MASK            1
+
+/**
+* @def OS_PORT_GET_MASK()
+* @brief Mascara de IRQs actual
+*/
+#define OS_PORT_GET_MASK()              osPortHostGetMask()
+
+/**
+* @def OS_PORT_SET_MASK(mask)
+* @brief Cambia la mascara de IRQs - 0 no enmascara ninguna IRQ
+*/
+#define OS_PORT_SET_MASK(mask)          osPortHostSetMask(mask)
+
+/* Primitivas CMSIS usadas por el SO */
+#define __disable_irq()                 osPortHostDisableIrq()
+#define __enable_irq()                  osPortHostEnableIrq()
+#define __WFI()                         osPortHostWaitForIrq()
+#define __DMB()                         __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define __DSB()                         __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define __ISB()                         __atomic_signal_fence(__ATOMIC_SEQ_CST)
+#define __CLZ(x)                        ( (0 == (uint32_t)(x)) ? 32 : __builtin_clz((uint32_t)(x)) )
+#define __LDREXW(addr)                  osPortHostLdrex(addr)
+#define __STREXW(value, addr)           osPortHostStrex(value, addr)
+#define __CLREX()                       osPortHostClrex()
+/*==================[typedef]================================================*/
+/**
+* @def IRQn_Type
+* @brief Numero de IRQ simulada, entre 0 y OS_PORT_HOST_MAX_IRQ - 1
+*/
+typedef int32_t IRQn_Type;
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+
+/*==================[external functions definition]==========================*/
+void osPortHostDisableIrq(void);
+
+void osPortHostEnableIrq(void);
+
+uint32_t osPortHostGetMask(void);
+
+void osPortHostSetMask(uint32_t mask);
+
+void osPortHostWaitForIrq(void);
+
+void osPortHostPendSwitch(void);
+
+uint32_t osPortHostCycleCount(void);
+
+uint32_t osPortHostLdrex(volatile uint32_t * addr);
+
+uint32_t osPortHostStrex(uint32_t value, volatile uint32_t * addr);
+
+void osPortHostClrex(void);
+
+void irqInject(IRQn_Type IRQn);
+/*==================[end of file]============================================*/
+#endif /* #ifndef _OS_PORT_HOST_H_ */
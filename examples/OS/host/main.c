@@ -0,0 +1,832 @@
+/**
+* @file  main.c
+* @brief Aplicacion de simulacion del SO en host
+* @note  Una IRQ simulada publica eventos numerados en una cola, una tarea los consume verificando
+         que no se pierdan ni se desordenen y despierta a otra tarea con una notificacion. Periodicamente
+         se suspende la tarea ping y se crean tareas worker, con stacks tomados de un pool, que esperan
+         un evento de la IRQ y se borran al retornar. Un timer periodico cuenta ticks y un timer de un disparo, reiniciado en cada
+         IRQ, detecta los periodos sin IRQs como un antirrebote. Otra IRQ simulada difiere trabajos
+         numerados a la tarea de trabajos diferidos, que verifica su orden. La IRQ de eventos tambien
+         envia un byte por evento a un buffer de stream, como una UART, y el consumidor registra
+         cada evento como un mensaje de largo variable en un buffer de mensajes. Tres tareas periodicas
+         de igual prioridad se ejecutan por deadline mas proximo(EDF), contabilizando sus trabajos y sus
+         deadlines perdidos. La IRQ de eventos y los trabajos diferidos registran cada evento con
+         OS_LOG(), y la tarea de estimulo saca los registros binarios antes de cada rafaga y los cuenta,
+         por lo que la cola de registros no debe descartar ninguno. Al cabo de
+         HOST_RUN_TICKS ticks se informan las estadisticas y se mide el peor tiempo de bloqueo de una
+         tarea de alta prioridad por una de baja que tiene el recurso, mientras una de prioridad media
+         ocupa la CPU: con un semaforo binario y con un mutex con herencia de prioridad. Con herencia
+         el bloqueo no debe superar la seccion critica de la tarea de baja prioridad
+* @note  Uso: OS_host [semilla] [ticks] [log.bin] - Con log.bin se guardan los registros de log para
+         decodificarlos con tools/oslog_decode.py
+* @note  Copyright 2019 - Esp. Ing. Matias Alvarez.
+*/
+
+/*==================[inclusions]=============================================*/
+/* OS Includes */
+#include "OS_config.h"
+#include "OS.h"
+#include "OS_queue.h"
+#include "OS_semphr.h"
+#include "OS_mutex.h"
+#include "OS_event.h"
+#include "OS_timer.h"
+#include "OS_pool.h"
+#include "OS_defer.h"
+#include "OS_stream.h"
+#include "OS_analysis.h"
+#include "OS_log.h"
+#include "OS_irq.h"
+
+/* C Includes */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+/*==================[macros]=================================================*/
+/**
+* @def HOST_EVENT_IRQ
+* @brief IRQ simulada que publica los eventos
+*/
+#define HOST_EVENT_IRQ          0
+
+/**
+* @def HOST_DEFER_IRQ
+* @brief IRQ simulada que difiere trabajos
+*/
+#define HOST_DEFER_IRQ          1
+
+/**
+* @def HOST_RUN_TICKS
+* @brief Ticks de simulacion por defecto
+*/
+#define HOST_RUN_TICKS          2000
+
+/**
+* @def HOST_MAX_BURST
+* @brief Maxima cantidad de IRQs generadas por tick
+*/
+#define HOST_MAX_BURST          8
+
+#if ( 2 * HOST_MAX_BURST > OS_LOG_QUEUE_LEN )
+    #error OS_LOG_QUEUE_LEN must hold the log records of a whole burst.
+#endif
+
+/**
+* @def QUEUE_LEN
+* @brief Largo de la cola de eventos
+*/
+#define QUEUE_LEN               5
+
+/**
+* @def HOST_WORKER_PERIOD
+* @brief Ticks entre la creacion de tareas worker
+*/
+#define HOST_WORKER_PERIOD      50
+
+/**
+* @def HOST_SUSPEND_PERIOD
+* @brief Ticks entre suspensiones de la tarea ping
+*/
+#define HOST_SUSPEND_PERIOD     100
+
+/**
+* @def HOST_WORKER_STACKS
+* @brief Cantidad de stacks del pool de stacks de las tareas worker
+*/
+#define HOST_WORKER_STACKS      2
+
+/**
+* @def HOST_INV_LOW_TICKS
+* @brief Ticks de CPU que la tarea de baja prioridad ocupa el recurso en la prueba de inversion de prioridades
+*/
+#define HOST_INV_LOW_TICKS      5
+
+/**
+* @def HOST_INV_MEDIUM_TICKS
+* @brief Ticks de CPU que ocupa la tarea de prioridad media en la prueba de inversion de prioridades
+*/
+#define HOST_INV_MEDIUM_TICKS   20
+
+/**
+* @def HOST_FLAG_IRQ
+* @brief Evento que setea la IRQ simulada
+*/
+#define HOST_FLAG_IRQ           (1UL << 0)
+
+/**
+* @def HOST_TIMER_PERIOD
+* @brief Periodo del timer periodico
+*/
+#define HOST_TIMER_PERIOD       10
+
+/**
+* @def HOST_QUIET_TICKS
+* @brief Ticks sin IRQs a partir de los cuales vence el timer antirrebote
+*/
+#define HOST_QUIET_TICKS        3
+
+/**
+* @def HOST_STREAM_SIZE
+* @brief Tamaño del buffer de stream
+*/
+#define HOST_STREAM_SIZE        16
+
+/**
+* @def HOST_STREAM_TRIGGER
+* @brief Bytes a partir de los cuales se despierta a la tarea rx
+*/
+#define HOST_STREAM_TRIGGER     4
+
+/**
+* @def HOST_MESSAGE_SIZE
+* @brief Tamaño del buffer de mensajes
+*/
+#define HOST_MESSAGE_SIZE       64
+
+/**
+* @def HOST_MESSAGE_MAX_LEN
+* @brief Largo maximo de un mensaje
+*/
+#define HOST_MESSAGE_MAX_LEN    32
+
+/**
+* @def HOST_PERIODIC_TASKS
+* @brief Cantidad de tareas periodicas
+*/
+#define HOST_PERIODIC_TASKS     3
+/*==================[typedef]================================================*/
+/**
+* @struct hostEvent_t
+* @brief Evento publicado por la IRQ simulada
+*/
+typedef struct
+{
+    uint32_t    seq;        /**< Numero de secuencia */
+    tick_t      tick;       /**< Tick de la IRQ */
+}hostEvent_t;
+/*==================[internal data declaration]==============================*/
+/**
+* @var static uint8_t g_eventQueueBuffer[QUEUE_LEN*sizeof(hostEvent_t)]
+* @brief Buffer para almacenar los elementos de la cola de eventos
+*/
+static uint8_t g_eventQueueBuffer[QUEUE_LEN*sizeof(hostEvent_t)];
+
+/**
+* @var static queue_t g_eventQueue
+* @brief Cola de eventos
+*/
+static queue_t g_eventQueue;
+
+/**
+* @var static uint8_t g_streamBuffer[HOST_STREAM_SIZE], g_messageBuffer[HOST_MESSAGE_SIZE]
+* @brief Memoria del buffer de stream y del buffer de mensajes
+*/
+static uint8_t g_streamBuffer[HOST_STREAM_SIZE];
+static uint8_t g_messageBuffer[HOST_MESSAGE_SIZE];
+
+/**
+* @var static stream_t g_rxStream, g_logMessages
+* @brief Buffer de stream que simula la recepcion de una UART y buffer de mensajes del registro de eventos
+*/
+static stream_t g_rxStream;
+static stream_t g_logMessages;
+
+/**
+* @var static const schedTask_t g_periodicSet[HOST_PERIODIC_TASKS]
+* @brief Periodos de las tareas periodicas y tiempos de ejecucion nominales para el analisis de planificabilidad
+* @note Con utilizacion cercana a 1 el conjunto es planificable con EDF pero no con rate-monotonic
+*/
+static const schedTask_t g_periodicSet[HOST_PERIODIC_TASKS] =
+{
+    { .period = 4, .deadline = 4, .wcet = 1 }
+,   { .period = 6, .deadline = 6, .wcet = 2 }
+,   { .period = 8, .deadline = 8, .wcet = 3 }
+};
+
+/**
+* @var static uint8_t g_periodicTaskId[HOST_PERIODIC_TASKS]
+* @brief id de las tareas periodicas
+*/
+static uint8_t g_periodicTaskId[HOST_PERIODIC_TASKS];
+
+/**
+* @var static volatile uint32_t g_periodicJobs[HOST_PERIODIC_TASKS]
+* @brief Trabajos ejecutados por cada tarea periodica
+*/
+static volatile uint32_t g_periodicJobs[HOST_PERIODIC_TASKS];
+
+/**
+* @var static event_t g_flags
+* @brief Grupo de eventos que esperan las tareas worker
+*/
+static event_t g_flags;
+
+/**
+* @var static osTimer_t g_periodicTimer, g_quietTimer
+* @brief Timer periodico y timer antirrebote
+*/
+static osTimer_t g_periodicTimer;
+static osTimer_t g_quietTimer;
+
+/**
+* @var static volatile uint32_t g_injected, g_dropped, g_received, g_outOfOrder, g_pings
+* @brief Estadisticas de la simulacion
+*/
+static volatile uint32_t g_injected;
+static volatile uint32_t g_dropped;
+static volatile uint32_t g_received;
+static volatile uint32_t g_outOfOrder;
+static volatile uint32_t g_pings;
+static volatile uint32_t g_workersCreated;
+static volatile uint32_t g_workersDone;
+static volatile uint32_t g_workerEvents;
+static volatile uint32_t g_timerFires;
+static volatile uint32_t g_quietPeriods;
+static volatile uint32_t g_workersReaped;
+static volatile uint32_t g_deferPosted;
+static volatile uint32_t g_deferDone;
+static volatile uint32_t g_deferOutOfOrder;
+static volatile tick_t   g_deferMaxLatency;
+static volatile uint32_t g_rxBytes;
+static volatile uint32_t g_rxDropped;
+static volatile uint32_t g_rxOutOfOrder;
+static volatile uint32_t g_messages;
+static volatile uint32_t g_messagesOutOfOrder;
+static volatile uint32_t g_logIrqPosted;
+static volatile uint32_t g_logTaskPosted;
+static uint32_t          g_logRecords;
+static uint32_t          g_logReportedDrops;
+static uint32_t          g_logBadRecords;
+static uint32_t          g_logBytes;
+
+/**
+* @var static void * g_workerStackBuffer[HOST_WORKER_STACKS * OS_MINIMAL_STACK_SIZE / sizeof(void *)]
+* @brief Memoria del pool de stacks de las tareas worker - De void * por la alineacion que requiere el pool
+*/
+static void * g_workerStackBuffer[HOST_WORKER_STACKS * OS_MINIMAL_STACK_SIZE / sizeof(void *)];
+
+/**
+* @var static pool_t g_workerStackPool
+* @brief Pool de stacks de las tareas worker
+*/
+static pool_t g_workerStackPool;
+
+/**
+* @var static uint8_t g_pingTaskId
+* @brief id de la tarea ping
+*/
+static uint8_t g_pingTaskId;
+
+/**
+* @var static unsigned int g_seed
+* @brief Semilla de la simulacion
+*/
+static unsigned int g_seed = 1;
+
+/**
+* @var static mutex_t g_invMutex, semaphore_t g_invSem
+* @brief Recurso de la prueba de inversion de prioridades, con y sin herencia de prioridad
+*/
+static mutex_t     g_invMutex;
+static semaphore_t g_invSem;
+
+/**
+* @var static volatile uint32_t g_invUseMutex, g_invHighDone, g_invMediumDone, tick_t g_invRequest, g_invAcquire
+* @brief Estado de la prueba de inversion de prioridades
+*/
+static volatile uint32_t g_invUseMutex;
+static volatile uint32_t g_invHighDone;
+static volatile uint32_t g_invMediumDone;
+static volatile tick_t   g_invRequest;
+static volatile tick_t   g_invAcquire;
+
+/**
+* @var static FILE * g_logFile
+* @brief Archivo donde se guardan los registros de log, NULL si no se guardan
+*/
+static FILE * g_logFile;
+
+/**
+* @var static tick_t g_runTicks
+* @brief Ticks de simulacion
+*/
+static tick_t g_runTicks = HOST_RUN_TICKS;
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+uint32_t consumerTaskStack[OS_MINIMAL_STACK_SIZE / sizeof(uint32_t)];
+uint32_t pingTaskStack[OS_MINIMAL_STACK_SIZE / sizeof(uint32_t)];
+uint32_t stimulusTaskStack[OS_MINIMAL_STACK_SIZE / sizeof(uint32_t)];
+uint32_t rxTaskStack[OS_MINIMAL_STACK_SIZE / sizeof(uint32_t)];
+uint32_t logTaskStack[OS_MINIMAL_STACK_SIZE / sizeof(uint32_t)];
+uint32_t periodicTaskStack[HOST_PERIODIC_TASKS][OS_MINIMAL_STACK_SIZE / sizeof(uint32_t)];
+/*==================[external functions definition]==========================*/
+void hostPrint(const char * line)
+{
+    fputs(line, stdout);
+}
+
+void hostLogDrain(void)
+{
+    uint8_t  buffer[4 * OS_LOG_RECORD_MAX_SIZE];
+    uint32_t len;
+    uint32_t i;
+    uint32_t words[1 + OS_LOG_MAX_ARGS];
+
+    /* Sin esperar: lo llama la tarea de estimulo, unico lector del log, antes de cada rafaga y al final */
+    while(0 < (len = logRead(buffer, sizeof(buffer), 0)))
+    {
+        g_logBytes += len;
+        if(NULL != g_logFile)
+        {
+            fwrite(buffer, 1, len, g_logFile);
+        }
+
+        /* Los registros de la aplicacion tienen 2 argumentos, el de descartados de logRead() uno solo */
+        for(i = 0; i < len; i += (1 + (words[0] & 0x07)) * sizeof(uint32_t))
+        {
+            memcpy(words, &buffer[i], sizeof(uint32_t) * (1 + (buffer[i] & 0x07)));
+            if(OS_LOG_SYNC == (words[0] & 0xF8) && 2 == (words[0] & 0x07))
+            {
+                g_logRecords++;
+            }
+            else if(OS_LOG_SYNC == (words[0] & 0xF8) && 1 == (words[0] & 0x07))
+            {
+                g_logReportedDrops += words[1];
+            }
+            else
+            {
+                g_logBadRecords++;
+            }
+        }
+    }
+}
+
+void eventIRQHandler(void)
+{
+    hostEvent_t event;
+    uint8_t     byte;
+
+    event.seq  = g_injected++;
+    event.tick = taskGetTickCount();
+
+    OS_LOG("irq: evento %u tick %u\n", event.seq, event.tick);
+    g_logIrqPosted++;
+
+    /* Hacemos el push dentro de una IRQ */
+    if(OS_RESULT_OK != queuePushFromISR(&g_eventQueue, (void *)&event))
+    {
+        g_dropped++;
+    }
+
+    /* Como una UART, cada evento recibe un byte que se pierde si el buffer de stream esta lleno */
+    byte = (uint8_t)event.seq;
+    if(0 == streamSendFromISR(&g_rxStream, &byte, sizeof(byte)))
+    {
+        g_rxDropped++;
+    }
+
+    eventSetFromISR(&g_flags, HOST_FLAG_IRQ);
+
+    /* Cada IRQ reinicia el timer antirrebote */
+    timerStartFromISR(&g_quietTimer);
+}
+
+void deferWork(void * arg, tick_t tick)
+{
+    static uint32_t nextSeq = 0;
+    uint32_t        seq = (uint32_t)(uintptr_t)arg;
+
+    /* Los trabajos descartados dejan huecos, pero nunca pueden volver hacia atras */
+    if(seq < nextSeq)
+    {
+        g_deferOutOfOrder++;
+    }
+    nextSeq = seq + 1;
+
+    if(taskGetTickCount() - tick > g_deferMaxLatency)
+    {
+        g_deferMaxLatency = taskGetTickCount() - tick;
+    }
+    g_deferDone++;
+
+    OS_LOG("diferido: trabajo %u latencia %u ticks\n", seq, taskGetTickCount() - tick);
+    g_logTaskPosted++;
+}
+
+void deferIRQHandler(void)
+{
+    /* La IRQ solo encola el trabajo */
+    irqDefer(deferWork, (void *)(uintptr_t)g_deferPosted++);
+}
+
+void consumerTask(void * parameters)
+{
+    hostEvent_t  event;
+    uint32_t nextSeq = 0;
+    char         message[HOST_MESSAGE_MAX_LEN];
+    int          len;
+
+    while(1)
+    {
+        queuePull(&g_eventQueue, (void *)&event, OS_MAX_DELAY);
+
+        /* Los eventos descartados dejan huecos, pero nunca pueden volver hacia atras */
+        if(event.seq < nextSeq)
+        {
+            g_outOfOrder++;
+        }
+        nextSeq = event.seq + 1;
+        g_received++;
+
+        /* Registramos el evento como un mensaje de largo variable, esperando lugar si hace falta */
+        len = snprintf(message, sizeof(message), "evento %u tick %u", (unsigned int)event.seq,
+                       (unsigned int)event.tick);
+        messageSend(&g_logMessages, message, (uint32_t)len, OS_MAX_DELAY);
+
+        taskNotifyGive(g_pingTaskId);
+    }
+}
+
+void rxTask(void * parameters)
+{
+    uint8_t  data[HOST_STREAM_SIZE];
+    uint8_t  expected = 0;
+    uint32_t received;
+    uint32_t i;
+
+    while(1)
+    {
+        /* Nos despiertan recien con HOST_STREAM_TRIGGER bytes, o al expirar el timeout con los que haya */
+        received = streamReceive(&g_rxStream, data, sizeof(data), 5);
+
+        /* Los bytes descartados dejan huecos, por lo que solo se verifica el orden si no hubo descartes */
+        for(i = 0; i < received; i++)
+        {
+            if(0 == g_rxDropped && expected != data[i])
+            {
+                g_rxOutOfOrder++;
+            }
+            expected = data[i] + 1;
+        }
+        g_rxBytes += received;
+    }
+}
+
+void logTask(void * parameters)
+{
+    char         message[HOST_MESSAGE_MAX_LEN + 1];
+    uint32_t     len;
+    unsigned int seq;
+    uint32_t     nextSeq = 0;
+
+    while(1)
+    {
+        len = messageReceive(&g_logMessages, message, HOST_MESSAGE_MAX_LEN, OS_MAX_DELAY);
+        message[len] = '\0';
+
+        /* Cada mensaje llega entero y en el orden en que lo envio el consumidor */
+        if(1 != sscanf(message, "evento %u", &seq) || seq < nextSeq)
+        {
+            g_messagesOutOfOrder++;
+        }
+        nextSeq = seq + 1;
+        g_messages++;
+    }
+}
+
+void periodicTask(void * parameters)
+{
+    uint32_t index = (uint32_t)(uintptr_t)parameters;
+
+    while(1)
+    {
+        g_periodicJobs[index]++;
+
+        /* Terminamos el trabajo y esperamos la proxima activacion */
+        taskWaitForNextPeriod();
+    }
+}
+
+void periodicTimerCallback(osTimer_t * timer)
+{
+    g_timerFires++;
+}
+
+void quietTimerCallback(osTimer_t * timer)
+{
+    g_quietPeriods++;
+}
+
+void taskReapHook(uint32_t * stack, uint32_t stackSize)
+{
+    /* Devolvemos el stack del worker al pool - Los stacks estaticos no pertenecen al pool */
+    if(OS_RESULT_OK == poolFree(&g_workerStackPool, stack))
+    {
+        g_workersReaped++;
+    }
+}
+
+void pingTask(void * parameters)
+{
+    while(1)
+    {
+        /* Cada notificacion es un ping. Si nos suspenden mientras esperamos la espera se aborta,
+           pero las notificaciones se siguen acumulando */
+        if(0 != taskNotifyTake(0, OS_MAX_DELAY))
+        {
+            g_pings++;
+        }
+    }
+}
+
+void workerTask(void * parameters)
+{
+    /* Esperamos la proxima IRQ, con timeout porque al final de la simulacion no hay mas IRQs */
+    if(OS_RESULT_OK == eventWait(&g_flags, HOST_FLAG_IRQ, EVENT_WAIT_ANY, true, 20, NULL))
+    {
+        g_workerEvents++;
+    }
+    g_workersDone++;
+
+    /* Al retornar la tarea se borra y su stack vuelve al pool */
+}
+
+void hostBusyTicks(uint32_t ticks)
+{
+    tick_t last = taskGetTickCount();
+
+    /* Si la tarea es desalojada, al volver el tick avanzo varias veces pero se cuenta una sola:
+       se mide tiempo de CPU de la tarea y no tiempo transcurrido */
+    while(0 < ticks)
+    {
+        if(last != taskGetTickCount())
+        {
+            last = taskGetTickCount();
+            ticks--;
+        }
+    }
+}
+
+void hostInversionLock(void)
+{
+    if(g_invUseMutex)
+    {
+        mutexLock(&g_invMutex, OS_MAX_DELAY);
+    }
+    else
+    {
+        semphrTake(&g_invSem, OS_MAX_DELAY);
+    }
+}
+
+void hostInversionUnlock(void)
+{
+    if(g_invUseMutex)
+    {
+        mutexUnlock(&g_invMutex);
+    }
+    else
+    {
+        semphrGive(&g_invSem);
+    }
+}
+
+void inversionHighTask(void * parameters)
+{
+    g_invRequest = taskGetTickCount();
+    hostInversionLock();
+    g_invAcquire = taskGetTickCount();
+    hostInversionUnlock();
+    g_invHighDone = 1;
+}
+
+void inversionMediumTask(void * parameters)
+{
+    hostBusyTicks(HOST_INV_MEDIUM_TICKS);
+    g_invMediumDone = 1;
+}
+
+tick_t hostInversionRun(uint32_t useMutex)
+{
+    uint32_t * highStack;
+    uint32_t * mediumStack;
+
+    /* Esperamos que se liberen los stacks de las tareas anteriores */
+    while(HOST_WORKER_STACKS > poolGetFree(&g_workerStackPool))
+    {
+        taskDelay(1);
+    }
+
+    g_invUseMutex   = useMutex;
+    g_invHighDone   = 0;
+    g_invMediumDone = 0;
+    highStack   = (uint32_t *)poolAlloc(&g_workerStackPool, 0);
+    mediumStack = (uint32_t *)poolAlloc(&g_workerStackPool, 0);
+
+    /* Esta tarea es la de baja prioridad: toma el recurso y la de alta prioridad se bloquea en el */
+    hostInversionLock();
+    taskCreate(inversionHighTask, 1, highStack, OS_MINIMAL_STACK_SIZE, "invHighTask", (void *)0, NULL);
+    taskYield();
+    /* Sin herencia, la de prioridad media desaloja a esta mientras tiene el recurso */
+    taskCreate(inversionMediumTask, 2, mediumStack, OS_MINIMAL_STACK_SIZE, "invMediumTask", (void *)0, NULL);
+    taskYield();
+    hostBusyTicks(HOST_INV_LOW_TICKS);
+    hostInversionUnlock();
+
+    while(!g_invHighDone || !g_invMediumDone)
+    {
+        taskDelay(1);
+    }
+
+    return g_invAcquire - g_invRequest;
+}
+
+void stimulusTask(void * parameters)
+{
+    struct timespec start;
+    uint32_t        misses = 0;
+    uint32_t        jobsOk = 1;
+    uint32_t        ok;
+    tick_t          semphrBlocking;
+    tick_t          mutexBlocking;
+    tick_t          ticks;
+    uint32_t        i;
+    struct timespec end;
+    uint32_t        burst;
+    uint32_t *      stack;
+    double          seconds;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    while(g_runTicks > taskGetTickCount())
+    {
+        /* Una rafaga genera hasta 2 * HOST_MAX_BURST registros de log, que entran en la cola vacia */
+        hostLogDrain();
+
+        /* Rafaga de IRQs de largo aleatorio, que puede desbordar la cola */
+        for(burst = rand_r(&g_seed) % (HOST_MAX_BURST + 1); 0 < burst; burst--)
+        {
+            irqInject(HOST_EVENT_IRQ);
+            irqInject(HOST_DEFER_IRQ);
+        }
+
+        /* Suspendemos por un tick a la tarea ping, los pings se acumulan en su notificacion */
+        if(0 == taskGetTickCount() % HOST_SUSPEND_PERIOD)
+        {
+            taskSuspend(g_pingTaskId);
+            taskDelay(1);
+            taskResume(g_pingTaskId);
+        }
+
+        /* Creamos un worker si hay un stack libre en el pool, sin esperarlo */
+        if(0 == taskGetTickCount() % HOST_WORKER_PERIOD &&
+           NULL != (stack = (uint32_t *)poolAlloc(&g_workerStackPool, 0)))
+        {
+            if(OS_RESULT_OK == taskCreate(workerTask, 2, stack, OS_MINIMAL_STACK_SIZE, "workerTask", 
+                                          (void *)0, NULL))
+            {
+                g_workersCreated++;
+            }
+            else
+            {
+                poolFree(&g_workerStackPool, stack);
+            }
+        }
+        taskDelay(1);
+    }
+
+    /* Dejamos que el consumidor vacie la cola */
+    taskDelay(10);
+
+    hostLogDrain();
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+
+    printf("ticks: %u en %.3f s\n", (unsigned int)taskGetTickCount(), seconds);
+    printf("eventos: %u generados, %u recibidos, %u descartados, %u desordenados\n",
+           g_injected, g_received, g_dropped, g_outOfOrder);
+    printf("notificaciones: %u pings\n", g_pings);
+    printf("timers: %u disparos periodicos, %u periodos sin IRQs\n", g_timerFires, g_quietPeriods);
+    printf("workers: %u creados, %u terminados, %u stacks liberados, %u eventos\n", g_workersCreated, g_workersDone,
+           g_workersReaped, g_workerEvents);
+    printf("diferidos: %u encolados, %u ejecutados, %u descartados, %u desordenados, latencia maxima %u ticks\n",
+           g_deferPosted, g_deferDone, irqDeferGetDropped(), g_deferOutOfOrder, (unsigned int)g_deferMaxLatency);
+    printf("stream: %u bytes recibidos, %u descartados, %u desordenados\n", g_rxBytes, g_rxDropped,
+           g_rxOutOfOrder);
+    printf("mensajes: %u recibidos, %u desordenados\n", g_messages, g_messagesOutOfOrder);
+    printf("log: %u registros, %u bytes, %u descartados(%u informados), %u invalidos\n", g_logRecords, g_logBytes,
+           logGetDropped(), g_logReportedDrops, g_logBadRecords);
+    printf("periodicas:");
+    ticks = taskGetTickCount();
+    for(i = 0; i < HOST_PERIODIC_TASKS; i++)
+    {
+        /* Cada tarea ejecuta un trabajo por periodo desde el tick 0 */
+        misses += taskGetDeadlineMisses(g_periodicTaskId[i]);
+        jobsOk &= (g_periodicJobs[i] + 1 >= ticks / g_periodicSet[i].period &&
+                   g_periodicJobs[i] <= ticks / g_periodicSet[i].period + 2);
+        printf(" T=%u %u trabajos %u perdidos,", (unsigned int)g_periodicSet[i].period, g_periodicJobs[i],
+               (unsigned int)taskGetDeadlineMisses(g_periodicTaskId[i]));
+    }
+    printf(" analisis: U=%u/1000 EDF %s, RM %s\n", (unsigned int)schedUtilization(g_periodicSet, HOST_PERIODIC_TASKS),
+           (OS_RESULT_OK == schedEdfTest(g_periodicSet, HOST_PERIODIC_TASKS)) ? "factible" : "no factible",
+           (OS_RESULT_OK == schedRmTest(g_periodicSet, HOST_PERIODIC_TASKS, NULL)) ? "factible" : "no factible");
+    printf("pool: %u de %u stacks libres, maximo %u en uso\n", (unsigned int)poolGetFree(&g_workerStackPool),
+           HOST_WORKER_STACKS, (unsigned int)poolGetHighWater(&g_workerStackPool));
+
+    #if ( OS_USE_TASK_STATS == 1 )
+        /* Uso de CPU de cada tarea durante la simulacion */
+        osTaskStatsDump(hostPrint);
+    #endif
+
+    #if ( OS_USE_STACK_CHECK == 1 )
+        /* Stack que nunca uso cada tarea - Las tareas tienen id segun su orden de creacion */
+        printf("stack libre: consumerTask %lu, pingTask %lu, stimulusTask %lu bytes\n",
+               (unsigned long)taskGetStackHighWaterMark(0), (unsigned long)taskGetStackHighWaterMark(1),
+               (unsigned long)taskGetStackHighWaterMark(2));
+    #endif
+
+    ok = (g_injected == g_received + g_dropped && 0 == g_outOfOrder && g_pings == g_received &&
+          0 < g_workersCreated && g_workersCreated == g_workersDone && g_workersDone == g_workersReaped &&
+          HOST_WORKER_STACKS == poolGetFree(&g_workerStackPool) &&
+          g_deferPosted == g_deferDone + irqDeferGetDropped() && 0 == g_deferOutOfOrder &&
+          g_injected == g_rxBytes + g_rxDropped && 0 == g_rxOutOfOrder &&
+          g_messages == g_received && 0 == g_messagesOutOfOrder && jobsOk && 0 == misses &&
+          g_logIrqPosted + g_logTaskPosted == g_logRecords + logGetDropped() &&
+          0 == logGetDropped() && 0 == g_logReportedDrops && 0 == g_logBadRecords &&
+          g_timerFires + 1 >= taskGetTickCount() / HOST_TIMER_PERIOD &&
+          g_timerFires <= taskGetTickCount() / HOST_TIMER_PERIOD + 1);
+
+    /* Inversion de prioridades: al terminar la simulacion los stacks del pool quedan libres para las tareas
+       de alta y media prioridad */
+    semphrInit(&g_invSem);
+    semphrGive(&g_invSem);
+    mutexInit(&g_invMutex);
+    semphrBlocking = hostInversionRun(0);
+    mutexBlocking  = hostInversionRun(1);
+    printf("inversion: bloqueo de la tarea de alta prioridad %u ticks con semaforo, %u ticks con mutex "
+           "(seccion critica %u ticks)\n", (unsigned int)semphrBlocking, (unsigned int)mutexBlocking,
+           HOST_INV_LOW_TICKS);
+
+    /* Con herencia el bloqueo esta acotado por la seccion critica, mas la fraccion del tick en que se pidio */
+    exit((ok && mutexBlocking <= HOST_INV_LOW_TICKS + 1) ? 0 : 1);
+}
+
+int main(int argc, char * argv[])
+{
+    uint32_t i;
+
+    if(1 < argc)
+    {
+        g_seed = strtoul(argv[1], NULL, 0);
+    }
+    if(2 < argc)
+    {
+        g_runTicks = strtoul(argv[2], NULL, 0);
+    }
+    if(3 < argc)
+    {
+        g_logFile = fopen(argv[3], "wb");
+    }
+
+    /* Inicializamos la cola, los buffers, el grupo de eventos, el pool de stacks y los timers */
+    queueInit(&g_eventQueue, QUEUE_LEN, g_eventQueueBuffer, sizeof(hostEvent_t));
+    streamInit(&g_rxStream, g_streamBuffer, sizeof(g_streamBuffer), HOST_STREAM_TRIGGER);
+    messageInit(&g_logMessages, g_messageBuffer, sizeof(g_messageBuffer));
+    eventInit(&g_flags);
+    poolInit(&g_workerStackPool, g_workerStackBuffer, OS_MINIMAL_STACK_SIZE, HOST_WORKER_STACKS);
+    timerInit(&g_periodicTimer, HOST_TIMER_PERIOD, true, periodicTimerCallback, NULL);
+    timerInit(&g_quietTimer, HOST_QUIET_TICKS, false, quietTimerCallback, NULL);
+    timerStart(&g_periodicTimer);
+
+    irqAttach(HOST_EVENT_IRQ, eventIRQHandler, OS_MAX_SYSCALL_IRQ_PRIO);
+    irqAttach(HOST_DEFER_IRQ, deferIRQHandler, OS_MAX_SYSCALL_IRQ_PRIO);
+
+    /* Creacion de las tareas */
+    /* Menor numero mayor prioridad */
+    taskCreate(consumerTask, 1, consumerTaskStack, OS_MINIMAL_STACK_SIZE, "consumerTask", (void *)0, NULL);
+    taskCreate(pingTask, 2, pingTaskStack, OS_MINIMAL_STACK_SIZE, "pingTask", (void *)0, &g_pingTaskId);
+    taskCreate(stimulusTask, 3, stimulusTaskStack, OS_MINIMAL_STACK_SIZE, "stimulusTask", (void *)0, NULL);
+    taskCreate(rxTask, 2, rxTaskStack, OS_MINIMAL_STACK_SIZE, "rxTask", (void *)0, NULL);
+    taskCreate(logTask, 3, logTaskStack, OS_MINIMAL_STACK_SIZE, "logTask", (void *)0, NULL);
+    for(i = 0; i < HOST_PERIODIC_TASKS; i++)
+    {
+        /* Todas con la misma prioridad, el scheduler las ordena por deadline */
+        taskCreatePeriodic(periodicTask, 2, periodicTaskStack[i], OS_MINIMAL_STACK_SIZE, "periodicTask",
+                           (void *)(uintptr_t)i, g_periodicSet[i].period, g_periodicSet[i].deadline,
+                           &g_periodicTaskId[i]);
+    }
+
+    /* Start the scheduler */
+    taskStartScheduler();
+
+    /* No se deberia arribar aqui nunca */
+    return 1;
+}
+
+/*==================[end of file]============================================*/
@@ -9,6 +9,7 @@
 
 /*==================[inclusions]=============================================*/
 #include <stdint.h>
+#include <stdbool.h>
 #include "OS_config.h"
 /*==================[macros]=================================================*/
 #ifndef OS_MINIMAL_STACK_SIZE
@@ -27,6 +28,10 @@
     #error OS_MAX_TASK must be defined in OS_config.h to be greater than or equal to 1.
 #endif
 
+#if OS_MAX_TASK > 254
+    #error OS_MAX_TASK must be defined in OS_config.h to be less than or equal to 254.
+#endif
+
 #ifndef OS_TICKS_UNTIL_SCHEDULE
     #error Missing definition:  OS_TICKS_UNTIL_SCHEDULE must be defined in OS_config.h as either 1 or 0.
 #endif
@@ -39,6 +44,10 @@
     #error OS_MAX_TASK_PRIORITY must be defined to be greater than or equal to 1.
 #endif
 
+#if OS_MAX_TASK_PRIORITY > 32
+    #error OS_MAX_TASK_PRIORITY must be defined to be less than or equal to 32.
+#endif
+
 #ifndef OS_MAX_TASK_NAME_LEN
     #error Missing definition:  OS_MAX_TASK_NAME_LEN must be defined in OS_config.h.
 #endif
@@ -51,6 +60,30 @@
     #error Missing definition:  OS_USE_TICK_HOOK must be defined in OS_config.h as either 1 or 0.
 #endif
 
+#ifndef OS_MAX_SYSCALL_IRQ_PRIO
+    #error Missing definition:  OS_MAX_SYSCALL_IRQ_PRIO must be defined in OS_config.h.
+#endif
+
+#if OS_MAX_SYSCALL_IRQ_PRIO < 1
+    #error OS_MAX_SYSCALL_IRQ_PRIO must be defined to be greater than or equal to 1.
+#endif
+
+#ifndef OS_USE_TIMER
+    #define OS_USE_TIMER        0
+#elif (OS_USE_TIMER == 1)
+    #ifndef OS_USE_SEMPHR
+        #define OS_USE_SEMPHR   1
+    #elif (OS_USE_SEMPHR != 1)
+        #error OS_USE_SEMPHR must be defined to be equal to 1 when OS_USE_TIMER == 1.
+    #endif
+    #ifndef OS_TIMER_TASK_PRIORITY
+        #define OS_TIMER_TASK_PRIORITY  1
+    #endif
+    #ifndef OS_TIMER_STACK_SIZE
+        #define OS_TIMER_STACK_SIZE     OS_MINIMAL_STACK_SIZE
+    #endif
+#endif
+
 #ifndef OS_USE_QUEUE
     #define OS_USE_QUEUE        0
 #elif (OS_USE_QUEUE == 1)
@@ -71,13 +104,185 @@
     #endif
 #endif
 
+#ifndef OS_USE_IRQ_DEFER
+    #define OS_USE_IRQ_DEFER    0
+#elif (OS_USE_IRQ_DEFER == 1)
+    #ifndef OS_USE_RING
+        #define OS_USE_RING     1
+    #elif (OS_USE_RING != 1)
+        #error OS_USE_RING must be defined to be equal to 1 when OS_USE_IRQ_DEFER == 1.
+    #endif
+    #ifndef OS_IRQ_DEFER_QUEUE_LEN
+        #define OS_IRQ_DEFER_QUEUE_LEN      16
+    #elif ( OS_IRQ_DEFER_QUEUE_LEN < 1 ) || ( 0 != ( OS_IRQ_DEFER_QUEUE_LEN & ( OS_IRQ_DEFER_QUEUE_LEN - 1 ) ) )
+        #error OS_IRQ_DEFER_QUEUE_LEN must be defined to be a power of 2.
+    #endif
+    #ifndef OS_IRQ_DEFER_TASK_PRIORITY
+        #define OS_IRQ_DEFER_TASK_PRIORITY  1
+    #endif
+    #ifndef OS_IRQ_DEFER_STACK_SIZE
+        #define OS_IRQ_DEFER_STACK_SIZE     OS_MINIMAL_STACK_SIZE
+    #endif
+#endif
+
+#ifndef OS_USE_LOG
+    #define OS_USE_LOG          0
+#elif (OS_USE_LOG == 1)
+    #ifndef OS_USE_RING
+        #define OS_USE_RING     1
+    #elif (OS_USE_RING != 1)
+        #error OS_USE_RING must be defined to be equal to 1 when OS_USE_LOG == 1.
+    #endif
+    #ifndef OS_LOG_QUEUE_LEN
+        #define OS_LOG_QUEUE_LEN            32
+    #elif ( OS_LOG_QUEUE_LEN < 1 ) || ( 0 != ( OS_LOG_QUEUE_LEN & ( OS_LOG_QUEUE_LEN - 1 ) ) )
+        #error OS_LOG_QUEUE_LEN must be defined to be a power of 2.
+    #endif
+    #ifndef OS_LOG_MAX_ARGS
+        #define OS_LOG_MAX_ARGS             4
+    #elif ( OS_LOG_MAX_ARGS < 0 ) || ( OS_LOG_MAX_ARGS > 7 )
+        #error OS_LOG_MAX_ARGS must be defined to be between 0 and 7.
+    #endif
+#endif
+
+#ifndef OS_USE_RING
+    #define OS_USE_RING         0
+#elif (OS_USE_RING == 1)
+    #ifndef OS_USE_TASK_DELAY
+        #define OS_USE_TASK_DELAY   1
+    #elif (OS_USE_TASK_DELAY != 1)    
+        #error OS_USE_TASK_DELAY must be defined to be equal to 1 when OS_USE_RING == 1.
+    #endif
+#endif
+
+#ifndef OS_USE_EVENT
+    #define OS_USE_EVENT        0
+#elif (OS_USE_EVENT == 1)
+    #ifndef OS_USE_TASK_DELAY
+        #define OS_USE_TASK_DELAY   1
+    #elif (OS_USE_TASK_DELAY != 1)    
+        #error OS_USE_TASK_DELAY must be defined to be equal to 1 when OS_USE_EVENT == 1.
+    #endif
+#endif
+
+#ifndef OS_USE_TASK_NOTIFY
+    #define OS_USE_TASK_NOTIFY  0
+#elif (OS_USE_TASK_NOTIFY == 1)
+    #ifndef OS_USE_TASK_DELAY
+        #define OS_USE_TASK_DELAY   1
+    #elif (OS_USE_TASK_DELAY != 1)    
+        #error OS_USE_TASK_DELAY must be defined to be equal to 1 when OS_USE_TASK_NOTIFY == 1.
+    #endif
+#endif
+
+#ifndef OS_USE_POOL
+    #define OS_USE_POOL         0
+#elif (OS_USE_POOL == 1)
+    #ifndef OS_USE_TASK_DELAY
+        #define OS_USE_TASK_DELAY   1
+    #elif (OS_USE_TASK_DELAY != 1)    
+        #error OS_USE_TASK_DELAY must be defined to be equal to 1 when OS_USE_POOL == 1.
+    #endif
+#endif
+
+#ifndef OS_USE_STREAM
+    #define OS_USE_STREAM       0
+#elif (OS_USE_STREAM == 1)
+    #ifndef OS_USE_TASK_DELAY
+        #define OS_USE_TASK_DELAY   1
+    #elif (OS_USE_TASK_DELAY != 1)    
+        #error OS_USE_TASK_DELAY must be defined to be equal to 1 when OS_USE_STREAM == 1.
+    #endif
+#endif
+
+#ifndef OS_USE_MUTEX
+    #define OS_USE_MUTEX        0
+#elif (OS_USE_MUTEX == 1)
+    #ifndef OS_USE_TASK_DELAY
+        #define OS_USE_TASK_DELAY   1
+    #elif (OS_USE_TASK_DELAY != 1)    
+        #error OS_USE_TASK_DELAY must be defined to be equal to 1 when OS_USE_MUTEX == 1.
+    #endif
+#endif
+
+#ifndef OS_USE_DYNAMIC_TASKS
+    #define OS_USE_DYNAMIC_TASKS    0
+#elif (OS_USE_DYNAMIC_TASKS == 1)
+    #ifndef OS_USE_TASK_DELAY
+        #define OS_USE_TASK_DELAY   1
+    #elif (OS_USE_TASK_DELAY != 1)    
+        #error OS_USE_TASK_DELAY must be defined to be equal to 1 when OS_USE_DYNAMIC_TASKS == 1.
+    #endif
+#endif
+
+#ifndef OS_USE_EDF_SCHED
+    #define OS_USE_EDF_SCHED    0
+#elif (OS_USE_EDF_SCHED == 1)
+    #if (OS_USE_PRIO_ROUND_ROBIN_SCHED != 1)
+        #error OS_USE_PRIO_ROUND_ROBIN_SCHED must be defined to be equal to 1 when OS_USE_EDF_SCHED == 1.
+    #endif
+    #ifndef OS_USE_TASK_DELAY
+        #define OS_USE_TASK_DELAY   1
+    #elif (OS_USE_TASK_DELAY != 1)    
+        #error OS_USE_TASK_DELAY must be defined to be equal to 1 when OS_USE_EDF_SCHED == 1.
+    #endif
+#endif
+
+#ifndef OS_USE_SCHED_ANALYSIS
+    #define OS_USE_SCHED_ANALYSIS   0
+#endif
+
 #ifndef OS_USE_TASK_DELAY
     #define OS_USE_TASK_DELAY   0
 #endif
 
+#ifndef OS_USE_TICKLESS_IDLE
+    #define OS_USE_TICKLESS_IDLE    0
+#elif ( OS_USE_TICKLESS_IDLE == 1 ) && ( OS_USE_TASK_DELAY != 1 )
+    #error OS_USE_TASK_DELAY must be defined to be equal to 1 when OS_USE_TICKLESS_IDLE == 1.
+#endif
+
+#ifndef OS_USE_TASK_STATS
+    #define OS_USE_TASK_STATS       0
+#endif
+
+#ifndef OS_USE_TICK_PROFILE
+    #define OS_USE_TICK_PROFILE     0
+#elif ( OS_USE_TICK_PROFILE == 1 ) && ( OS_USE_TASK_DELAY != 1 )
+    #error OS_USE_TASK_DELAY must be defined to be equal to 1 when OS_USE_TICK_PROFILE == 1.
+#endif
+
+#if defined(OS_PORT_HOST) && ( OS_USE_TICKLESS_IDLE == 1 )
+    #error OS_USE_TICKLESS_IDLE is not supported by the host port.
+#endif
+
+#ifndef OS_USE_STACK_CHECK
+    #define OS_USE_STACK_CHECK      0
+#endif
+
+#ifndef OS_USE_MPU_STACK_GUARD
+    #define OS_USE_MPU_STACK_GUARD  0
+#elif defined(OS_PORT_HOST) && ( OS_USE_MPU_STACK_GUARD == 1 )
+    #error OS_USE_MPU_STACK_GUARD is not supported by the host port.
+#endif
+
+#ifndef OS_USE_RAM_VECTORS
+    #define OS_USE_RAM_VECTORS      0
+#elif defined(OS_PORT_HOST) && ( OS_USE_RAM_VECTORS == 1 )
+    #error OS_USE_RAM_VECTORS is not supported by the host port.
+#elif ( OS_USE_RAM_VECTORS == 1 ) && ( OS_USE_TASK_STATS == 1 )
+    #error OS_USE_RAM_VECTORS and OS_USE_TASK_STATS cannot be both equal to 1.
+#endif
+
 #ifndef NULL
     #define NULL    ((void *)0)
 #endif
+/**
+* @def OS_STACK_FILL_PATTERN
+* @brief Patron con el que se pintan los stacks de las tareas
+*/
+#define OS_STACK_FILL_PATTERN   0xA5A5A5A5UL
+
 /**
 * @def OS_MAX_DELAY
 * @brief Tiempo de delay maximo posible
@@ -118,6 +323,61 @@ typedef enum
     OS_RESULT_OK = 0x00
 ,   OS_RESULT_ERROR
 }osReturn_t;
+
+#if ( OS_USE_TASK_DELAY == 1 )
+/**
+* @struct waitList_t
+* @brief Lista de tareas bloqueadas a la espera de un objeto del SO(semaforo, cola, etc.)
+* @note Ordenada por prioridad, y por orden de llegada dentro de una misma prioridad
+*/
+typedef struct
+{
+    uint8_t head;   /**< Primera tarea a la espera - La de mayor prioridad */
+}waitList_t;
+#endif
+
+#if ( OS_USE_TASK_NOTIFY == 1 )
+/**
+* @enum notifyAction_t
+* @brief Accion que realiza una notificacion sobre la palabra de notificacion de la tarea destino
+*/
+typedef enum
+{
+    NOTIFY_ACTION_NONE = 0x00       /**< Solo despierta a la tarea, sin modificar la palabra */
+,   NOTIFY_ACTION_SET_BITS          /**< Setea los bits de value en la palabra - Uso como grupo de eventos */
+,   NOTIFY_ACTION_INCREMENT         /**< Incrementa la palabra - Uso como semaforo contador */
+,   NOTIFY_ACTION_OVERWRITE         /**< Reemplaza la palabra por value - Uso como buzon de un elemento */
+}notifyAction_t;
+#endif
+
+#if ( OS_USE_TASK_STATS == 1 )
+/**
+* @struct taskStats_t
+* @brief Estadisticas de uso de CPU de una tarea
+*/
+typedef struct
+{
+    uint8_t         taskId;         /**< id de la tarea, OS_IDLE_TASK para la idle task */
+    const char *    taskName;       /**< Nombre de la tarea */
+    uint32_t        priority;       /**< Prioridad de la tarea, 0 para la idle task */
+    uint64_t        cycles;         /**< Ciclos de CPU ejecutados por la tarea desde el arranque del scheduler */
+    uint32_t        switchCount;    /**< Cantidad de veces que la tarea fue puesta en ejecucion */
+}taskStats_t;
+
+/**
+* @def void (*osStatsPrint_t)(const char *)
+* @brief Definicion de prototipo de la funcion que imprime cada linea de osTaskStatsDump()
+*/
+typedef void (*osStatsPrint_t)(const char *);
+#endif
+
+#if ( OS_USE_RING == 1 )
+/**
+* @def bool (*osReadyFunction_t)(const void *)
+* @brief Definicion de prototipo de la funcion con la que osWaitForProducer() evalua si hay datos listos
+*/
+typedef bool (*osReadyFunction_t)(const void *);
+#endif
 /*==================[internal data declaration]==============================*/
 
 /*==================[internal functions declaration]=========================*/
@@ -130,7 +390,7 @@ typedef enum
 
 /*==================[external functions definition]==========================*/
 osReturn_t taskCreate(taskFunction_t taskFx, uint32_t priority, uint32_t * stack, uint32_t stackSize,
-                   char * taskName, void * parameters);
+                   char * taskName, void * parameters, uint8_t * taskId);
 
 void    taskStartScheduler();
 
@@ -140,16 +400,112 @@ void    taskDelay(tick_t ticksToDelay);
 
 tick_t taskGetTickCount();
 
+tick_t taskRemainingDelay(tick_t start, tick_t delay);
+
 void taskUnsuspendWithinAPI(uint8_t taskId);
 
+#if ( OS_USE_TASK_DELAY == 1 )
+void waitListInit(waitList_t * list);
+
+osReturn_t taskBlockOnWaitList(waitList_t * list, tick_t ticksToWait);
+
+uint8_t taskWakeFromWaitList(waitList_t * list);
+
+uint8_t waitListNext(uint8_t taskId);
+
+void taskWakeWaiting(uint8_t taskId);
+#endif
+
+#if ( OS_USE_EDF_SCHED == 1 )
+osReturn_t taskCreatePeriodic(taskFunction_t taskFx, uint32_t priority, uint32_t * stack, uint32_t stackSize,
+                   char * taskName, void * parameters, tick_t period, tick_t deadline, uint8_t * taskId);
+
+void taskWaitForNextPeriod(void);
+
+uint32_t taskGetDeadlineMisses(uint8_t taskId);
+#endif
+
+#if ( OS_USE_RING == 1 )
+osReturn_t taskWaitForDeferredWake(tick_t ticksToWait);
+
+void taskWakeDeferredFromISR(uint8_t taskId);
+
+osReturn_t osReserveSlot(volatile uint32_t * head, const volatile uint32_t * tail, uint32_t mask,
+                         volatile uint32_t * dropped, uint32_t * slot);
+
+void osPublishAndWake(volatile uint32_t * marker, uint32_t value, const volatile uint8_t * waiting);
+
+osReturn_t osWaitForProducer(volatile uint8_t * waiting, osReadyFunction_t isReady, const void * arg, tick_t delay);
+#endif
+
+#if ( OS_USE_TASK_NOTIFY == 1 )
+osReturn_t taskNotify(uint8_t taskId, uint32_t value, notifyAction_t action);
+
+osReturn_t taskNotifyFromISR(uint8_t taskId, uint32_t value, notifyAction_t action);
+
+osReturn_t taskNotifyGive(uint8_t taskId);
+
+osReturn_t taskNotifyGiveFromISR(uint8_t taskId);
+
+uint32_t taskNotifyTake(uint8_t clearOnExit, tick_t ticksToWait);
+
+osReturn_t taskNotifyWait(uint32_t clearOnEntry, uint32_t clearOnExit, uint32_t * value, tick_t ticksToWait);
+#endif
+
+#if ( OS_USE_MUTEX == 1 )
+uint32_t taskGetPriority(uint8_t taskId);
+
+void taskPriorityInherit(uint8_t taskId, uint32_t priority);
+
+uint8_t taskPriorityDisinherit(uint8_t taskId);
+
+void taskIncrementMutexHeldCount(uint8_t taskId);
+#endif
+
+#if ( OS_USE_TASK_STATS == 1 )
+void osIsrEnter(void);
+
+void osIsrExit(void);
+
+uint8_t osGetTaskStats(taskStats_t * stats, uint8_t len, uint64_t * isrCycles);
+
+void osTaskStatsDump(osStatsPrint_t print);
+#endif
+
+#if ( OS_USE_TICK_PROFILE == 1 )
+uint32_t osGetTickUpdateCycles(void);
+
+uint32_t osGetTickCycles(void);
+#endif
+
+#if ( OS_USE_DYNAMIC_TASKS == 1 )
+osReturn_t taskDelete(uint8_t taskId);
+
+osReturn_t taskSuspend(uint8_t taskId);
+
+osReturn_t taskResume(uint8_t taskId);
+
+void taskReapHook(uint32_t * stack, uint32_t stackSize);
+#endif
+
+#if ( OS_USE_STACK_CHECK == 1 )
+uint32_t taskGetStackHighWaterMark(uint8_t taskId);
+#endif
+
 void osSuspendContextSwitching();
 
 void osResumeContextSwitching();
 
+uint32_t osSuspendContextSwitchingFromISR(void);
+
+void osResumeContextSwitchingFromISR(uint32_t mask);
+
 uint8_t osGetCurrentTask();
 
 uint8_t osIsIdleTask(uint8_t taskId);
 
 void taskYield();
+
+void taskYieldFromISR();
 /*==================[end of file]============================================*/
 #endif /* #ifndef _OS_H_ */
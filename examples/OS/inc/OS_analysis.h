@@ -0,0 +1,42 @@
+/**
+* @file  OS_analysis.h
+* @brief Analisis de planificabilidad de tareas periodicas para EDF y rate-monotonic
+* @note  Copyright 2019 - Esp. Ing. Matias Alvarez.
+*/
+#ifndef _OS_ANALYSIS_H_
+#define _OS_ANALYSIS_H_
+/*==================[inclusions]=============================================*/
+#include "OS_config.h"
+#include "OS.h"
+/*==================[macros]=================================================*/
+
+/*==================[typedef]================================================*/
+#if ( OS_USE_SCHED_ANALYSIS == 1 )
+/**
+* @struct schedTask_t
+* @brief Parametros temporales de una tarea periodica, en ticks
+*/
+typedef struct
+{
+    tick_t  period;     /**< Periodo de la tarea - Mayor a 0 */
+    tick_t  deadline;   /**< Deadline respecto de la activacion - Entre wcet y period, 0 para usar period */
+    tick_t  wcet;       /**< Tiempo de ejecucion de peor caso de cada trabajo - Mayor a 0 */
+}schedTask_t;
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+
+/*==================[external functions definition]==========================*/
+uint32_t schedUtilization(const schedTask_t * tasks, uint32_t count);
+osReturn_t schedEdfTest(const schedTask_t * tasks, uint32_t count);
+osReturn_t schedRmTest(const schedTask_t * tasks, uint32_t count, tick_t * response);
+
+#endif
+/*==================[end of file]============================================*/
+#endif /* #ifndef _OS_ANALYSIS_H_ */
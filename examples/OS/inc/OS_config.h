@@ -13,28 +13,46 @@
 /**
 * @def OS_MINIMAL_STACK_SIZE
 * @brief Minimo tamaño de stack usado por las tareas
+* @note En el port de host el stack tambien aloja los frames de las señales de Linux
+* @note En los micro-benchmarks(OS_BENCH) es menor para que entren sus tareas auxiliares en la RAM del target
 * @note Obligatoria su definicion
 */
-#define OS_MINIMAL_STACK_SIZE       2048
+#if defined(OS_PORT_HOST)
+    #define OS_MINIMAL_STACK_SIZE   65536
+#elif defined(OS_BENCH)
+    #define OS_MINIMAL_STACK_SIZE   256
+#else
+    #define OS_MINIMAL_STACK_SIZE   2048
+#endif
 
 /**
 * @def OS_IDLE_STACK_SIZE
 * @brief Tamaño del stack usado por la idle task
 * @note Obligatoria su definicion
 */
-#define OS_IDLE_STACK_SIZE          1024
+#if defined(OS_PORT_HOST)
+    #define OS_IDLE_STACK_SIZE      65536
+#else
+    #define OS_IDLE_STACK_SIZE      1024
+#endif
 
 /**
 * @def OS_MAX_TASK
 * @brief Maxima cantidad de tareas que soporta el sistema
+* @note Los micro-benchmarks(OS_BENCH) demoran hasta 64 tareas a la vez
 * @note Obligatoria su definicion
 */
-#define OS_MAX_TASK                 3
+#if defined(OS_BENCH)
+    #define OS_MAX_TASK             72
+#else
+    #define OS_MAX_TASK             12
+#endif
 
 /**
 * @def OS_MAX_TASK_PRIORITY
 * @brief Maxima cantidad de prioridades que soport el sistema
 * @note Cuanto mayor el numero de prioridad, menor la prioridad real de la tarea
+* @note Maximo 32 - El scheduler usa un bitmap de 32 bits de prioridades ready
 * @note Obligatoria su definicion
 */
 #define OS_MAX_TASK_PRIORITY        3 
@@ -60,6 +78,17 @@
 */
 #define OS_USE_TICK_HOOK            0
 
+/**
+* @def OS_MAX_SYSCALL_IRQ_PRIO
+* @var Prioridad mas alta(menor numero) que puede tener una IRQ que llama a funciones del SO
+* @note Las secciones criticas del SO solo enmascaran(BASEPRI) las IRQs con prioridad numerica mayor o
+       igual a este valor. Las IRQs de prioridad 0 a OS_MAX_SYSCALL_IRQ_PRIO - 1 nunca se enmascaran,
+       pero NO pueden llamar a funciones del SO
+* @note Entre 1 y 7 en el LPC4337(3 bits de prioridad). irqAttach() recibe la prioridad de cada IRQ
+* @note Obligatoria su definicion
+*/
+#define OS_MAX_SYSCALL_IRQ_PRIO     5
+
 /**
 * @def OS_USE_TASK_DELAY
 * @var Flag que indica si el sistema debe incluir la implementacion del delay o no
@@ -67,6 +96,84 @@
 */
 #define OS_USE_TASK_DELAY           1
 
+/**
+* @def OS_USE_DYNAMIC_TASKS
+* @var Flag que indica si el sistema permite crear tareas con el scheduler corriendo, borrarlas con
+       taskDelete() y suspenderlas con taskSuspend()/taskResume()
+* @note Los lugares de las tareas borradas se reusan y sus stacks se devuelven con taskReapHook()
+* @note Requiere OS_USE_TASK_DELAY == 1
+* @note No es obligatoria su definicion
+*/
+#define OS_USE_DYNAMIC_TASKS        1
+
+/**
+* @def OS_USE_TICKLESS_IDLE
+* @var Flag que indica si la idle task detiene el tick del sistema mientras todas las tareas
+       estan bloqueadas, reprogramando el SysTick para despertar en el proximo vencimiento de delay
+* @note Requiere OS_USE_TASK_DELAY == 1
+* @note Si el usuario redefine idleHook() el modo tickless queda deshabilitado
+* @note No es obligatoria su definicion
+*/
+#define OS_USE_TICKLESS_IDLE        0
+
+/**
+* @def OS_USE_TASK_STATS
+* @var Flag que indica si el sistema contabiliza los ciclos de CPU de cada tarea, de la idle task
+       y de las IRQs, con el contador de ciclos del DWT
+* @note Las IRQs solo se contabilizan si se atienden a traves de irqAttach() o son el SysTick
+* @note Incompatible con OS_USE_RAM_VECTORS == 1
+* @note No es obligatoria su definicion
+*/
+#define OS_USE_TASK_STATS           1
+
+/**
+* @def OS_USE_TICK_PROFILE
+* @var Flag que indica si el SysTick mide con el contador de ciclos del DWT cuanto tarda en total y en
+       actualizar las tareas demoradas - Ver osGetTickCycles() y osGetTickUpdateCycles()
+* @note En el target el contador de ciclos debe estar habilitado por la aplicacion o por OS_USE_TASK_STATS
+* @note Requiere OS_USE_TASK_DELAY == 1
+* @note No es obligatoria su definicion
+*/
+#if defined(OS_BENCH)
+    #define OS_USE_TICK_PROFILE     1
+#else
+    #define OS_USE_TICK_PROFILE     0
+#endif
+
+/**
+* @def OS_USE_STACK_CHECK
+* @var Flag que indica si el sistema pinta los stacks de las tareas para medir su uso maximo
+       con taskGetStackHighWaterMark()
+* @note No es obligatoria su definicion
+*/
+#define OS_USE_STACK_CHECK          1
+
+/**
+* @def OS_USE_MPU_STACK_GUARD
+* @var Flag que indica si el sistema programa una region del MPU sin acceso en la base del stack de la
+       tarea en ejecucion, para que un desborde genere un MemManage fault en lugar de corromper memoria
+* @note La region ocupa los primeros 32 bytes alineados del stack de cada tarea
+* @note No soportado por el port de host
+* @note No es obligatoria su definicion
+*/
+#if defined(OS_PORT_HOST)
+    #define OS_USE_MPU_STACK_GUARD  0
+#else
+    #define OS_USE_MPU_STACK_GUARD  1
+#endif
+
+/**
+* @def OS_USE_RAM_VECTORS
+* @var Flag que indica si irqAttach() copia la tabla de vectores a RAM(VTOR) e instala los callbacks
+       directamente en ella, en lugar de atenderlos a traves del manejador generico
+* @note Incompatible con OS_USE_TASK_STATS == 1: sin el manejador generico no se puede contabilizar el
+       tiempo de las IRQs
+* @note Opcional: para usarlo hay que deshabilitar OS_USE_TASK_STATS
+* @note No soportado por el port de host
+* @note No es obligatoria su definicion
+*/
+#define OS_USE_RAM_VECTORS          0
+
 /**
 * @def OS_USE_ROUND_ROBIN_SCHED
 * @var Flag que indica si el sistema usa scheduling preemtive o fifo
@@ -75,6 +182,24 @@
 */
 #define OS_USE_PRIO_ROUND_ROBIN_SCHED     	1  
 
+/**
+* @def OS_USE_EDF_SCHED
+* @var Flag que indica si, dentro de cada prioridad, las tareas periodicas se ejecutan por deadline
+       absoluto mas proximo(EDF) antes que las tareas sin deadline
+* @note Para EDF puro todas las tareas periodicas deben tener la misma prioridad. Para rate-monotonic
+       se usan prioridades fijas asignadas por periodo
+* @note Requiere OS_USE_TASK_DELAY == 1
+* @note NO es obligatoria su definicion
+*/
+#define OS_USE_EDF_SCHED                    1
+
+/**
+* @def OS_USE_SCHED_ANALYSIS
+* @var Flag que indica si el sistema incluye el analisis de planificabilidad EDF y rate-monotonic
+* @note NO es obligatoria su definicion
+*/
+#define OS_USE_SCHED_ANALYSIS               1
+
 /**
 * @def OS_USE_SEMPHR
 * @var Flag que indica si el sistema usa semaforos
@@ -82,6 +207,130 @@
 */
 #define OS_USE_SEMPHR						1
 
+/**
+* @def OS_USE_MUTEX
+* @var Flag que indica si el sistema usa mutex con herencia de prioridad
+* @note NO es obligatoria su definicion
+*/
+#define OS_USE_MUTEX						1
+
+/**
+* @def OS_USE_RING
+* @var Flag que indica si el sistema usa colas lock-free de un productor y un consumidor
+* @note NO es obligatoria su definicion
+*/
+#define OS_USE_RING							1
+
+/**
+* @def OS_USE_EVENT
+* @var Flag que indica si el sistema usa grupos de eventos
+* @note NO es obligatoria su definicion
+*/
+#define OS_USE_EVENT						1
+
+/**
+* @def OS_USE_TASK_NOTIFY
+* @var Flag que indica si cada tarea tiene una palabra de notificacion de 32 bits, con la que otra tarea o
+       una IRQ la despierta sin necesidad de un semaforo o una cola
+* @note Requiere OS_USE_TASK_DELAY == 1
+* @note NO es obligatoria su definicion
+*/
+#define OS_USE_TASK_NOTIFY                  1
+
+/**
+* @def OS_USE_POOL
+* @var Flag que indica si el sistema usa pools de bloques de memoria de tamaño fijo
+* @note Requiere OS_USE_TASK_DELAY == 1
+* @note NO es obligatoria su definicion
+*/
+#define OS_USE_POOL                         1
+
+/**
+* @def OS_USE_STREAM
+* @var Flag que indica si el sistema usa buffers de stream y de mensajes
+* @note Requiere OS_USE_TASK_DELAY == 1
+* @note NO es obligatoria su definicion
+*/
+#define OS_USE_STREAM                       1
+
+/**
+* @def OS_USE_TIMER
+* @var Flag que indica si el sistema usa timers por software
+* @note Los callbacks se ejecutan en una tarea del SO, que ocupa uno de los OS_MAX_TASK lugares de tareas
+* @note Requiere OS_USE_SEMPHR == 1
+* @note NO es obligatoria su definicion
+*/
+#define OS_USE_TIMER						1
+
+/**
+* @def OS_TIMER_TASK_PRIORITY
+* @var Prioridad de la tarea de timers
+* @note NO es obligatoria su definicion - Por defecto la mayor prioridad
+*/
+#define OS_TIMER_TASK_PRIORITY              1
+
+/**
+* @def OS_TIMER_STACK_SIZE
+* @var Tamaño del stack de la tarea de timers
+* @note NO es obligatoria su definicion - Por defecto OS_MINIMAL_STACK_SIZE
+*/
+#define OS_TIMER_STACK_SIZE                 OS_MINIMAL_STACK_SIZE
+
+/**
+* @def OS_USE_IRQ_DEFER
+* @var Flag que indica si el sistema usa una tarea que ejecuta los trabajos que las IRQs difieren con irqDefer()
+* @note La tarea ocupa uno de los OS_MAX_TASK lugares de tareas
+* @note Requiere OS_USE_RING == 1
+* @note NO es obligatoria su definicion
+*/
+#define OS_USE_IRQ_DEFER                    1
+
+/**
+* @def OS_IRQ_DEFER_QUEUE_LEN
+* @var Cantidad maxima de trabajos diferidos pendientes
+* @note Debe ser potencia de 2
+* @note NO es obligatoria su definicion - Por defecto 16
+*/
+#define OS_IRQ_DEFER_QUEUE_LEN              16
+
+/**
+* @def OS_IRQ_DEFER_TASK_PRIORITY
+* @var Prioridad de la tarea de trabajos diferidos
+* @note NO es obligatoria su definicion - Por defecto la mayor prioridad
+*/
+#define OS_IRQ_DEFER_TASK_PRIORITY          1
+
+/**
+* @def OS_IRQ_DEFER_STACK_SIZE
+* @var Tamaño del stack de la tarea de trabajos diferidos
+* @note NO es obligatoria su definicion - Por defecto OS_MINIMAL_STACK_SIZE
+*/
+#define OS_IRQ_DEFER_STACK_SIZE             OS_MINIMAL_STACK_SIZE
+
+/**
+* @def OS_USE_LOG
+* @var Flag que indica si el sistema usa el log binario diferido de OS_LOG()
+* @note Requiere OS_USE_RING == 1
+* @note NO es obligatoria su definicion
+*/
+#define OS_USE_LOG                          1
+
+/**
+* @def OS_LOG_QUEUE_LEN
+* @var Cantidad maxima de registros de log pendientes
+* @note Debe ser potencia de 2
+* @note NO es obligatoria su definicion - Por defecto 32
+*/
+#define OS_LOG_QUEUE_LEN                    32
+
+/**
+* @def OS_LOG_MAX_ARGS
+* @var Cantidad maxima de argumentos de cada registro de log
+* @note Entre 0 y 7. Cada lugar de la cola ocupa (OS_LOG_MAX_ARGS + 2) * 4 bytes
+* @note NO es obligatoria su definicion - Por defecto 4
+*/
+#define OS_LOG_MAX_ARGS                     4
+
 /**
 * @def OS_USE_QUEUE
 * @var Flag que indica si el sistema usa semaforos
@@ -0,0 +1,39 @@
+/**
+* @file  OS_defer.h
+* @brief Procesamiento diferido de interrupciones
+* @note  Copyright 2019 - Esp. Ing. Matias Alvarez.
+*/
+#ifndef _OS_DEFER_H_
+#define _OS_DEFER_H_
+/*==================[inclusions]=============================================*/
+#include "OS_config.h"
+#include "OS.h"
+/*==================[macros]=================================================*/
+
+/*==================[typedef]================================================*/
+#if ( OS_USE_IRQ_DEFER == 1 )
+/**
+* @def void (*irqDeferFunction_t)(void *, tick_t)
+* @brief Definicion de prototipo de un trabajo diferido
+* @note Recibe el argumento pasado a irqDefer() y el tick en que la IRQ difirio el trabajo
+* @danger Se ejecuta en la tarea de trabajos diferidos: mientras se bloquea no se atienden los demas trabajos
+*/
+typedef void (*irqDeferFunction_t)(void *, tick_t);
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+
+/*==================[external functions definition]==========================*/
+void irqDeferServiceInit(void);
+osReturn_t irqDefer(irqDeferFunction_t fx, void * arg);
+uint32_t irqDeferGetDropped(void);
+
+#endif
+/*==================[end of file]============================================*/
+#endif /* #ifndef _OS_DEFER_H_ */
@@ -0,0 +1,56 @@
+/**
+* @file  OS_event.h
+* @brief Grupos de eventos de 32 bits
+* @note  Copyright 2019 - Esp. Ing. Matias Alvarez.
+*/
+#ifndef _OS_EVENT_H_
+#define _OS_EVENT_H_
+/*==================[inclusions]=============================================*/
+#include "OS_config.h"
+#include "OS.h"
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+
+/*==================[typedef]================================================*/
+#if ( OS_USE_EVENT == 1 )
+/**
+* @enum eventWaitMode_t
+* @brief Condicion de espera de eventWait()
+*/
+typedef enum
+{
+    EVENT_WAIT_ANY = 0x00       /**< Alcanza con que uno de los bits esperados este seteado */
+,   EVENT_WAIT_ALL              /**< Deben estar seteados todos los bits esperados */
+}eventWaitMode_t;
+
+/**
+* @struct event_t
+* @brief Estructura de un grupo de eventos
+*/
+typedef struct
+{
+    uint32_t bits;          /**< Eventos seteados */
+    waitList_t waitList;    /**< Tareas a la espera de algun evento, ordenadas por prioridad */
+}event_t;
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+
+/*==================[external functions definition]==========================*/
+void eventInit(event_t * event);
+osReturn_t eventWait(event_t * event, uint32_t mask, eventWaitMode_t mode, bool clearOnExit, tick_t delay,
+                     uint32_t * bits);
+void eventSet(event_t * event, uint32_t bits);
+void eventSetFromISR(event_t * event, uint32_t bits);
+uint32_t eventClear(event_t * event, uint32_t bits);
+uint32_t eventGetBits(event_t * event);
+
+#endif
+/*==================[end of file]============================================*/
+#endif /* #ifndef _OS_EVENT_H_ */
@@ -7,9 +7,8 @@
 #define _OS_IRQ_H_
 
 /*==================[inclusions]=============================================*/
-#include "board.h"
-#include "chip.h"
-#include "cmsis_43xx.h"
+#include "OS.h"
+#include "OS_port.h"
 /*==================[macros]=================================================*/
 
 /*==================[typedef]================================================*/
@@ -29,7 +28,7 @@ typedef void (*irqCbFunction_t)(void);
 /*==================[internal functions definition]==========================*/
 
 /*==================[external functions definition]==========================*/
-osReturn_t irqAttach(IRQn_Type IRQn, irqCbFunction_t irqCbPointer);
+osReturn_t irqAttach(IRQn_Type IRQn, irqCbFunction_t irqCbPointer, uint32_t priority);
 osReturn_t irqDetach(IRQn_Type IRQn);
 /*==================[end of file]============================================*/
 #endif /* #ifndef _OS_IRQ_H_ */
@@ -0,0 +1,74 @@
+/**
+* @file  OS_log.h
+* @brief Log binario diferido - El texto se arma en la PC con tools/oslog_decode.py
+* @note  Copyright 2019 - Esp. Ing. Matias Alvarez.
+*/
+#ifndef _OS_LOG_H_
+#define _OS_LOG_H_
+/*==================[inclusions]=============================================*/
+#include "OS_config.h"
+#include "OS.h"
+#include <stdint.h>
+/*==================[macros]=================================================*/
+#if ( OS_USE_LOG == 1 )
+/**
+* @def OS_LOG_SECTION
+* @brief Seccion del ELF donde se guardan los formatos - El linker script la deja fuera de la flash
+*/
+#define OS_LOG_SECTION          "os_log_fmt"
+
+/**
+* @def OS_LOG_SYNC
+* @brief Valor de los 5 bits altos del primer byte de cada registro - Los 3 bits bajos son la cantidad de argumentos
+*/
+#define OS_LOG_SYNC             0xA0
+
+/**
+* @def OS_LOG_RECORD_MAX_SIZE
+* @brief Tamaño maximo en bytes de un registro serializado por logRead()
+*/
+#define OS_LOG_RECORD_MAX_SIZE  ( (1 + OS_LOG_MAX_ARGS) * sizeof(uint32_t) )
+
+/**
+* @def OS_LOG_STR(str)
+* @brief Macro para pasar una cadena como argumento de OS_LOG()
+* @note El decodificador lee la cadena del ELF, por lo que debe ser constante(literal o en flash)
+*/
+#define OS_LOG_STR(str)         ( (uint32_t)(uintptr_t)(str) )
+
+/**
+* @def OS_LOG(fmt, ...)
+* @brief Macro que encola un registro de log con el formato fmt y hasta OS_LOG_MAX_ARGS argumentos
+* @note fmt debe ser un literal: se guarda en OS_LOG_SECTION y en el registro solo viaja su posicion.
+        Los argumentos se guardan como uint32_t, por lo que el formato solo admite %d, %i, %u, %x, %X,
+        %o, %c y %s(con OS_LOG_STR()), con ancho, relleno y modificadores l/h
+* @note Apta para IRQs de prioridad OS_MAX_SYSCALL_IRQ_PRIO o menor, y para tareas
+*/
+#define OS_LOG(fmt, ...)                                                                        \
+    do                                                                                          \
+    {                                                                                           \
+        static const char osLogFmt[] __attribute__((section(OS_LOG_SECTION))) = fmt;            \
+        const uint32_t osLogArgs[] = { 0, ##__VA_ARGS__ };                                      \
+        logWrite(osLogFmt, sizeof(osLogArgs) / sizeof(uint32_t) - 1, &osLogArgs[1]);            \
+    }while(0)
+#endif
+/*==================[typedef]================================================*/
+#if ( OS_USE_LOG == 1 )
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+
+/*==================[external functions definition]==========================*/
+osReturn_t logWrite(const char * fmt, uint32_t nargs, const uint32_t * args);
+uint32_t logRead(uint8_t * buffer, uint32_t size, tick_t delay);
+uint32_t logGetDropped(void);
+
+#endif
+/*==================[end of file]============================================*/
+#endif /* #ifndef _OS_LOG_H_ */
@@ -0,0 +1,42 @@
+/** 
+* @file  OS_mutex.h
+* @brief 
+* @note  Copyright 2019 - Esp. Ing. Matias Alvarez.
+*/
+#ifndef _OS_MUTEX_H_
+#define _OS_MUTEX_H_
+/*==================[inclusions]=============================================*/
+#include "OS_config.h"
+#include "OS.h"
+/*==================[macros]=================================================*/
+
+/*==================[typedef]================================================*/
+#if ( OS_USE_MUTEX == 1 )
+/**
+* @struct mutex_t
+* @brief Estructura de un mutex recursivo con herencia de prioridad
+*/
+typedef struct
+{
+    uint8_t owner;          /**< Tarea que tiene tomado el mutex - OS_INVALID_TASK si esta libre */
+    uint32_t lockCount;     /**< Cantidad de veces que la tarea duenia tomo el mutex */
+    waitList_t waitList;    /**< Tareas a la espera de que liberen el mutex, ordenadas por prioridad */
+}mutex_t;
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+
+/*==================[external functions definition]==========================*/
+void mutexInit(mutex_t * mutex);
+osReturn_t mutexLock(mutex_t * mutex, tick_t delay);
+osReturn_t mutexUnlock(mutex_t * mutex);
+
+#endif
+/*==================[end of file]============================================*/
+#endif /* #ifndef _OS_MUTEX_H_ */
@@ -0,0 +1,57 @@
+/**
+* @file  OS_pool.h
+* @brief Pools de bloques de memoria de tamaño fijo
+* @note  Copyright 2019 - Esp. Ing. Matias Alvarez.
+*/
+#ifndef _OS_POOL_H_
+#define _OS_POOL_H_
+/*==================[inclusions]=============================================*/
+#include "OS_config.h"
+#include "OS.h"
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+/**
+* @def POOL_BLOCK_SIZE(size)
+* @brief Macro que redondea un tamaño de bloque al multiplo de sizeof(void *) que requiere poolInit()
+*/
+#define POOL_BLOCK_SIZE(size)   ( (((size) + sizeof(void *) - 1) / sizeof(void *)) * sizeof(void *) )
+/*==================[typedef]================================================*/
+#if ( OS_USE_POOL == 1 )
+/**
+* @struct pool_t
+* @brief Estructura de un pool de bloques de tamaño fijo
+* @note Los bloques libres forman una lista simple enlazada a traves de su primera palabra,
+        por lo que reservar y liberar un bloque no depende de la cantidad de bloques
+*/
+typedef struct
+{
+    uint8_t *   buffer;         /**< Memoria de los bloques - Provista por el usuario */
+    void *      freeList;       /**< Primer bloque libre, NULL si no hay bloques libres */
+    uint32_t    blockSize;      /**< Tamaño en bytes de cada bloque */
+    uint32_t    blockCount;     /**< Cantidad de bloques del pool */
+    uint32_t    freeCount;      /**< Cantidad de bloques libres */
+    uint32_t    highWater;      /**< Maxima cantidad de bloques reservados a la vez */
+    waitList_t  waitList;       /**< Tareas a la espera de un bloque libre, ordenadas por prioridad */
+}pool_t;
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+
+/*==================[external functions definition]==========================*/
+osReturn_t poolInit(pool_t * pool, void * buffer, uint32_t blockSize, uint32_t blockCount);
+void * poolAlloc(pool_t * pool, tick_t delay);
+void * poolAllocFromISR(pool_t * pool);
+osReturn_t poolFree(pool_t * pool, void * block);
+osReturn_t poolFreeFromISR(pool_t * pool, void * block);
+uint32_t poolGetFree(pool_t * pool);
+uint32_t poolGetHighWater(pool_t * pool);
+
+#endif
+/*==================[end of file]============================================*/
+#endif /* #ifndef _OS_POOL_H_ */
@@ -0,0 +1,115 @@
+/**
+* @file  OS_port.h
+* @brief Capa de portabilidad del SO - Dependencias del procesador
+* @note  Por defecto se compila el port para Cortex-M4(LPC4337). Definiendo OS_PORT_HOST se compila
+         el port de simulacion en Linux/POSIX, que provee las mismas primitivas CMSIS que usa el SO
+* @note  NO deberia ser modificado por el usuario
+* @note  Copyright 2019 - Esp. Ing. Matias Alvarez.
+*/
+#ifndef _OS_PORT_H_
+#define _OS_PORT_H_
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include "OS.h"
+
+#if defined(OS_PORT_HOST)
+    #include "OS_port_host.h"
+#else
+    #include "board.h"
+    #include "OS_port_mask.h"
+#endif
+/*==================[macros]=================================================*/
+#if !defined(OS_PORT_HOST)
+    #if ( OS_MAX_SYSCALL_IRQ_PRIO >= (1 << __NVIC_PRIO_BITS) )
+        #error OS_MAX_SYSCALL_IRQ_PRIO must be less than the number of priority levels of the processor.
+    #endif
+
+    #if ( OS_PORT_PRIO_BITS != __NVIC_PRIO_BITS )
+        #error OS_PORT_PRIO_BITS must be defined in OS_port_mask.h to be equal to __NVIC_PRIO_BITS.
+    #endif
+
+    /**
+    * @def OS_PORT_PEND_SWITCH()
+    * @brief Deja pendiente el cambio de contexto desde una tarea
+    * @note La pendSV se ejecuta en cuanto las interrupciones esten habilitadas
+    */
+    #define OS_PORT_PEND_SWITCH()               \
+        do                                      \
+        {                                       \
+            __ISB();                            \
+            __DSB();                            \
+            SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;\
+        }while(0)
+
+    /**
+    * @def OS_PORT_PEND_SWITCH_FROM_ISR()
+    * @brief Deja pendiente el cambio de contexto desde una IRQ
+    * @note La pendSV tiene la menor prioridad, por lo que se ejecuta al salir de la IRQ
+    */
+    #define OS_PORT_PEND_SWITCH_FROM_ISR()      ( SCB->ICSR = SCB_ICSR_PENDSVSET_Msk )
+
+    /**
+    * @def OS_PORT_CYCLE_COUNT()
+    * @brief Cuenta del contador de ciclos del DWT
+    */
+    #define OS_PORT_CYCLE_COUNT()               ( DWT->CYCCNT )
+
+    /**
+    * @def OS_PORT_STACK_GUARD_SIZE
+    * @brief Tamaño de la region de guarda del stack - Minimo tamaño de region del MPU
+    */
+    #define OS_PORT_STACK_GUARD_SIZE            32
+
+    /**
+    * @def OS_PORT_STACK_GUARD_REGION
+    * @brief Region del MPU usada como guarda del stack - La de mayor numero tiene precedencia
+    */
+    #define OS_PORT_STACK_GUARD_REGION          7
+
+    /**
+    * @def OS_PORT_GET_MASK()
+    * @brief Mascara de IRQs actual(BASEPRI)
+    */
+    #define OS_PORT_GET_MASK()                  __get_BASEPRI()
+
+    /**
+    * @def OS_PORT_SET_MASK(mask)
+    * @brief Cambia la mascara de IRQs(BASEPRI) - 0 no enmascara ninguna IRQ
+    * @note La ISB garantiza que la nueva mascara rija desde la instruccion siguiente
+    */
+    #define OS_PORT_SET_MASK(mask)              \
+        do                                      \
+        {                                       \
+            __set_BASEPRI(mask);                \
+            __DSB();                            \
+            __ISB();                            \
+        }while(0)
+#endif
+/*==================[typedef]================================================*/
+
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+
+/*==================[external functions definition]==========================*/
+uint32_t osPortInitStack(uint8_t taskId, uint32_t * stack, uint32_t stackSize, taskFunction_t taskFx,
+                         void * parameters, void (*returnHook)(void));
+
+void osPortStartTick(uint32_t tickRateHz);
+
+void osPortCycleCounterInit(void);
+
+#if ( OS_USE_MPU_STACK_GUARD == 1 )
+void osPortStackGuardInit(void);
+
+void osPortStackGuardSet(uint32_t * stack);
+#endif
+/*==================[end of file]============================================*/
+#endif /* #ifndef _OS_PORT_H_ */
@@ -0,0 +1,29 @@
+/**
+* @file  OS_port_mask.h
+* @brief Mascara de BASEPRI del port de Cortex-M4(LPC4337)
+* @note  Solo macros: la incluyen OS_port.h y PendSVHandler.S, para que ambos enmascaren las mismas IRQs
+* @note  NO deberia ser modificado por el usuario
+* @note  Copyright 2019 - Esp. Ing. Matias Alvarez.
+*/
+#ifndef _OS_PORT_MASK_H_
+#define _OS_PORT_MASK_H_
+/*==================[inclusions]=============================================*/
+#include "OS_config.h"
+/*==================[macros]=================================================*/
+/**
+* @def OS_PORT_PRIO_BITS
+* @brief Bits de prioridad que implementa el NVIC
+* @note OS_port.h verifica que coincida con __NVIC_PRIO_BITS, que el ensamblador no puede incluir
+*/
+#define OS_PORT_PRIO_BITS                   3
+
+/**
+* @def OS_PORT_SYSCALL_MASK
+* @brief Valor de BASEPRI que enmascara las IRQs que llaman al SO
+* @note La prioridad se guarda en los bits mas significativos del byte de prioridad
+*/
+#define OS_PORT_SYSCALL_MASK                ( OS_MAX_SYSCALL_IRQ_PRIO << (8 - OS_PORT_PRIO_BITS) )
+/*==================[typedef]================================================*/
+
+/*==================[end of file]============================================*/
+#endif /* #ifndef _OS_PORT_MASK_H_ */
@@ -29,6 +29,8 @@ typedef struct
     uint32_t    	writePtr;                   /**< Primer item de la cola */
     semaphore_t 	queuePushSem;               /**< Semaforo asociado al agregado de elementos la cola */
     semaphore_t 	queuePullSem;               /**< Semaforo asociado al agregado de elementos la cola */
+    bool            writeReserved;              /**< Indica si el lugar de writePtr fue reservado con queueReserve() */
+    bool            readReserved;               /**< Indica si el elemento de readPtr fue tomado con queuePeek() */
 }queue_t;
 
 /*==================[internal data declaration]==============================*/
@@ -47,6 +49,10 @@ osReturn_t queuePush(queue_t * q, void * data, tick_t delay);
 osReturn_t queuePull(queue_t * q, void * data, tick_t delay);
 osReturn_t queuePushFromISR(queue_t * q, void * data);
 osReturn_t queuePullFromISR(queue_t * q, void * data);
+osReturn_t queueReserve(queue_t * q, void ** slot, tick_t delay);
+osReturn_t queueCommit(queue_t * q);
+osReturn_t queuePeek(queue_t * q, void ** slot, tick_t delay);
+osReturn_t queueRelease(queue_t * q);
 
 #endif 
 /*==================[end of file]============================================*/
@@ -0,0 +1,47 @@
+/** 
+* @file  OS_ring.h
+* @brief 
+* @note  Copyright 2019 - Esp. Ing. Matias Alvarez.
+*/
+#ifndef _OS_RING_H_
+#define _OS_RING_H_
+/*==================[inclusions]=============================================*/
+#include "OS_config.h"
+#include "OS.h"
+/*==================[macros]=================================================*/
+
+/*==================[typedef]================================================*/
+#if ( OS_USE_RING == 1 )
+/**
+* @struct ring_t
+* @brief Estructura de una cola lock-free de un unico productor y un unico consumidor
+* @note Los indices avanzan libremente y se enmascaran con ringLen - 1, por lo que ringLen 
+        debe ser potencia de 2
+*/
+typedef struct
+{
+    uint8_t             * data;         /**< Buffer donde copiar los elementos */
+    uint32_t            dataSize;       /**< Tamaño en bytes de los elementos */
+    uint32_t            mask;           /**< Cantidad maxima de elementos - 1 */
+    volatile uint32_t   head;           /**< Indice de escritura - Solo lo modifica el productor */
+    volatile uint32_t   tail;           /**< Indice de lectura - Solo lo modifica el consumidor */
+    volatile uint8_t    consumer;       /**< Tarea consumidora a la espera de elementos, OS_INVALID_TASK si no espera */
+}ring_t;
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+
+/*==================[external functions definition]==========================*/
+osReturn_t ringInit(ring_t * ring, uint32_t ringLen, uint8_t * dataBuffer, uint32_t dataSize);
+osReturn_t ringPush(ring_t * ring, void * data);
+osReturn_t ringPull(ring_t * ring, void * data, tick_t delay);
+
+#endif
+/*==================[end of file]============================================*/
+#endif /* #ifndef _OS_RING_H_ */
@@ -19,9 +19,9 @@
 */
 typedef struct
 {
-    uint8_t value; 		/**< Valor del semaforo - Como es binario es 0(tomado) y 1(libre) */
-    uint8_t task;		/**< Tarea que inicializa el semaforo */
-    bool  taskWaiting;	/**< Indica si una tarea esta a la espera de que liberen el semaforo */
+    uint32_t value; 		/**< Valor del semaforo - 0(tomado) a maxValue(libre) */
+    uint32_t maxValue;		/**< Valor maximo del semaforo - 1 para un semaforo binario */
+    waitList_t waitList;	/**< Tareas a la espera de que liberen el semaforo, ordenadas por prioridad */
 }semaphore_t;
 /*==================[internal data declaration]==============================*/
 
@@ -35,7 +35,9 @@ typedef struct
 
 /*==================[external functions definition]==========================*/
 void semphrInit(semaphore_t * sem);
+void semphrInitCounting(semaphore_t * sem, uint32_t initialValue, uint32_t maxValue);
 void semphrGive(semaphore_t * sem);
+osReturn_t semphrGiveFromISR(semaphore_t * sem);
 osReturn_t semphrTake(semaphore_t * sem, tick_t delay);
 osReturn_t semphrTakeFromISR(semaphore_t * sem);
 
@@ -0,0 +1,66 @@
+/**
+* @file  OS_stream.h
+* @brief Buffers de stream y de mensajes de largo variable
+* @note  Copyright 2019 - Esp. Ing. Matias Alvarez.
+*/
+#ifndef _OS_STREAM_H_
+#define _OS_STREAM_H_
+/*==================[inclusions]=============================================*/
+#include "OS_config.h"
+#include "OS.h"
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+/**
+* @def MESSAGE_HEADER_SIZE
+* @brief Bytes que ocupa en el buffer el largo de cada mensaje
+*/
+#define MESSAGE_HEADER_SIZE     sizeof(uint16_t)
+/*==================[typedef]================================================*/
+#if ( OS_USE_STREAM == 1 )
+/**
+* @struct stream_t
+* @brief Estructura de un buffer de stream o de mensajes
+* @note Ambos usan un unico buffer circular de bytes. En un buffer de mensajes cada mensaje se
+        guarda precedido por su largo, y se envia y recibe entero
+*/
+typedef struct
+{
+    uint8_t *   buffer;         /**< Buffer circular de bytes - Provisto por el usuario */
+    uint32_t    size;           /**< Tamaño en bytes del buffer */
+    uint32_t    readPtr;        /**< Proximo byte a leer */
+    uint32_t    writePtr;       /**< Proximo byte a escribir */
+    uint32_t    count;          /**< Bytes ocupados */
+    uint32_t    triggerLevel;   /**< Bytes a partir de los cuales se despierta al receptor - Solo stream */
+    bool        isMessage;      /**< true si es un buffer de mensajes */
+    waitList_t  rxWaitList;     /**< Tareas a la espera de datos, ordenadas por prioridad */
+    waitList_t  txWaitList;     /**< Tareas a la espera de lugar libre, ordenadas por prioridad */
+}stream_t;
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+
+/*==================[external functions definition]==========================*/
+osReturn_t streamInit(stream_t * stream, uint8_t * buffer, uint32_t size, uint32_t triggerLevel);
+osReturn_t streamSetTriggerLevel(stream_t * stream, uint32_t triggerLevel);
+uint32_t streamSend(stream_t * stream, const void * data, uint32_t len, tick_t delay);
+uint32_t streamSendFromISR(stream_t * stream, const void * data, uint32_t len);
+uint32_t streamReceive(stream_t * stream, void * data, uint32_t maxLen, tick_t delay);
+uint32_t streamReceiveFromISR(stream_t * stream, void * data, uint32_t maxLen);
+uint32_t streamBytesAvailable(stream_t * stream);
+uint32_t streamSpacesAvailable(stream_t * stream);
+
+osReturn_t messageInit(stream_t * stream, uint8_t * buffer, uint32_t size);
+osReturn_t messageSend(stream_t * stream, const void * data, uint32_t len, tick_t delay);
+osReturn_t messageSendFromISR(stream_t * stream, const void * data, uint32_t len);
+uint32_t messageReceive(stream_t * stream, void * data, uint32_t maxLen, tick_t delay);
+uint32_t messageReceiveFromISR(stream_t * stream, void * data, uint32_t maxLen);
+
+#endif
+/*==================[end of file]============================================*/
+#endif /* #ifndef _OS_STREAM_H_ */
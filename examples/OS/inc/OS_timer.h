@@ -0,0 +1,61 @@
+/**
+* @file  OS_timer.h
+* @brief Timers por software atendidos por una unica tarea del SO
+* @note  Copyright 2019 - Esp. Ing. Matias Alvarez.
+*/
+#ifndef _OS_TIMER_H_
+#define _OS_TIMER_H_
+/*==================[inclusions]=============================================*/
+#include "OS_config.h"
+#include "OS.h"
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+
+/*==================[typedef]================================================*/
+#if ( OS_USE_TIMER == 1 )
+struct osTimer;
+
+/**
+* @def void (*timerCallback_t)(struct osTimer *)
+* @brief Definicion de prototipo del callback de un timer
+* @danger Se ejecuta en la tarea de timers: NO debe bloquearse
+*/
+typedef void (*timerCallback_t)(struct osTimer *);
+
+/**
+* @struct osTimer_t
+* @brief Estructura de un timer
+*/
+typedef struct osTimer
+{
+    tick_t              period;         /**< Periodo del timer en ticks */
+    tick_t              expiry;         /**< Tick de vencimiento */
+    bool                autoReload;     /**< true si el timer se recarga al vencer, false si es de un disparo */
+    bool                active;         /**< true si el timer esta en la lista de timers activos */
+    timerCallback_t     callback;       /**< Funcion a ejecutar al vencer el timer */
+    void *              parameters;     /**< Puntero a los parametros del callback */
+    struct osTimer *    next;           /**< Timer siguiente en la lista de timers activos */
+}osTimer_t;
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+
+/*==================[external functions definition]==========================*/
+void timerServiceInit(void);
+void timerInit(osTimer_t * timer, tick_t period, bool autoReload, timerCallback_t callback, void * parameters);
+osReturn_t timerStart(osTimer_t * timer);
+osReturn_t timerStartFromISR(osTimer_t * timer);
+osReturn_t timerStop(osTimer_t * timer);
+osReturn_t timerStopFromISR(osTimer_t * timer);
+osReturn_t timerChangePeriod(osTimer_t * timer, tick_t period);
+bool timerIsActive(osTimer_t * timer);
+
+#endif
+/*==================[end of file]============================================*/
+#endif /* #ifndef _OS_TIMER_H_ */
@@ -13,10 +13,25 @@
 #include "cmsis.h"
 #include "stdint.h"
 #include "peripheralMap.h"
+#include "OS.h"
 /*==================[macros]=================================================*/
 #define UART_0_IRQ_HANDLER 0
 #define UART_2_IRQ_HANDLER 2
 #define UART_3_IRQ_HANDLER 3
+
+/**
+* @def UART_MAP_COUNT
+* @brief Cantidad de valores de uartMap_t
+*/
+#define UART_MAP_COUNT     6
+
+/**
+* @def UART_DMA_RX_IDLE_TICKS
+* @brief Periodo en ticks del muestreo de la recepcion por DMA - Es el tiempo de inactividad de la linea
+         tras el cual se entrega lo recibido
+* @note El anillo de recepcion debe tener lugar para mas del doble de lo que se recibe en este periodo.
+*/
+#define UART_DMA_RX_IDLE_TICKS  2
 /*==================[typedef]================================================*/
 /**
 * @struct uartLpcConfig_t
@@ -29,6 +44,15 @@ typedef struct{
    IRQn_Type         uartIrqAddr;   /**< Manejador de interrupciones de la UART */
 } uartLpcConfig_t;
 
+/**
+* @struct uartDmaSegment_t
+* @brief Segmento de una lista de transmision por DMA.
+*/
+typedef struct{
+   const uint8_t *   data;          /**< Datos a transmitir */
+   uint32_t          size;          /**< Cantidad de bytes */
+} uartDmaSegment_t;
+
 /**
 * @enum baudRate_t
 * @brief Posibles BaudRates para la configuracion de la UART.
@@ -97,9 +121,95 @@ void uartWriteByte(uartMap_t uart, uint8_t data);
 * @param uart : UART a utilizar en la escritura.
 * @param data : Puntero al buffer de los datos a escribir.
 * @return Nada.
+* @note En modo DMA(ver uartConfigDma()) la tarea espera bloqueada el fin de la transferencia del string.
+* @note Si la UART tiene buffer de transmision(ver uartConfigTxBuffer()) el string se copia al buffer y lo
+        transmite la IRQ de la UART. Si el buffer se llena la tarea se bloquea hasta que la IRQ libere lugar.
+        Sin buffer, o antes del arranque del scheduler, se espera byte a byte a que la UART este libre.
+* @warning NO debe llamarse desde una IRQ.
 */
 void uartWriteString(uartMap_t uart, char *data);
 
+/**
+* @fn void uartWrite(uartMap_t uart, const uint8_t *data, uint32_t size)
+* @brief Escritura de datos binarios por la UART, con los mismos modos que uartWriteString().
+* @param uart : UART a utilizar en la escritura.
+* @param data : Puntero al buffer de los datos a escribir.
+* @param size : Cantidad de bytes a escribir.
+* @return Nada.
+* @warning NO debe llamarse desde una IRQ.
+*/
+void uartWrite(uartMap_t uart, const uint8_t *data, uint32_t size);
+
+/**
+* @fn uint8_t uartConfigTxBuffer(uartMap_t uart, uint8_t *buffer, uint32_t size)
+* @brief Configuracion de la transmision por interrupcion de la UART.
+* @param uart : UART a configurar, previamente configurada con uartConfig().
+* @param buffer : Buffer circular de transmision.
+* @param size : Tamaño del buffer.
+* @return TRUE si se configuro la transmision por interrupcion, FALSE si el buffer no es valido o la IRQ de la
+          UART ya tiene un callback adjuntado.
+* @note Adjunta el manejador de la IRQ de la UART con irqAttach(). Las UART que comparten periferico
+        (UART_GPIO y UART_RS485, UART_USB y UART_ENET) no pueden tener buffer a la vez.
+*/
+uint8_t uartConfigTxBuffer(uartMap_t uart, uint8_t *buffer, uint32_t size);
+
+/**
+* @fn uint8_t uartConfigDma(uartMap_t uart, uint8_t *rxRing, uint32_t rxRingSize, uint8_t *rxBuffer, uint32_t rxBufferSize)
+* @brief Configuracion del modo DMA de la UART.
+* @param uart : UART a configurar, previamente configurada con uartConfig().
+* @param rxRing : Anillo en el que escribe el DMA de recepcion, NULL para transmitir solamente por DMA.
+* @param rxRingSize : Tamaño del anillo - Par y de hasta 2 * 4095 bytes.
+* @param rxBuffer : Buffer del stream en el que se entregan los bytes recibidos.
+* @param rxBufferSize : Tamaño del buffer del stream.
+* @return TRUE si se configuro el modo DMA, FALSE si la UART no esta disponible, ya esta en modo DMA,
+          los buffers no son validos, no hay canales de GPDMA libres o la IRQ de GPDMA o de la UART ya tiene
+          un callback adjuntado.
+* @note El DMA recorre el anillo sin detenerse y un timer del SO lo muestrea cada UART_DMA_RX_IDLE_TICKS ticks.
+        Lo recibido se entrega al stream en un bloque de largo variable al quedar la linea inactiva un periodo
+        de muestreo, o antes si hay medio anillo pendiente. Con la linea inactiva el timer se detiene y lo
+        vuelve a arrancar la IRQ de recepcion de la UART, que se adjunta con irqAttach() si la UART no
+        transmite por interrupcion(ver uartConfigTxBuffer()).
+* @note Si el canal de recepcion termina con error se rearranca y se descartan los bytes no entregados.
+* @note La primera llamada inicializa el GPDMA y adjunta su IRQ con irqAttach(). Las UART que comparten
+        periferico (UART_GPIO y UART_RS485, UART_USB y UART_ENET) no pueden estar en modo DMA a la vez.
+* @warning Si el DMA da la vuelta al anillo entre dos muestreos se pierden datos sin aviso.
+*/
+uint8_t uartConfigDma(uartMap_t uart, uint8_t *rxRing, uint32_t rxRingSize, uint8_t *rxBuffer, uint32_t rxBufferSize);
+
+/**
+* @fn uint8_t uartWriteDma(uartMap_t uart, const uartDmaSegment_t *segments, uint32_t count, tick_t delay)
+* @brief Transmision por DMA de una lista de segmentos, sin copiarlos.
+* @param uart : UART a utilizar, previamente configurada con uartConfigDma().
+* @param segments : Lista de segmentos a transmitir en orden.
+* @param count : Cantidad de segmentos.
+* @param delay : Tiempo maximo de espera a que otra tarea termine de transmitir.
+* @return TRUE si se transmitio la lista, FALSE si la UART no esta en modo DMA, la lista no entra en los
+          descriptores disponibles, expiro delay o la transferencia termino con error.
+* @note Cada segmento ocupa un descriptor cada 4095 bytes y una transferencia admite hasta 8 descriptores.
+        La tarea espera bloqueada el fin de la transferencia, por lo que los segmentos pueden estar en su stack.
+* @warning NO debe llamarse desde una IRQ ni antes del arranque del scheduler.
+*/
+uint8_t uartWriteDma(uartMap_t uart, const uartDmaSegment_t *segments, uint32_t count, tick_t delay);
+
+/**
+* @fn uint32_t uartReadDma(uartMap_t uart, uint8_t *data, uint32_t size, tick_t delay)
+* @brief Lectura de los bytes recibidos por DMA.
+* @param uart : UART a utilizar, previamente configurada con uartConfigDma() con anillo de recepcion.
+* @param data : Puntero al espacio de memoria donde guardar los datos recibidos.
+* @param size : Maxima cantidad de bytes a leer.
+* @param delay : Tiempo maximo de espera de datos.
+* @return Cantidad de bytes leidos, 0 si expiro delay o la UART no recibe por DMA.
+*/
+uint32_t uartReadDma(uartMap_t uart, uint8_t *data, uint32_t size, tick_t delay);
+
+/**
+* @fn uint32_t uartGetDmaRxLost(uartMap_t uart)
+* @brief Cantidad de bytes recibidos por DMA y descartados por falta de lugar en el stream.
+* @param uart : UART a consultar.
+* @return Cantidad de bytes descartados.
+*/
+uint32_t uartGetDmaRxLost(uartMap_t uart);
+
 /**
 * @fn uartError_t uartReadByte(uartMap_t uart, uint8_t *data);
 * @brief Lectura de un byte de la UART.
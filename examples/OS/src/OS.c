@@ -8,13 +8,34 @@
          4 - Idle Hook
          5 - Semaforos
          6 - Colas  
+         7 - Idle tickless
+         8 - Estadisticas de uso de CPU por tarea
+         9 - Creacion, borrado y suspension de tareas en tiempo de ejecucion
+        10 - Grupos de eventos
+        11 - Timers por software
+        12 - Notificaciones directas a tareas
+        13 - Pools de bloques de memoria de tamaño fijo
+        14 - Procesamiento diferido de interrupciones
+        15 - Buffers de stream y de mensajes
+        16 - Scheduling EDF de tareas periodicas con contabilizacion de deadlines perdidos
+        17 - Tabla de vectores en RAM con instalacion directa de los callbacks de IRQ
+        18 - Log binario diferido con formateo en la PC
 * @note  Copyright 2019 - Esp. Ing. Matias Alvarez.
 */
 
 /*==================[inclusions]=============================================*/
 #include "OS.h"
-#include "board.h"
+#include "OS_port.h"
 #include <string.h>
+#if ( OS_USE_TIMER == 1 )
+    #include "OS_timer.h"
+#endif
+#if ( OS_USE_IRQ_DEFER == 1 )
+    #include "OS_defer.h"
+#endif
+#if ( OS_USE_TASK_STATS == 1 )
+    #include <stdio.h>
+#endif
 /*==================[macros]=================================================*/
 /**
 * @def OS_NULL_PRIORITY
@@ -23,16 +44,47 @@
 #define OS_NULL_PRIORITY    0
 
 /**
-* @def EXC_RETURN
-* @var Valor de retorno de interrupcion
+* @def OS_READY_LIST_LEN
+* @var Largo de la lista circular de tareas ready de cada prioridad
+* @note Es la menor potencia de 2 mayor o igual a OS_MAX_TASK, de forma que los indices
+        circulares se calculen con una mascara en lugar de con el operador modulo
+*/
+#define OS_READY_LIST_LEN   ( (OS_MAX_TASK <=   1) ?   1 : (OS_MAX_TASK <=   2) ?   2 : \
+                              (OS_MAX_TASK <=   4) ?   4 : (OS_MAX_TASK <=   8) ?   8 : \
+                              (OS_MAX_TASK <=  16) ?  16 : (OS_MAX_TASK <=  32) ?  32 : \
+                              (OS_MAX_TASK <=  64) ?  64 : (OS_MAX_TASK <= 128) ? 128 : 256 )
+
+/**
+* @def OS_READY_LIST_MASK
+* @var Mascara para avanzar los indices de la lista circular de tareas ready
+*/
+#define OS_READY_LIST_MASK  ( OS_READY_LIST_LEN - 1 )
+
+/**
+* @def OS_READY_PRIO_BIT(prio)
+* @brief Bit del bitmap de prioridades ready correspondiente a la prioridad prio
+* @note La prioridad 0(la mas alta) ocupa el bit 31, de forma que __CLZ() sobre el bitmap
+        devuelve directamente la prioridad ready mas alta
+*/
+#define OS_READY_PRIO_BIT(prio)   ( 0x80000000UL >> (prio) )
+
+/**
+* @def OS_TICK_RATE_HZ
+* @var Frecuencia del tick del sistema
 */
-#define EXC_RETURN          0xFFFFFFF9
+#define OS_TICK_RATE_HZ     1000
 
 /**
-* @def NVIC_PENDSV_PRI
-* @var Prioridad de la interrupcion PendSV
+* @def OS_TICKLESS_MIN_IDLE_TICKS
+* @var Minima cantidad de ticks ociosos a partir de la cual conviene detener el tick del sistema
 */
-#define NVIC_PENDSV_PRI     0xff
+#define OS_TICKLESS_MIN_IDLE_TICKS  2
+
+/**
+* @def OS_DELAY_LIST_CONTAINS(id)
+* @brief Macro para detectar si una tarea esta en la lista de tareas demoradas
+*/
+#define OS_DELAY_LIST_CONTAINS(id)  ( (id) == g_Os.delayListHead || OS_INVALID_TASK != g_Os.taskList[(id)].delayPrev )
 /*==================[typedef]================================================*/
 /** @enum osState_t
 * @brief Posibles estados del SO
@@ -53,8 +105,23 @@ typedef enum
 ,   TASK_STATE_READY                    /**< Estado Ready     - La tarea esta a la espera de su ejecucion */
 ,   TASK_STATE_RUNNING                  /**< Estado Corriendo - La tarea esta corriendo */
 ,   TASK_STATE_BLOCKED                  /**< Estado Bloqueado - La tarea esta a la espera de la ocurrencia de un evento*/
+,   TASK_STATE_SUSPENDED                /**< Estado Suspendido - La tarea no se ejecuta hasta que se llame a taskResume() */
+,   TASK_STATE_DELETED                  /**< Estado Borrado   - La tarea se borro a si misma y su stack aun no fue liberado */
 }taskState_t;
 
+#if ( OS_USE_TASK_NOTIFY == 1 )
+/**
+* @enum notifyState_t
+* @brief Posibles estados de la notificacion de una tarea
+*/
+typedef enum
+{
+    NOTIFY_STATE_NONE  = 0x00           /**< Sin notificaciones pendientes */
+,   NOTIFY_STATE_WAITING                /**< La tarea esta bloqueada a la espera de una notificacion */
+,   NOTIFY_STATE_PENDING                /**< Hay una notificacion que la tarea aun no recibio */
+}notifyState_t;
+#endif
+
 /**
 * @struct taskControlBlock_t
 * @brief Estructura de control de cada tarea del SO
@@ -67,9 +134,40 @@ typedef struct
     taskFunction_t  taskFx;                         /**< Tarea a ejecutar */
     void  *         parameters;                     /**< Puntero a los parametros de la tarea */
     uint32_t        priority;                       /**< Prioridad de la tarea */
+    #if ( OS_USE_MUTEX == 1 )
+        uint32_t        basePriority;               /**< Prioridad asignada en taskCreate() - priority puede estar
+                                                         elevada temporalmente por herencia de prioridad */
+        uint32_t        mutexHeld;                  /**< Cantidad de mutex tomados por la tarea */
+    #endif
     #if ( OS_USE_TASK_DELAY == 1 )
         taskState_t     state;                      /**< Estado de la tarea */
-        tick_t          ticksToWait;                /**< Ticks a esperar en caso de ejecucion de taskDelay() */
+        tick_t          ticksToWait;                /**< Ticks a esperar en caso de ejecucion de taskDelay() - 
+                                                         Dentro de la lista de tareas demoradas es la diferencia
+                                                         de ticks respecto de la tarea anterior de la lista */
+        uint8_t         delayPrev;                  /**< Tarea anterior en la lista de tareas demoradas */
+        uint8_t         delayNext;                  /**< Tarea siguiente en la lista de tareas demoradas */
+        waitList_t *    waitList;                   /**< Lista de espera en la que esta bloqueada la tarea, NULL si ninguna */
+        uint8_t         waitNext;                   /**< Tarea siguiente en la lista de espera */
+        osReturn_t      waitResult;                 /**< Resultado de la espera: OS_RESULT_OK si la desperto el objeto,
+                                                         OS_RESULT_ERROR si expiro el timeout */
+    #endif
+    #if ( OS_USE_RING == 1 )
+        uint8_t         deferredWakeable;           /**< Indica si la tarea espera ser despertada por taskWakeDeferredFromISR() */
+    #endif
+    #if ( OS_USE_TASK_NOTIFY == 1 )
+        uint32_t        notifyValue;                /**< Palabra de notificacion de la tarea */
+        notifyState_t   notifyState;                /**< Estado de la notificacion de la tarea */
+    #endif
+    #if ( OS_USE_EDF_SCHED == 1 )
+        tick_t          period;                     /**< Periodo de la tarea, 0 si no es periodica */
+        tick_t          relativeDeadline;           /**< Deadline de cada trabajo respecto de su activacion */
+        tick_t          release;                    /**< Tick de activacion del trabajo actual */
+        tick_t          absoluteDeadline;           /**< Tick limite del trabajo actual - Clave de orden EDF */
+        uint32_t        deadlineMisses;             /**< Trabajos terminados despues de su deadline */
+    #endif
+    #if ( OS_USE_TASK_STATS == 1 )
+        uint64_t        cycles;                     /**< Ciclos de CPU ejecutados por la tarea */
+        uint32_t        switchCount;                /**< Cantidad de veces que la tarea fue puesta en ejecucion */
     #endif
                  
     uint8_t         taskName[OS_MAX_TASK_NAME_LEN]; /**< Nombre de la tarea - Solo como proposito de debug */ 
@@ -97,19 +195,45 @@ typedef struct
 typedef struct
 {
     uint8_t             currentTask;                                       /**< Tarea actual */
-    uint8_t             maxTask;                                           /**< Tareas agregadas al SO, puede diferir de OS_MAX_TASK */
+    uint8_t             maxTask;                                           /**< Lugares de la lista de tareas usados alguna vez, 
+                                                                                puede diferir de OS_MAX_TASK */
     tick_t              tickCount;                                         /**< Tick del sistema */
-    uint32_t            readyTaskList[OS_MAX_TASK_PRIORITY][OS_MAX_TASK];  /**< Lista de tareas ready por cada prioridad */
+#if ( OS_USE_TASK_DELAY == 1 )
+    uint8_t             delayListHead;                                     /**< Primera tarea de la lista de tareas demoradas, 
+                                                                                ordenada por vencimiento */
+#endif
+    uint32_t            readyPrioBitmap;                                   /**< Bitmap de prioridades con al menos una tarea ready */
+    uint8_t             readyTaskList[OS_MAX_TASK_PRIORITY][OS_READY_LIST_LEN];  /**< Lista de tareas ready por cada prioridad */
     readyTaskInfo_t     readyTaskInfo[OS_MAX_TASK_PRIORITY];               /**< Informacion de la lista de tareas ready por cada prioridad */
+#if ( OS_USE_RING == 1 )
+    volatile uint32_t   deferredWake[(OS_MAX_TASK + 31) / 32];             /**< Bitmap de tareas a despertar en el proximo schedule */
+#endif
 #if ( OS_USE_TASK_DELAY == 1 )
     /* Si esta estipulado el uso de delay se crea el stack de la idle task */
-    uint32_t idleTaskStack[OS_IDLE_STACK_SIZE];                             /**< Task Stack para la Idle Task */
+    uint32_t idleTaskStack[OS_IDLE_STACK_SIZE / sizeof(uint32_t)];                             /**< Task Stack para la Idle Task */
     /* Si esta estipulado el uso de delay se crea un espacio extra para la idle task */
     taskControlBlock_t taskList[OS_MAX_TASK + 1];                           /**< Lista de tareas del sistema */
 #else
     taskControlBlock_t taskList[OS_MAX_TASK];                               /**< Lista de tareas del sistema */
 #endif
     osState_t           state;
+    uint32_t            criticalNesting;                                   /**< Nivel de anidamiento de secciones criticas */
+#if ( OS_USE_DYNAMIC_TASKS == 1 )
+    uint8_t             deletedCount;                                      /**< Tareas borradas cuyo stack aun no fue liberado */
+#endif
+#if ( OS_USE_TICKLESS_IDLE == 1 )
+    uint32_t            ticksPerTick;                                      /**< Cuentas del SysTick por cada tick del sistema */
+    tick_t              maxSuppressedTicks;                                /**< Maxima cantidad de ticks que se pueden suprimir en un solo sleep */
+#endif
+#if ( OS_USE_TASK_STATS == 1 )
+    uint32_t            statsMark;                                         /**< Cuenta del contador de ciclos en la ultima contabilizacion */
+    uint64_t            isrCycles;                                         /**< Ciclos de CPU ejecutados en IRQs */
+    uint8_t             isrNesting;                                        /**< Nivel de anidamiento de IRQs */
+#endif
+#if ( OS_USE_TICK_PROFILE == 1 )
+    volatile uint32_t   tickCycles;                                        /**< Ciclos del ultimo SysTick */
+    volatile uint32_t   tickUpdateCycles;                                  /**< Ciclos de la ultima actualizacion de tareas demoradas del SysTick */
+#endif
 
 }osControl_t;
 /*==================[internal data declaration]==============================*/
@@ -123,9 +247,21 @@ static osControl_t g_Os =
     .maxTask        = 0                 /* Inicializacion en 0 */
 ,   .currentTask    = OS_INVALID_TASK   /* Inicializacion en valor invalido */
 ,   .tickCount      = 0                 /* Inicializacion en 0 */
+#if ( OS_USE_TASK_DELAY == 1 )
+,   .delayListHead  = OS_INVALID_TASK   /* Inicializacion en lista vacia */
+#endif
 };
 
 /*==================[internal functions declaration]=========================*/
+static void schedule();
+
+#if ( OS_USE_TICKLESS_IDLE == 1 )
+    static void ticklessIdle(void);
+#endif
+
+#if ( OS_USE_DYNAMIC_TASKS == 1 )
+    static void taskReapDeleted(void);
+#endif
 
 /*==================[internal data definition]===============================*/
 
@@ -161,20 +297,53 @@ static osControl_t g_Os =
     {
         while(1)
         {
-            /* Sleep */
-            __WFI();
+            #if ( OS_USE_DYNAMIC_TASKS == 1 )
+                /* Liberamos los stacks de las tareas que se borraron a si mismas */
+                taskReapDeleted();
+            #endif
+
+            #if ( OS_USE_TICKLESS_IDLE == 1 )
+                /* Sleep sin tick hasta el proximo vencimiento de delay */
+                ticklessIdle();
+            #else
+                /* Sleep */
+                __WFI();
+            #endif
         }
     }
 #endif
 
+#if ( OS_USE_DYNAMIC_TASKS == 1 )
+    /**
+    * @fn void taskReapHook(uint32_t * stack, uint32_t stackSize)
+    * @brief Funcion a ejecutarse cuando se libera el stack de una tarea borrada
+    * @param stack     : Puntero al stack de la tarea
+    * @param stackSize : Tamaño del stack de la tarea
+    * @return Nada
+    * @note Permite devolver el stack a un pool del usuario
+    * @note Funcion weak
+    * @warning Se llama desde la tarea que llama a taskDelete() o taskCreate(), o desde la idle task,
+               por lo que NO debe bloquearse
+    */
+    __attribute__ ((weak)) void taskReapHook(uint32_t * stack, uint32_t stackSize)
+    {
+        /* DO NOTHING */
+    }
+#endif
+
 /**
 * @fn static void returnHook()
 * @brief Funcion a ejecutarse en caso de que una tarea retorne
 * @param Ninguno
 * @return NUNCA RETORNA
+* @note Con OS_USE_DYNAMIC_TASKS la tarea se borra a si misma
 */
 static void returnHook()
 {
+    #if ( OS_USE_DYNAMIC_TASKS == 1 )
+        taskDelete(g_Os.currentTask);
+    #endif
+
     /* While infinito */
     while(1)
         ;
@@ -209,6 +378,27 @@ static osReturn_t osIncrementTick()
 
 }
 
+#if ( OS_USE_EDF_SCHED == 1 )
+    /**
+    * @fn static uint8_t edfBefore(uint8_t a, uint8_t b)
+    * @brief Funcion que evalua si una tarea debe ejecutarse antes que otra de su misma prioridad
+    * @param a : id de la tarea a evaluar
+    * @param b : id de la tarea con la que se compara
+    * @return 1 si a es periodica y su deadline absoluto es anterior al de b, o b no es periodica. 0 caso contrario
+    * @note La resta con signo contempla el desborde del tick del sistema
+    */
+    static uint8_t edfBefore(uint8_t a, uint8_t b)
+    {
+        if(0 == g_Os.taskList[a].period)
+        {
+            return 0;
+        }
+
+        return (0 == g_Os.taskList[b].period ||
+                0 > (int32_t)(g_Os.taskList[a].absoluteDeadline - g_Os.taskList[b].absoluteDeadline));
+    }
+#endif
+
 #if ( OS_USE_PRIO_ROUND_ROBIN_SCHED == 1)
     /**
     * @fn static void addReadyTask(uint8_t id, uint32_t prio)
@@ -216,14 +406,33 @@ static osReturn_t osIncrementTick()
     * @param id    : id de la tarea a agregar
     * @param prio  : Prioridad de la tarea a agregar
     * @return Nada
+    * @note Con OS_USE_EDF_SCHED la tarea se inserta detras de las de deadline igual o anterior, de forma
+            que la primera tarea ready es la de deadline mas proximo y el round robin solo alterna
+            entre tareas de igual deadline. Las tareas sin deadline quedan al final, por orden de llegada
     */
     static void addReadyTask(uint8_t id, uint32_t prio)
     {
-        /* Agregamos la tarea en el primer lugar libre dentro de la prioridad especifica */
-        g_Os.readyTaskList[prio]
-        [(g_Os.readyTaskInfo[prio].firstReadyTask + g_Os.readyTaskInfo[prio].readyTaskCnt) % g_Os.maxTask] = id;
+        #if ( OS_USE_EDF_SCHED == 1 )
+            uint8_t first = g_Os.readyTaskInfo[prio].firstReadyTask;   /**< Primer tarea ready */
+            uint8_t pos = g_Os.readyTaskInfo[prio].readyTaskCnt;       /**< Posicion relativa de la tarea */
+
+            /* Corremos hacia atras las tareas que deben ejecutarse despues de la agregada */
+            while(0 < pos && edfBefore(id, g_Os.readyTaskList[prio][(first + pos - 1) & OS_READY_LIST_MASK]))
+            {
+                g_Os.readyTaskList[prio][(first + pos) & OS_READY_LIST_MASK] = 
+                    g_Os.readyTaskList[prio][(first + pos - 1) & OS_READY_LIST_MASK];
+                pos--;
+            }
+            g_Os.readyTaskList[prio][(first + pos) & OS_READY_LIST_MASK] = id;
+        #else
+            /* Agregamos la tarea en el primer lugar libre dentro de la prioridad especifica */
+            g_Os.readyTaskList[prio]
+            [(g_Os.readyTaskInfo[prio].firstReadyTask + g_Os.readyTaskInfo[prio].readyTaskCnt) & OS_READY_LIST_MASK] = id;
+        #endif
         /* Aumentamos la cantidad de tareas ready */
         g_Os.readyTaskInfo[prio].readyTaskCnt++;
+        /* Marcamos la prioridad como ready en el bitmap */
+        g_Os.readyPrioBitmap |= OS_READY_PRIO_BIT(prio);
 
     }
 
@@ -246,54 +455,401 @@ static osReturn_t osIncrementTick()
         {
             /* Reiniciamos el puntero a la primer tarea ready */
             g_Os.readyTaskInfo[prio].firstReadyTask = 0;
+            /* La prioridad deja de estar ready en el bitmap */
+            g_Os.readyPrioBitmap &= ~OS_READY_PRIO_BIT(prio);
         }
         else
         {
             /* Sino, lo avanzamos en 1 */
-            g_Os.readyTaskInfo[prio].firstReadyTask = (g_Os.readyTaskInfo[prio].firstReadyTask + 1) % g_Os.maxTask;
+            g_Os.readyTaskInfo[prio].firstReadyTask = (g_Os.readyTaskInfo[prio].firstReadyTask + 1) & OS_READY_LIST_MASK;
         }
         
     }
+
+    #if ( OS_USE_MUTEX == 1 ) || ( OS_USE_DYNAMIC_TASKS == 1 )
+        /**
+        * @fn static void removeReadyTaskById(uint8_t id, uint32_t prio)
+        * @brief Funcion que remueve una tarea especifica de la lista de tareas ready
+        * @param id    : id de la tarea a remover
+        * @param prio  : Prioridad de la tarea a remover 
+        * @return Nada
+        * @note Se corren una posicion hacia atras las tareas que estaban detras de la removida
+        */
+        static void removeReadyTaskById(uint8_t id, uint32_t prio)
+        {
+            uint8_t i;      /**< Posicion relativa a la primer tarea ready */
+            uint8_t first = g_Os.readyTaskInfo[prio].firstReadyTask;   /**< Primer tarea ready */
+            uint8_t cnt = g_Os.readyTaskInfo[prio].readyTaskCnt;       /**< Cantidad de tareas ready */
+
+            /* Buscamos la tarea */
+            for(i = 0; i < cnt && id != g_Os.readyTaskList[prio][(first + i) & OS_READY_LIST_MASK]; i++)
+                ;
+
+            /* Si la encontramos corremos las siguientes y la removemos */
+            if(i < cnt)
+            {
+                for(; i < cnt - 1; i++)
+                {
+                    g_Os.readyTaskList[prio][(first + i) & OS_READY_LIST_MASK] = 
+                        g_Os.readyTaskList[prio][(first + i + 1) & OS_READY_LIST_MASK];
+                }
+
+                g_Os.readyTaskInfo[prio].readyTaskCnt--;
+
+                if(0 == g_Os.readyTaskInfo[prio].readyTaskCnt)
+                {
+                    g_Os.readyTaskInfo[prio].firstReadyTask = 0;
+                    g_Os.readyPrioBitmap &= ~OS_READY_PRIO_BIT(prio);
+                }
+            }
+        }
+    #endif
 #endif  
 
 #if ( OS_USE_TASK_DELAY == 1 )
     /**
-    * @fn static void delayUpdate(void)
+    * @fn static void delayListInsert(uint8_t id, tick_t ticks)
+    * @brief Funcion que agrega una tarea a la lista de tareas demoradas
+    * @param id    : id de la tarea a agregar
+    * @param ticks : Ticks que debe esperar la tarea
+    * @return Nada
+    * @note La lista esta ordenada por vencimiento y cada tarea guarda solo la diferencia de ticks
+            respecto de la anterior, de forma que el tick del sistema solo actualiza la primera
+    */
+    static void delayListInsert(uint8_t id, tick_t ticks)
+    {
+        uint8_t prev = OS_INVALID_TASK;     /**< Tarea tras la cual se inserta */
+        uint8_t next = g_Os.delayListHead;  /**< Tarea ante la cual se inserta */
+
+        /* Avanzamos descontando las diferencias mientras venzan antes o al mismo tiempo (FIFO) */
+        while(OS_INVALID_TASK != next && g_Os.taskList[next].ticksToWait <= ticks)
+        {
+            ticks -= g_Os.taskList[next].ticksToWait;
+            prev = next;
+            next = g_Os.taskList[next].delayNext;
+        }
+
+        g_Os.taskList[id].ticksToWait = ticks;
+        g_Os.taskList[id].delayPrev   = prev;
+        g_Os.taskList[id].delayNext   = next;
+
+        if(OS_INVALID_TASK == prev)
+        {
+            g_Os.delayListHead = id;
+        }
+        else
+        {
+            g_Os.taskList[prev].delayNext = id;
+        }
+
+        if(OS_INVALID_TASK != next)
+        {
+            /* La siguiente tarea ahora vence respecto de la insertada */
+            g_Os.taskList[next].ticksToWait -= ticks;
+            g_Os.taskList[next].delayPrev = id;
+        }
+    }
+
+    /**
+    * @fn static void delayListRemove(uint8_t id)
+    * @brief Funcion que remueve una tarea de la lista de tareas demoradas
+    * @param id    : id de la tarea a remover
+    * @return Nada
+    */
+    static void delayListRemove(uint8_t id)
+    {
+        uint8_t prev = g_Os.taskList[id].delayPrev; /**< Tarea anterior */
+        uint8_t next = g_Os.taskList[id].delayNext; /**< Tarea siguiente */
+
+        if(OS_INVALID_TASK != next)
+        {
+            /* La siguiente tarea hereda la diferencia de ticks de la removida */
+            g_Os.taskList[next].ticksToWait += g_Os.taskList[id].ticksToWait;
+            g_Os.taskList[next].delayPrev = prev;
+        }
+
+        if(OS_INVALID_TASK == prev)
+        {
+            g_Os.delayListHead = next;
+        }
+        else
+        {
+            g_Os.taskList[prev].delayNext = next;
+        }
+
+        g_Os.taskList[id].delayPrev = OS_INVALID_TASK;
+        g_Os.taskList[id].delayNext = OS_INVALID_TASK;
+    }
+
+    /**
+    * @fn static void waitListRemove(waitList_t * list, uint8_t id)
+    * @brief Funcion que remueve una tarea de una lista de espera
+    * @param list  : Lista de espera
+    * @param id    : id de la tarea a remover
+    * @return Nada
+    */
+    static void waitListRemove(waitList_t * list, uint8_t id)
+    {
+        uint8_t * link = &(list->head);    /**< Enlace que apunta a la tarea a evaluar */
+
+        /* Buscamos el enlace que apunta a la tarea y lo salteamos */
+        while(OS_INVALID_TASK != *link)
+        {
+            if(id == *link)
+            {
+                *link = g_Os.taskList[id].waitNext;
+                break;
+            }
+            link = &(g_Os.taskList[*link].waitNext);
+        }
+
+        g_Os.taskList[id].waitList = NULL;
+        g_Os.taskList[id].waitNext = OS_INVALID_TASK;
+    }
+
+    /**
+    * @fn static void waitListInsert(waitList_t * list, uint8_t id)
+    * @brief Funcion que agrega una tarea a una lista de espera
+    * @param list  : Lista de espera
+    * @param id    : id de la tarea a agregar
+    * @return Nada
+    * @note La tarea se inserta detras de las tareas de igual o mayor prioridad
+    */
+    static void waitListInsert(waitList_t * list, uint8_t id)
+    {
+        uint8_t * link = &(list->head);     /**< Enlace tras el cual se inserta la tarea */
+
+        /* Avanzamos mientras las tareas en espera tengan igual o mayor prioridad - Menor numero */
+        while(OS_INVALID_TASK != *link && g_Os.taskList[*link].priority <= g_Os.taskList[id].priority)
+        {
+            link = &(g_Os.taskList[*link].waitNext);
+        }
+        g_Os.taskList[id].waitNext = *link;
+        *link = id;
+
+        g_Os.taskList[id].waitList = list;
+    }
+
+    /**
+    * @fn static void taskBlock(uint8_t id, tick_t ticksToWait)
+    * @brief Funcion que bloquea una tarea con timeout
+    * @param id          : id de la tarea a bloquear
+    * @param ticksToWait : Ticks maximos a esperar, OS_MAX_DELAY para esperar por siempre
+    * @return Nada
+    * @note Debe ser llamada con el cambio de contexto suspendido
+    */
+    static void taskBlock(uint8_t id, tick_t ticksToWait)
+    {
+        g_Os.taskList[id].state = TASK_STATE_BLOCKED;
+        /* El delay infinito no vence nunca, por lo que no se agrega a la lista de tareas demoradas */
+        if(OS_MAX_DELAY == ticksToWait)
+        {
+            g_Os.taskList[id].ticksToWait = ticksToWait;
+        }
+        else
+        {
+            delayListInsert(id, ticksToWait);
+        }
+    }
+
+    /**
+    * @fn static void delayUpdate(tick_t ticks)
     * @brief Funcion actualiza los ticks restantes de las tareas bloqueadas
+    * @param  ticks : Ticks transcurridos desde la ultima actualizacion
+    * @return Nada
+    * @note Solo se actualiza la primera tarea de la lista de tareas demoradas, 
+            el resto de las tareas guarda su vencimiento relativo a la anterior
+    */
+    static void delayUpdate(tick_t ticks)
+    {
+        uint8_t id;  /**< Tarea vencida */
+
+        /* Mientras haya tareas demoradas */
+        while(OS_INVALID_TASK != g_Os.delayListHead)
+        {
+            id = g_Os.delayListHead;
+            /* Si la primera tarea aun no vence, descontamos los ticks transcurridos y terminamos */
+            if(g_Os.taskList[id].ticksToWait > ticks)
+            {
+                g_Os.taskList[id].ticksToWait -= ticks;
+                break;
+            }
+            /* Si no, descontamos sus ticks de los transcurridos y la removemos */
+            ticks -= g_Os.taskList[id].ticksToWait;
+            g_Os.taskList[id].ticksToWait = 0;
+            delayListRemove(id);
+            /* Si esperaba un objeto del SO, expiro el timeout y deja de esperarlo */
+            if(NULL != g_Os.taskList[id].waitList)
+            {
+                g_Os.taskList[id].waitResult = OS_RESULT_ERROR;
+                waitListRemove(g_Os.taskList[id].waitList, id);
+            }
+            /* Ponemos la tarea en ready y la agregamos a la lista de tareas ready */
+            g_Os.taskList[id].state = TASK_STATE_READY;
+            addReadyTask(id, g_Os.taskList[id].priority - 1);
+        }
+    }
+#endif
+
+#if ( OS_USE_TICKLESS_IDLE == 1 )
+    /**
+    * @fn static tick_t delayNextExpiry(void)
+    * @brief Funcion que obtiene los ticks hasta el proximo vencimiento de delay
+    * @param  Ninguno
+    * @return Ticks hasta el proximo vencimiento, OS_MAX_DELAY si ninguna tarea espera con timeout
+    */
+    static tick_t delayNextExpiry(void)
+    {
+        /* La primera tarea de la lista de tareas demoradas es la de vencimiento mas proximo */
+        return (OS_INVALID_TASK == g_Os.delayListHead) ? OS_MAX_DELAY : g_Os.taskList[g_Os.delayListHead].ticksToWait;
+    }
+
+    /**
+    * @fn static void ticklessIdle(void)
+    * @brief Funcion que duerme al procesador sin tick hasta el proximo vencimiento de delay
     * @param  Ninguno
     * @return Nada
+    * @note Se reprograma el SysTick para una unica interrupcion al cabo de los ticks ociosos
+            esperados y, al despertar, se compensan los ticks suprimidos en g_Os.tickCount
+    * @warning Solo debe ser llamada desde la idle task
     */
-    static void delayUpdate(void)
+    static void ticklessIdle(void)
     {
-        uint8_t i;  /**< Indice del for */
-        /* Por cada tarea */
-        for (i = 0; i < g_Os.maxTask; i++) 
+        tick_t   expectedIdle;   /**< Ticks ociosos esperados */
+        tick_t   completedTicks; /**< Ticks completos transcurridos durante el sleep */
+        uint32_t reload;         /**< Valor de recarga del SysTick durante el sleep */
+        uint32_t elapsed;        /**< Cuentas del SysTick transcurridas durante el sleep */
+        uint32_t ctrl;           /**< Copia del registro de control del SysTick */
+
+        __disable_irq();
+
+        expectedIdle = delayNextExpiry();
+
+        /* Si alguna IRQ ya puso una tarea en ready o el proximo vencimiento esta muy cerca,
+           dormimos normalmente a la espera del tick */
+        if(0 != g_Os.readyPrioBitmap || OS_TICKLESS_MIN_IDLE_TICKS > expectedIdle)
+        {
+            __enable_irq();
+            __WFI();
+            return;
+        }
+
+        if(g_Os.maxSuppressedTicks < expectedIdle)
+        {
+            expectedIdle = g_Os.maxSuppressedTicks;
+        }
+
+        /* Detenemos el SysTick */
+        SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+
+        /* Si el tick expiro mientras calculabamos, abortamos y dejamos que la IRQ del SysTick lo procese */
+        if(SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+        {
+            SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+            __enable_irq();
+            return;
+        }
+
+        /* Programamos una unica interrupcion al cabo de los ticks ociosos,
+           considerando lo que restaba del tick en curso */
+        reload = SysTick->VAL + (g_Os.ticksPerTick * (expectedIdle - 1));
+        SysTick->LOAD = reload;
+        SysTick->VAL  = 0;
+        SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+
+        /* Sleep - Con las interrupciones deshabilitadas el WFI despierta igual ante una IRQ pendiente */
+        __DSB();
+        __WFI();
+        __ISB();
+
+        /* Detenemos el SysTick leyendo una unica vez el registro de control,
+           ya que la lectura limpia el COUNTFLAG */
+        ctrl = SysTick->CTRL;
+        SysTick->CTRL = ctrl & ~SysTick_CTRL_ENABLE_Msk;
+
+        if(ctrl & SysTick_CTRL_COUNTFLAG_Msk)
+        {
+            /* Desperto el SysTick: la IRQ pendiente contabiliza el ultimo tick,
+               recargamos con lo que resta del tick en curso */
+            elapsed = reload - SysTick->VAL;
+            SysTick->LOAD = (elapsed < g_Os.ticksPerTick - 1) ? (g_Os.ticksPerTick - 1) - elapsed : g_Os.ticksPerTick - 1;
+            completedTicks = expectedIdle - 1;
+        }
+        else
+        {
+            /* Desperto otra IRQ: contabilizamos los ticks completos y
+               recargamos con lo que resta del tick en curso */
+            elapsed = (expectedIdle * g_Os.ticksPerTick) - SysTick->VAL;
+            completedTicks = elapsed / g_Os.ticksPerTick;
+            SysTick->LOAD = ((completedTicks + 1) * g_Os.ticksPerTick) - elapsed;
+        }
+
+        /* Reiniciamos el SysTick y restauramos la recarga de un tick para las siguientes cuentas */
+        SysTick->VAL  = 0;
+        SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+        SysTick->LOAD = g_Os.ticksPerTick - 1;
+
+        /* Compensamos los ticks suprimidos */
+        if(0 < completedTicks)
         {
-            /* Si la tarea esta bloqueada y la cantidad de ticks a esperar es mayor a 0 
-                y menor que el maximo delay(delay forever) */
-            if (TASK_STATE_BLOCKED == g_Os.taskList[i].state 
-                && 0 < g_Os.taskList[i].ticksToWait && OS_MAX_DELAY > g_Os.taskList[i].ticksToWait) 
+            g_Os.tickCount += completedTicks;
+            delayUpdate(completedTicks);
+            /* Si vencio algun delay llamamos al scheduler */
+            if(0 != g_Os.readyPrioBitmap)
             {
-                /* Decrementamos los ticks a esperar */
-                g_Os.taskList[i].ticksToWait--;
-                /* Si luego del decremento los ticks llegaron a 0 */
-                if (g_Os.taskList[i].ticksToWait == 0) {
-                    /* Ponemos la tarea en ready y la agregamos a la lista de tareas ready */
-                    g_Os.taskList[i].state = TASK_STATE_READY;
-                    addReadyTask(i, g_Os.taskList[i].priority - 1);
-                }
+                schedule();
             }
         }
+
+        __enable_irq();
+    }
+#endif
+
+#if ( OS_USE_TASK_STATS == 1 )
+    /**
+    * @fn static void statsCharge(uint64_t * cycles)
+    * @brief Funcion que suma a un acumulador los ciclos transcurridos desde la ultima contabilizacion
+    * @param cycles : Acumulador de ciclos de la tarea o de las IRQs
+    * @return Nada
+    * @note La resta en 32 bits contempla el desborde del contador de ciclos
+    */
+    static void statsCharge(uint64_t * cycles)
+    {
+        uint32_t now = OS_PORT_CYCLE_COUNT();   /**< Cuenta actual del contador de ciclos */
+
+        *cycles += (uint32_t)(now - g_Os.statsMark);
+        g_Os.statsMark = now;
+    }
+
+    /**
+    * @fn static void statsChargeCurrentTask(void)
+    * @brief Funcion que contabiliza a la tarea actual los ciclos transcurridos desde la ultima contabilizacion
+    * @param Ninguno
+    * @return Nada
+    */
+    static void statsChargeCurrentTask(void)
+    {
+        if(OS_INVALID_TASK == g_Os.currentTask)
+        {
+            /* Antes del primer schedule no hay tarea a la que contabilizarle */
+            g_Os.statsMark = OS_PORT_CYCLE_COUNT();
+        }
+        else
+        {
+            statsCharge(&(g_Os.taskList[g_Os.currentTask].cycles));
+        }
     }
 #endif
 
 /**
-* @fn static void initStack(uint32_t * stack, 
+* @fn static void initStack(uint8_t id,
+                      uint32_t * stack, 
                       uint32_t stackSize, 
                       uint32_t priority,    
                       taskFunction_t taskFx,
                       void * parameters)
 * @brief Funcion inicializa el stack de una tarea
+* @param id         : Lugar de la tarea en la lista de tareas
 * @param stack      : Puntero al stack de la tarea
 * @param stackSize  : Tamaño del stack de la tarea
 * @param priority   : Prioridad de la tarea
@@ -301,117 +857,488 @@ static osReturn_t osIncrementTick()
 * @param taskName   : Nombre de la tarea
 * @parameters       : Puntero a los parametros a pasarle a la tarea
 * @return Nada
+* @note No cambia el estado de la tarea: quien la crea la pasa a ready al terminar de inicializarla
 */
-static void initStack(uint32_t * stack, 
+static void initStack(uint8_t id,
+                      uint32_t * stack, 
                       uint32_t stackSize, 
                       uint32_t priority,    
                       taskFunction_t taskFx,
                       char * taskName,
                       void * parameters)
 {
+    #if ( OS_USE_STACK_CHECK == 1 )
+        uint32_t i; /** Variable para recorrer el stack */
 
-    /* Inicializo el frame en cero */
-    bzero(stack, stackSize);
-
-    /* Ultimo elemento del contexto inicial: xPSR
-     * Necesita el bit 24 (T, modo Thumb) en 1
-     */
-    stack[stackSize/4 - 1]  = 1 << 24;
-
-    /* Anteultimo elemento: PC (entry point) */
-    stack[stackSize/4 - 2]  = (uint32_t)taskFx;
-
-    /* Penultimo elemento: LR (return hook) */
-    stack[stackSize/4 - 3]  = (uint32_t)returnHook;
-
-    /* Elemento -8: R0 (parámetro) */
-    stack[stackSize/4 - 8]  = (uint32_t)parameters;
-
-    stack[stackSize/4 - 9]  = EXC_RETURN;
+        /* Pintamos el stack para medir su uso maximo con taskGetStackHighWaterMark() */
+        for(i = 0; i < stackSize / sizeof(uint32_t); i++)
+        {
+            stack[i] = OS_STACK_FILL_PATTERN;
+        }
+    #endif
 
-    /* Inicializo stack pointer inicial considerando lo otros 8 registros pusheados */
-    g_Os.taskList[g_Os.maxTask].stackPointer  = (uint32_t)&(stack[stackSize/4 - 17]);
+    /* Armamos el contexto inicial de la tarea segun el port */
+    g_Os.taskList[id].stackPointer  = osPortInitStack(id, stack, stackSize, taskFx, 
+                                                                parameters, returnHook);
 
     /* Inicialiazamos el TCB */
-    g_Os.taskList[g_Os.maxTask].taskFx        = taskFx;
-    g_Os.taskList[g_Os.maxTask].stack         = stack;
-    g_Os.taskList[g_Os.maxTask].stackSize     = stackSize;
-    g_Os.taskList[g_Os.maxTask].parameters    = parameters;
-    g_Os.taskList[g_Os.maxTask].priority      = priority;
+    g_Os.taskList[id].taskFx        = taskFx;
+    g_Os.taskList[id].stack         = stack;
+    g_Os.taskList[id].stackSize     = stackSize;
+    g_Os.taskList[id].parameters    = parameters;
+    g_Os.taskList[id].priority      = priority;
+    #if ( OS_USE_MUTEX == 1 )
+        g_Os.taskList[id].basePriority  = priority;
+        g_Os.taskList[id].mutexHeld     = 0;
+    #endif
 
     if(OS_MAX_TASK_NAME_LEN > strlen(taskName))
     {
-        strcpy(g_Os.taskList[g_Os.maxTask].taskName, taskName);    
+        strcpy((char *)g_Os.taskList[id].taskName, taskName);    
     }
     else
     {
-        strcpy(g_Os.taskList[g_Os.maxTask].taskName, "noName");    
+        strcpy((char *)g_Os.taskList[id].taskName, "noName");    
     }
-    
-    g_Os.taskList[g_Os.maxTask].state         = TASK_STATE_READY;
 
     #if ( OS_USE_TASK_DELAY == 1 )
-        /* Inicializamos los ticks de delay en 0 */
-        g_Os.taskList[g_Os.maxTask].ticksToWait   = 0;
+        /* Inicializamos los ticks de delay en 0 y la tarea fuera de la lista de tareas demoradas */
+        g_Os.taskList[id].ticksToWait   = 0;
+        g_Os.taskList[id].delayPrev     = OS_INVALID_TASK;
+        g_Os.taskList[id].delayNext     = OS_INVALID_TASK;
+        /* Inicializamos la tarea fuera de toda lista de espera */
+        g_Os.taskList[id].waitList      = NULL;
+        g_Os.taskList[id].waitNext      = OS_INVALID_TASK;
     #endif
 
-}
-/*==================[external functions definition]==========================*/
-/**
-* @fn void schedule()
-* @brief Funcion que setea la interrupcion del PendSV para que se ejecute el scheduler
-* @param Ninguno
-* @return Nada
-* @warning NO DEBERIA SER LLAMADA POR EL USUARIO DEL OS
-*/
-static void schedule()
-{
-    /* Instruction Synchronization Barrier: aseguramos que se
-     * ejecuten todas las instrucciones en  el pipeline
-     */
-    __ISB();
-    /* Data Synchronization Barrier: aseguramos que se
-     * completen todos los accesos a memoria
-     */
-    __DSB();
-
-    SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
-    
-}
+    #if ( OS_USE_RING == 1 )
+        g_Os.taskList[id].deferredWakeable = 0;
+    #endif
 
-/**
-* @fn osReturn_t taskCreate(taskFunction_t taskFx, uint32_t priority, uint32_t * stack, uint32_t stackSize,
-                   char * taskName, void * parameters)
-* @brief Funcion que crea una tarea dentro del SO
-* @param stack      : Puntero al stack de la tarea
-* @param stackSize  : Tamaño del stack de la tarea
-* @param priority   : Prioridad de la tarea
-* @param taskFx     : Prototipo de la tarea
-* @param taskName   : Nombre de la tarea
-* @parameters       : Puntero a los parametros a pasarle a la tarea
-* @return osReturn_t OS_RESULT_ERROR si la tarea no se puede crear, OS_RESULT_OK caso contrario
-*/
-osReturn_t taskCreate(taskFunction_t taskFx, uint32_t priority, uint32_t * stack, uint32_t stackSize,
-                   char * taskName, void * parameters)
-{
-    osReturn_t retVal = OS_RESULT_ERROR;
+    #if ( OS_USE_TASK_NOTIFY == 1 )
+        g_Os.taskList[id].notifyValue   = 0;
+        g_Os.taskList[id].notifyState   = NOTIFY_STATE_NONE;
+    #endif
 
-    /* Si hay lugar para crear una nueva tarea, su stack size es mayor que el menor permitido,
-    su prioridad es menor que la maxima prioridad y distinta de 0 */
-    if(OS_MAX_TASK > g_Os.maxTask && OS_MINIMAL_STACK_SIZE <= stackSize && 
-        OS_MAX_TASK_PRIORITY >= priority && OS_NULL_PRIORITY != priority)
-    {
-        /* Inicializamos el stack y aumentamos en 1 la cantidad de tareas actual del SO */
-        initStack(stack, stackSize, priority, taskFx, taskName, parameters);
-        g_Os.maxTask++;
+    #if ( OS_USE_EDF_SCHED == 1 )
+        /* Por defecto la tarea no es periodica */
+        g_Os.taskList[id].period            = 0;
+        g_Os.taskList[id].relativeDeadline  = 0;
+        g_Os.taskList[id].release           = 0;
+        g_Os.taskList[id].absoluteDeadline  = 0;
+        g_Os.taskList[id].deadlineMisses    = 0;
+    #endif
 
-        retVal = OS_RESULT_OK;
-        
+    #if ( OS_USE_TASK_STATS == 1 )
+        g_Os.taskList[id].cycles        = 0;
+        g_Os.taskList[id].switchCount   = 0;
+    #endif
+
+}
+#if ( OS_USE_RING == 1 )
+    /**
+    * @fn static void deferredWakeUpdate(void)
+    * @brief Funcion que despierta las tareas solicitadas por taskWakeDeferredFromISR()
+    * @param  Ninguno
+    * @return Nada
+    * @note Se ejecuta dentro del scheduler. Las solicitudes se toman con un intercambio atomico
+            para no perder las que lleguen mientras tanto
+    */
+    static void deferredWakeUpdate(void)
+    {
+        uint8_t  w;     /**< Palabra del bitmap */
+        uint8_t  id;    /**< Tarea a despertar */
+        uint32_t bits;  /**< Solicitudes de la palabra */
+
+        for(w = 0; w < (OS_MAX_TASK + 31) / 32; w++)
+        {
+            /* Tomamos y limpiamos las solicitudes de forma atomica */
+            do
+            {
+                bits = __LDREXW(&(g_Os.deferredWake[w]));
+            }while(0 != __STREXW(0, &(g_Os.deferredWake[w])));
+
+            while(0 != bits)
+            {
+                id = (w * 32) + (31 - __CLZ(bits));
+                bits &= ~(1UL << (id & 31));
+                /* Solo despertamos las tareas que siguen esperando; una solicitud vieja 
+                   no debe despertar a una tarea bloqueada por otro motivo */
+                if(TASK_STATE_BLOCKED == g_Os.taskList[id].state && g_Os.taskList[id].deferredWakeable)
+                {
+                    g_Os.taskList[id].deferredWakeable = 0;
+                    g_Os.taskList[id].waitResult = OS_RESULT_OK;
+                    taskUnsuspendWithinAPI(id);
+                }
+            }
+        }
+    }
+#endif
+#if ( OS_USE_TASK_NOTIFY == 1 )
+    /**
+    * @fn static uint8_t taskNotifyUpdate(uint8_t id, uint32_t value, notifyAction_t action)
+    * @brief Funcion que aplica una notificacion a la palabra de notificacion de una tarea
+    * @param  id     : id de la tarea destino
+    * @param  value  : Valor de la notificacion
+    * @param  action : Accion a realizar sobre la palabra de notificacion
+    * @return 1 si desperto a la tarea, 0 caso contrario
+    * @note La tarea se despierta directamente, sin pasar por una lista de espera
+    * @note Debe ser llamada con el cambio de contexto suspendido
+    */
+    static uint8_t taskNotifyUpdate(uint8_t id, uint32_t value, notifyAction_t action)
+    {
+        notifyState_t prevState = g_Os.taskList[id].notifyState;   /**< Estado previo de la notificacion */
+
+        switch(action)
+        {
+            case NOTIFY_ACTION_SET_BITS:
+                g_Os.taskList[id].notifyValue |= value;
+                break;
+            case NOTIFY_ACTION_INCREMENT:
+                g_Os.taskList[id].notifyValue++;
+                break;
+            case NOTIFY_ACTION_OVERWRITE:
+                g_Os.taskList[id].notifyValue = value;
+                break;
+            default:
+                break;
+        }
+        g_Os.taskList[id].notifyState = NOTIFY_STATE_PENDING;
+
+        /* Solo despertamos a la tarea si sigue bloqueada esperando la notificacion. Si expiro su timeout
+           o fue suspendida, la notificacion queda pendiente y la recibe al volver de la espera */
+        if(NOTIFY_STATE_WAITING == prevState && TASK_STATE_BLOCKED == g_Os.taskList[id].state)
+        {
+            g_Os.taskList[id].waitResult = OS_RESULT_OK;
+            taskUnsuspendWithinAPI(id);
+            return 1;
+        }
+
+        return 0;
+    }
+
+    /**
+    * @fn static void taskNotifyBlock(uint8_t id, tick_t ticksToWait)
+    * @brief Funcion que bloquea la tarea actual a la espera de una notificacion
+    * @param  id          : id de la tarea actual
+    * @param  ticksToWait : Ticks maximos a esperar, OS_MAX_DELAY para esperar por siempre
+    * @return Nada
+    * @note Sin tiempo de espera, desde la idle task o dentro de secciones criticas anidadas no se bloquea
+    * @warning Debe ser llamada con el cambio de contexto suspendido y retorna con el mismo suspendido.
+               Mientras la tarea esta bloqueada el cambio de contexto se reanuda.
+    */
+    static void taskNotifyBlock(uint8_t id, tick_t ticksToWait)
+    {
+        if(0 == ticksToWait || osIsIdleTask(id) || 1 != g_Os.criticalNesting)
+        {
+            return;
+        }
+
+        g_Os.taskList[id].notifyState = NOTIFY_STATE_WAITING;
+        g_Os.taskList[id].waitResult  = OS_RESULT_ERROR;
+        taskBlock(id, ticksToWait);
+
+        /* Volvemos a permitir el cambio de contexto y llamamos al scheduler */
+        osResumeContextSwitching();
+        schedule();
+        /* Volvemos al ser notificados o al expirar el timeout */
+        osSuspendContextSwitching();
+    }
+#endif
+#if ( OS_USE_DYNAMIC_TASKS == 1 )
+    /**
+    * @fn static void taskDetach(uint8_t id)
+    * @brief Funcion que saca a una tarea de la lista de tareas ready, de la de tareas demoradas
+             y de la lista de espera en la que este
+    * @param id : id de la tarea
+    * @return Nada
+    * @note Si la tarea estaba bloqueada, su llamada bloqueante retorna OS_RESULT_ERROR como si expirase el timeout
+    * @note Debe ser llamada con el cambio de contexto suspendido
+    */
+    static void taskDetach(uint8_t id)
+    {
+        if(TASK_STATE_READY == g_Os.taskList[id].state)
+        {
+            removeReadyTaskById(id, g_Os.taskList[id].priority - 1);
+        }
+        else if(TASK_STATE_BLOCKED == g_Os.taskList[id].state)
+        {
+            if(OS_DELAY_LIST_CONTAINS(id))
+            {
+                delayListRemove(id);
+            }
+            if(NULL != g_Os.taskList[id].waitList)
+            {
+                waitListRemove(g_Os.taskList[id].waitList, id);
+            }
+            g_Os.taskList[id].ticksToWait = 0;
+            g_Os.taskList[id].waitResult  = OS_RESULT_ERROR;
+            #if ( OS_USE_RING == 1 )
+                g_Os.taskList[id].deferredWakeable = 0;
+            #endif
+        }
+    }
+
+    /**
+    * @fn static void taskReapDeleted(void)
+    * @brief Funcion que libera los lugares y los stacks de las tareas que se borraron a si mismas
+    * @param Ninguno
+    * @return Nada
+    * @note Una tarea borrada nunca vuelve a ejecutarse, por lo que una vez que el scheduler
+            la saco de ejecucion su stack puede liberarse
+    */
+    static void taskReapDeleted(void)
+    {
+        uint8_t    id;          /**< Tarea a liberar */
+        uint32_t * stack;       /**< Stack de la tarea liberada */
+        uint32_t   stackSize;   /**< Tamaño del stack de la tarea liberada */
+
+        for(id = 0; id < g_Os.maxTask && 0 != g_Os.deletedCount; id++)
+        {
+            stack = NULL;
+
+            osSuspendContextSwitching();
+            if(TASK_STATE_DELETED == g_Os.taskList[id].state)
+            {
+                stack     = g_Os.taskList[id].stack;
+                stackSize = g_Os.taskList[id].stackSize;
+                g_Os.taskList[id].state = TASK_STATE_TERMINATED;
+                g_Os.deletedCount--;
+            }
+            osResumeContextSwitching();
+
+            /* Devolvemos el stack fuera de la seccion critica */
+            if(NULL != stack)
+            {
+                taskReapHook(stack, stackSize);
+            }
+        }
+    }
+#endif
+/*==================[external functions definition]==========================*/
+/**
+* @fn void schedule()
+* @brief Funcion que setea la interrupcion del PendSV para que se ejecute el scheduler
+* @param Ninguno
+* @return Nada
+* @warning NO DEBERIA SER LLAMADA POR EL USUARIO DEL OS
+*/
+static void schedule()
+{
+    /* Dejamos pendiente el cambio de contexto, que se ejecuta en cuanto las interrupciones
+       esten habilitadas */
+    OS_PORT_PEND_SWITCH();
+    
+}
+
+/**
+* @fn static osReturn_t taskCreateInternal(taskFunction_t taskFx, uint32_t priority, uint32_t * stack, uint32_t stackSize,
+                   char * taskName, void * parameters, tick_t period, tick_t deadline, uint8_t * taskId)
+* @brief Funcion que crea una tarea dentro del SO, periodica o no
+* @param period     : Periodo de la tarea, 0 si no es periodica - Solo con OS_USE_EDF_SCHED
+* @param deadline   : Deadline de cada trabajo respecto de su activacion - Solo con OS_USE_EDF_SCHED
+* @note Ver taskCreate() para el resto de los parametros
+* @note La tarea queda suspendida mientras se inicializa fuera de la seccion critica. Pasa a ready, con su
+        periodo y deadline, en la misma seccion critica en que entra a la lista de tareas ready, para que
+        quede ordenada por su deadline
+*/
+static osReturn_t taskCreateInternal(taskFunction_t taskFx, uint32_t priority, uint32_t * stack, uint32_t stackSize,
+                   char * taskName, void * parameters, tick_t period, tick_t deadline, uint8_t * taskId)
+{
+    osReturn_t retVal = OS_RESULT_ERROR;
+    uint8_t    id = OS_INVALID_TASK;    /**< Lugar de la tarea en la lista de tareas */
+
+    /* Si su stack size es mayor que el menor permitido, su prioridad es menor que la maxima prioridad y distinta de 0 */
+    if(OS_MINIMAL_STACK_SIZE <= stackSize && OS_MAX_TASK_PRIORITY >= priority && OS_NULL_PRIORITY != priority)
+    {
+        #if ( OS_USE_DYNAMIC_TASKS == 1 )
+            /* Liberamos los lugares de las tareas que se borraron a si mismas */
+            taskReapDeleted();
+        #endif
+
+        osSuspendContextSwitching();
+
+        #if ( OS_USE_DYNAMIC_TASKS == 1 )
+            /* Buscamos el lugar de alguna tarea borrada, si no usamos uno nuevo */
+            for(id = 0; id < g_Os.maxTask && TASK_STATE_TERMINATED != g_Os.taskList[id].state; id++)
+                ;
+        #else
+            id = g_Os.maxTask;
+        #endif
+
+        /* Si hay lugar reservamos el lugar, para inicializar la tarea fuera de la seccion critica */
+        if(OS_MAX_TASK > id)
+        {
+            g_Os.taskList[id].state = TASK_STATE_SUSPENDED;
+            if(g_Os.maxTask == id)
+            {
+                g_Os.maxTask++;
+            }
+        }
+        else
+        {
+            id = OS_INVALID_TASK;
+        }
+
+        osResumeContextSwitching();
+    }
+
+    if(OS_INVALID_TASK != id)
+    {
+        /* Inicializamos el stack */
+        initStack(id, stack, stackSize, priority, taskFx, taskName, parameters);
+
+        osSuspendContextSwitching();
+
+        #if ( OS_USE_EDF_SCHED == 1 )
+            /* El primer trabajo se activa en la creacion */
+            g_Os.taskList[id].period            = period;
+            g_Os.taskList[id].relativeDeadline  = deadline;
+            g_Os.taskList[id].release           = g_Os.tickCount;
+            g_Os.taskList[id].absoluteDeadline  = g_Os.tickCount + deadline;
+        #endif
+
+        g_Os.taskList[id].state = TASK_STATE_READY;
+
+        #if ( OS_USE_DYNAMIC_TASKS == 1 )
+            /* Con el scheduler corriendo la agregamos a la lista de tareas ready, 
+               si no la agrega taskStartScheduler() */
+            if(OS_INVALID_TASK != g_Os.currentTask)
+            {
+                addReadyTask(id, priority - 1);
+                osResumeContextSwitching();
+                schedule();
+            }
+            else
+            {
+                osResumeContextSwitching();
+            }
+        #else
+            osResumeContextSwitching();
+        #endif
+
+        retVal = OS_RESULT_OK;
+    }
+
+    if(NULL != taskId)
+    {
+        *taskId = id;
     }
 
     return retVal;
 }
 
+/**
+* @fn osReturn_t taskCreate(taskFunction_t taskFx, uint32_t priority, uint32_t * stack, uint32_t stackSize,
+                   char * taskName, void * parameters, uint8_t * taskId)
+* @brief Funcion que crea una tarea dentro del SO
+* @param stack      : Puntero al stack de la tarea
+* @param stackSize  : Tamaño del stack de la tarea
+* @param priority   : Prioridad de la tarea
+* @param taskFx     : Prototipo de la tarea
+* @param taskName   : Nombre de la tarea
+* @parameters       : Puntero a los parametros a pasarle a la tarea
+* @param taskId     : Donde se guarda el id de la tarea creada, OS_INVALID_TASK si no se pudo crear. Puede ser NULL
+* @return osReturn_t OS_RESULT_ERROR si la tarea no se puede crear, OS_RESULT_OK caso contrario
+* @note Con OS_USE_DYNAMIC_TASKS puede llamarse con el scheduler corriendo, y reusa el lugar de las tareas borradas
+*/
+osReturn_t taskCreate(taskFunction_t taskFx, uint32_t priority, uint32_t * stack, uint32_t stackSize,
+                   char * taskName, void * parameters, uint8_t * taskId)
+{
+    return taskCreateInternal(taskFx, priority, stack, stackSize, taskName, parameters, 0, 0, taskId);
+}
+
+#if ( OS_USE_EDF_SCHED == 1 )
+    /**
+    * @fn osReturn_t taskCreatePeriodic(taskFunction_t taskFx, uint32_t priority, uint32_t * stack, uint32_t stackSize,
+                       char * taskName, void * parameters, tick_t period, tick_t deadline, uint8_t * taskId)
+    * @brief Funcion que crea una tarea periodica, que se ejecuta por deadline mas proximo dentro de su prioridad
+    * @param period     : Periodo de la tarea en ticks - Mayor a 0
+    * @param deadline   : Deadline de cada trabajo en ticks respecto de su activacion - Entre 1 y period,
+                          0 para usar period
+    * @note Ver taskCreate() para el resto de los parametros
+    * @note El primer trabajo se activa en la creacion. Cada trabajo termina con taskWaitForNextPeriod()
+    * @return osReturn_t OS_RESULT_ERROR si la tarea no se puede crear o el periodo o el deadline no son validos,
+              OS_RESULT_OK caso contrario
+    */
+    osReturn_t taskCreatePeriodic(taskFunction_t taskFx, uint32_t priority, uint32_t * stack, uint32_t stackSize,
+                       char * taskName, void * parameters, tick_t period, tick_t deadline, uint8_t * taskId)
+    {
+        if(0 == deadline)
+        {
+            deadline = period;
+        }
+
+        if(0 == period || OS_MAX_DELAY == period || period < deadline)
+        {
+            if(NULL != taskId)
+            {
+                *taskId = OS_INVALID_TASK;
+            }
+            return OS_RESULT_ERROR;
+        }
+
+        return taskCreateInternal(taskFx, priority, stack, stackSize, taskName, parameters, period, deadline, taskId);
+    }
+
+    /**
+    * @fn void taskWaitForNextPeriod(void)
+    * @brief Funcion que termina el trabajo actual de una tarea periodica y la bloquea hasta su proxima activacion
+    * @param  Ninguno
+    * @return Nada
+    * @note Si el trabajo termino despues de su deadline se contabiliza como deadline perdido. Si la proxima
+            activacion ya paso, el siguiente trabajo arranca sin bloquearse - Las activaciones atrasadas no
+            se descartan, la tarea las recupera si tiene tiempo de CPU
+    * @note Las activaciones son multiplos del periodo desde la creacion, por lo que no acumulan atraso
+    * @warning Sin efecto desde tareas no periodicas, la idle task o dentro de una seccion critica
+    */
+    void taskWaitForNextPeriod(void)
+    {
+        uint8_t id = g_Os.currentTask;  /**< Tarea actual */
+        tick_t  now;                    /**< Tick actual */
+
+        if(osIsIdleTask(id) || 0 == g_Os.taskList[id].period || 0 != g_Os.criticalNesting)
+        {
+            return;
+        }
+
+        /* Suspendemos cambio de contexto porque estamos manipulando variables globales */
+        osSuspendContextSwitching();
+
+        now = g_Os.tickCount;
+        /* Terminar en el mismo tick del deadline se considera a tiempo */
+        if(0 < (int32_t)(now - g_Os.taskList[id].absoluteDeadline))
+        {
+            g_Os.taskList[id].deadlineMisses++;
+        }
+
+        /* Calculamos la proxima activacion y su deadline */
+        g_Os.taskList[id].release          += g_Os.taskList[id].period;
+        g_Os.taskList[id].absoluteDeadline  = g_Os.taskList[id].release + g_Os.taskList[id].relativeDeadline;
+
+        if(0 < (int32_t)(g_Os.taskList[id].release - now))
+        {
+            taskBlock(id, g_Os.taskList[id].release - now);
+        }
+
+        osResumeContextSwitching();
+        /* Aun sin bloquearse llamamos al scheduler, ya que el nuevo deadline puede ser posterior
+           al de otra tarea ready */
+        schedule();
+    }
+
+    /**
+    * @fn uint32_t taskGetDeadlineMisses(uint8_t taskId)
+    * @brief Funcion que devuelve la cantidad de trabajos de una tarea periodica que terminaron despues de su deadline
+    * @param  taskId : id de la tarea
+    * @return Cantidad de deadlines perdidos, 0 si la tarea no existe o no es periodica
+    */
+    uint32_t taskGetDeadlineMisses(uint8_t taskId)
+    {
+        return (OS_MAX_TASK > taskId) ? g_Os.taskList[taskId].deadlineMisses : 0;
+    }
+#endif
+
 /**
 * @fn void taskStartScheduler()
 * @brief Funcion que inicializa el scheduler del SO
@@ -429,13 +1356,27 @@ void taskStartScheduler()
     /* So se usa el delay, se inicializa el stack de la idle task */
     #if ( OS_USE_TASK_DELAY == 1 )
         /* Creacion idle task */
-        initStack(g_Os.idleTaskStack, OS_IDLE_STACK_SIZE, OS_NULL_PRIORITY, idleHook, "IdleTask", (void*)0);
+        initStack(OS_IDLE_TASK, g_Os.idleTaskStack, OS_IDLE_STACK_SIZE, OS_NULL_PRIORITY, idleHook, "IdleTask", (void*)0);
+        g_Os.taskList[OS_IDLE_TASK].state = TASK_STATE_READY;
     #endif
 
-    /* Se agregan todas las tareas */
+    #if ( OS_USE_TIMER == 1 )
+        /* Creacion de la tarea de timers */
+        timerServiceInit();
+    #endif
+
+    #if ( OS_USE_IRQ_DEFER == 1 )
+        /* Creacion de la tarea de trabajos diferidos */
+        irqDeferServiceInit();
+    #endif
+
+    /* Se agregan todas las tareas, salvo las borradas o suspendidas antes del arranque */
     for(p = 0; p < g_Os.maxTask; p++)
     {
-        addReadyTask(p, g_Os.taskList[p].priority - 1);
+        if(TASK_STATE_READY == g_Os.taskList[p].state)
+        {
+            addReadyTask(p, g_Os.taskList[p].priority - 1);
+        }
     }
     /* Se inicializan los punteros a primera tarea ready */
     for(p = 0; p < OS_MAX_TASK_PRIORITY; p++)
@@ -443,10 +1384,25 @@ void taskStartScheduler()
         g_Os.readyTaskInfo[p].firstReadyTask = 0;
     }
 
-    /* Systick y pendSV con menor prioridad posible */
-    NVIC_SetPriority(PendSV_IRQn, (1 << __NVIC_PRIO_BITS) - 1);
+    #if ( OS_USE_TASK_STATS == 1 )
+        /* Los ciclos se contabilizan desde el arranque del scheduler */
+        osPortCycleCounterInit();
+        g_Os.statsMark = OS_PORT_CYCLE_COUNT();
+    #endif
+
+    #if ( OS_USE_MPU_STACK_GUARD == 1 )
+        /* La guarda de cada stack se programa en el cambio de contexto */
+        osPortStackGuardInit();
+    #endif
+
+    /* PendSV con menor prioridad posible y tick del sistema */
+    osPortStartTick(OS_TICK_RATE_HZ);
 
-    SysTick_Config(SystemCoreClock / 1000);
+    #if ( OS_USE_TICKLESS_IDLE == 1 )
+        /* Cuentas del SysTick por tick y maximos ticks representables en su registro de recarga de 24 bits */
+        g_Os.ticksPerTick       = SystemCoreClock / OS_TICK_RATE_HZ;
+        g_Os.maxSuppressedTicks = SysTick_LOAD_RELOAD_Msk / g_Os.ticksPerTick;
+    #endif
 
     /* Se setea la interrupcion de pendSV */
     schedule();
@@ -466,24 +1422,30 @@ void taskStartScheduler()
 */
 int32_t taskSchedule(int32_t currentContext)
 {
-    uint8_t p;  /** Variable para recorrer la lista de prioridades */
-    
-    if(g_Os.maxTask == g_Os.currentTask)
+    #if ( OS_USE_TASK_STATS == 1 )
+        uint8_t prevTask = g_Os.currentTask;    /**< Tarea saliente */
+
+        /* Contabilizamos a la tarea saliente lo que ejecuto desde la ultima contabilizacion */
+        statsChargeCurrentTask();
+    #endif
+
+    if(osIsIdleTask(g_Os.currentTask))
     {
         /* Aca se entra si volvemos de la idle task */
         #if ( OS_USE_TASK_DELAY == 1 )
             /* Guardamos el contexto de la idle task */
-            g_Os.taskList[g_Os.maxTask].stackPointer  = currentContext; 
+            g_Os.taskList[OS_IDLE_TASK].stackPointer  = currentContext; 
             /* Si bien no es necesario cambiarle el estado a la idle task
              porque solo puede tener dos estados posibles lo hacemos para 
              mantener coherencia con el resto de las tareas */
-            g_Os.taskList[g_Os.maxTask].state         = TASK_STATE_READY;
+            g_Os.taskList[OS_IDLE_TASK].state         = TASK_STATE_READY;
             
         #endif  
     }
-    else
+    else if(OS_INVALID_TASK != g_Os.currentTask)
     {
-        /* Aca se entra si volvemos de cualquiera de las otras tareas del sistema */
+        /* Aca se entra si volvemos de cualquiera de las otras tareas del sistema.
+           En el primer schedule no hay tarea actual y el contexto es el de main() */
         /* Guardamos el contexto de la tarea actual */
         g_Os.taskList[g_Os.currentTask].stackPointer  = currentContext;
         /* Podemos haber entrado al schedule por culpa de un taskDelay */
@@ -496,34 +1458,47 @@ int32_t taskSchedule(int32_t currentContext)
         }
         
     }
+
+    #if ( OS_USE_RING == 1 )
+        /* Despertamos las tareas solicitadas desde IRQs sin deshabilitar interrupciones */
+        deferredWakeUpdate();
+    #endif
+
     /* Si el SO esta corriendo, hacemos el cambio de contexto */
     if(OS_STATE_RUNNING == g_Os.state)
     {
-        /* Por cada prioridad - IMPORTANTE: Mayor prioridad == Menor numero */
-        for(p = 0; p < OS_MAX_TASK_PRIORITY; p++)
+        /* Si hay al menos una prioridad con tareas ready */
+        if(0 != g_Os.readyPrioBitmap)
         {
-            /* Si hay tareas ready en la prioridad */
-            if(g_Os.readyTaskInfo[p].readyTaskCnt > 0)
-            {
-                /* Removemos siempre la primera tarea ready */
-                removeReadyTask(&g_Os.currentTask, p);
-                /* Frenamos la busqueda de tareas ready */
-                break; 
-            }
+            /* La prioridad ready mas alta es la cantidad de ceros a izquierda del bitmap
+               IMPORTANTE: Mayor prioridad == Menor numero == Bit mas significativo */
+            /* Removemos siempre la primera tarea ready */
+            removeReadyTask(&g_Os.currentTask, __CLZ(g_Os.readyPrioBitmap));
         }
-
         #if ( OS_USE_TASK_DELAY == 1 )
-            /* Si salimos del for sin encontrar una tarea ready */
-            if(p >= OS_MAX_TASK_PRIORITY)
+            /* Si no hay ninguna tarea ready */
+            else
             {
                 /* Seteamos como tarea actual a la idle task */
                 /* Recordar que guardamos su informacion en el ultimo elemento de la lista de tareas */
-                g_Os.currentTask = g_Os.maxTask;
+                g_Os.currentTask = OS_IDLE_TASK;
             }
         #endif
         
         /* Seteamos el estado de la tarea a ejecutarse como corriendo */
         g_Os.taskList[g_Os.currentTask].state  = TASK_STATE_RUNNING;
+
+        #if ( OS_USE_TASK_STATS == 1 )
+            if(prevTask != g_Os.currentTask)
+            {
+                g_Os.taskList[g_Os.currentTask].switchCount++;
+            }
+        #endif
+
+        #if ( OS_USE_MPU_STACK_GUARD == 1 )
+            /* Movemos la guarda del MPU a la base del stack de la tarea entrante */
+            osPortStackGuardSet(g_Os.taskList[g_Os.currentTask].stack);
+        #endif
         
     }
     /* Retornamos su contexto */
@@ -540,11 +1515,14 @@ int32_t taskSchedule(int32_t currentContext)
     */
     void taskDelay(tick_t ticksToDelay)
     {
-        /* Si el delay es mayor a 0 y la tarea que llama a taskDelay NO es la idle task */
-        if(0 < ticksToDelay && OS_IDLE_TASK != g_Os.currentTask)
+        /* Si el delay es mayor a 0, la tarea que llama a taskDelay NO es la idle task
+           y no se llama dentro de una seccion critica */
+        if(0 < ticksToDelay && !osIsIdleTask(g_Os.currentTask) && 0 == g_Os.criticalNesting)
         {
-            g_Os.taskList[g_Os.currentTask].state = TASK_STATE_BLOCKED;
-            g_Os.taskList[g_Os.currentTask].ticksToWait = ticksToDelay; 
+            /* Suspendemos cambio de contexto porque estamos manipulando variables globales */
+            osSuspendContextSwitching();
+            taskBlock(g_Os.currentTask, ticksToDelay);
+            osResumeContextSwitching();
             schedule();
         }
         
@@ -562,6 +1540,28 @@ tick_t taskGetTickCount()
     return g_Os.tickCount;
 }
 
+/**
+* @fn tick_t taskRemainingDelay(tick_t start, tick_t delay)
+* @brief Funcion que calcula cuanto resta esperar de un delay que comenzo en el tick start
+* @param  start : Tick en el que comenzo la espera
+* @param  delay : Tiempo total a esperar
+* @return Ticks restantes, 0 si el delay ya vencio. OS_MAX_DELAY no vence nunca
+* @note Permite que las funciones que reintentan una espera no superen delay en total
+*/
+tick_t taskRemainingDelay(tick_t start, tick_t delay)
+{
+    tick_t elapsed;     /**< Ticks transcurridos desde start */
+
+    if(OS_MAX_DELAY == delay)
+    {
+        return OS_MAX_DELAY;
+    }
+
+    elapsed = taskGetTickCount() - start;
+
+    return (elapsed < delay) ? delay - elapsed : 0;
+}
+
 /**
 * @fn uint32_t taskYield()
 * @brief Funcion que cede el procesador a otra tarea
@@ -576,65 +1576,1004 @@ void taskYield()
   
 }
 
-#if ( OS_USE_SEMPHR == 1 )
-    /**
-    * @fn void taskUnsuspendWithinAPI(uint8_t taskId)
-    * @brief Funcion que desbloquea una tarea
-    * @param  taskId : id de la tarea a desbloquear
-    * @return Nada
-    * @warning NO DEBE SER USADA POR EL USUARIO
-    */
-    void taskUnsuspendWithinAPI(uint8_t taskId)
-    {
-        g_Os.taskList[taskId].ticksToWait = 0;
-        g_Os.taskList[taskId].state = TASK_STATE_READY;
-        addReadyTask(taskId, g_Os.taskList[taskId].priority - 1);
-    }
-#endif
 /**
-* @fn void osSuspendContextSwitching()
-* @brief Funcion que suspende el context switch
+* @fn void taskYieldFromISR()
+* @brief Funcion que deja pendiente el cambio de contexto desde una IRQ
 * @param  Ninguno
 * @return Nada
+* @note El cambio de contexto se ejecuta al salir de la IRQ, ya que la pendSV tiene 
+        la menor prioridad del sistema
 */
-void osSuspendContextSwitching()
+void taskYieldFromISR()
 {
-    g_Os.state = OS_STATE_SUSPENDED;
-    __disable_irq();
+    OS_PORT_PEND_SWITCH_FROM_ISR();
 }
 
-/**
-* @fn void osResumeContextSwitching()
-* @brief Funcion que resume el context switch
-* @param  Ninguno
-* @return Nada
-*/
-void osResumeContextSwitching()
-{
-    g_Os.state = OS_STATE_RUNNING;
-    __enable_irq();
-}
+#if ( OS_USE_DYNAMIC_TASKS == 1 )
+    /**
+    * @fn osReturn_t taskDelete(uint8_t taskId)
+    * @brief Funcion que borra una tarea y libera su lugar en la lista de tareas
+    * @param  taskId : id de la tarea, osGetCurrentTask() para borrar la tarea actual
+    * @return OS_RESULT_ERROR si la tarea no existe, es la idle task o tiene mutex tomados,
+              o si la tarea actual se borra a si misma dentro de una seccion critica.
+              OS_RESULT_OK caso contrario - Si la tarea se borra a si misma NO retorna
+    * @note El stack se devuelve con taskReapHook(). Si la tarea se borra a si misma, como sigue
+            corriendo sobre el, lo devuelve la idle task o el proximo taskCreate()
+    */
+    osReturn_t taskDelete(uint8_t taskId)
+    {
+        osReturn_t retVal = OS_RESULT_ERROR;
+        uint32_t * stack = NULL;    /**< Stack a devolver */
+        uint32_t   stackSize;       /**< Tamaño del stack a devolver */
 
-/**
-* @fn void osGetCurrentTask()
-* @brief Funcion que devuelve la tarea en ejecucion
-* @param  Ninguno
-* @return Id de la tarea en ejecucion
-*/
-uint8_t osGetCurrentTask()
-{
-    return g_Os.currentTask;
-}
+        if(OS_MAX_TASK > taskId && (g_Os.currentTask != taskId || 0 == g_Os.criticalNesting))
+        {
+            osSuspendContextSwitching();
 
-/**
-* @fn vuint8_t osIsIdleTask(uint8_t taskId)
+            if(TASK_STATE_TERMINATED != g_Os.taskList[taskId].state && TASK_STATE_DELETED != g_Os.taskList[taskId].state
+            #if ( OS_USE_MUTEX == 1 )
+                /* Borrarla con mutex tomados dejaria a las tareas que los esperan bloqueadas para siempre */
+                && 0 == g_Os.taskList[taskId].mutexHeld
+            #endif
+            )
+            {
+                taskDetach(taskId);
+
+                if(g_Os.currentTask == taskId)
+                {
+                    g_Os.taskList[taskId].state = TASK_STATE_DELETED;
+                    g_Os.deletedCount++;
+                }
+                else
+                {
+                    stack     = g_Os.taskList[taskId].stack;
+                    stackSize = g_Os.taskList[taskId].stackSize;
+                    g_Os.taskList[taskId].state = TASK_STATE_TERMINATED;
+                }
+
+                retVal = OS_RESULT_OK;
+            }
+
+            osResumeContextSwitching();
+
+            if(NULL != stack)
+            {
+                taskReapHook(stack, stackSize);
+            }
+            else if(OS_RESULT_OK == retVal)
+            {
+                /* La tarea se borro a si misma, el scheduler no la vuelve a ejecutar */
+                schedule();
+            }
+        }
+
+        return retVal;
+    }
+
+    /**
+    * @fn osReturn_t taskSuspend(uint8_t taskId)
+    * @brief Funcion que suspende una tarea hasta que se llame a taskResume()
+    * @param  taskId : id de la tarea, osGetCurrentTask() para suspender la tarea actual
+    * @return OS_RESULT_ERROR si la tarea no existe, es la idle task o ya estaba suspendida, OS_RESULT_OK caso contrario
+    * @note Si la tarea estaba bloqueada deja de esperar: al reanudarse su llamada bloqueante retorna OS_RESULT_ERROR
+    */
+    osReturn_t taskSuspend(uint8_t taskId)
+    {
+        osReturn_t retVal = OS_RESULT_ERROR;
+
+        if(OS_MAX_TASK > taskId)
+        {
+            osSuspendContextSwitching();
+
+            if(TASK_STATE_READY == g_Os.taskList[taskId].state || TASK_STATE_RUNNING == g_Os.taskList[taskId].state ||
+               TASK_STATE_BLOCKED == g_Os.taskList[taskId].state)
+            {
+                taskDetach(taskId);
+                g_Os.taskList[taskId].state = TASK_STATE_SUSPENDED;
+                retVal = OS_RESULT_OK;
+            }
+
+            osResumeContextSwitching();
+
+            if(OS_RESULT_OK == retVal && g_Os.currentTask == taskId)
+            {
+                /* La tarea se suspendio a si misma */
+                schedule();
+            }
+        }
+
+        return retVal;
+    }
+
+    /**
+    * @fn osReturn_t taskResume(uint8_t taskId)
+    * @brief Funcion que reanuda una tarea suspendida con taskSuspend()
+    * @param  taskId : id de la tarea
+    * @return OS_RESULT_ERROR si la tarea no estaba suspendida, OS_RESULT_OK caso contrario
+    */
+    osReturn_t taskResume(uint8_t taskId)
+    {
+        osReturn_t retVal = OS_RESULT_ERROR;
+
+        if(OS_MAX_TASK > taskId)
+        {
+            osSuspendContextSwitching();
+
+            if(TASK_STATE_SUSPENDED == g_Os.taskList[taskId].state)
+            {
+                g_Os.taskList[taskId].state = TASK_STATE_READY;
+                addReadyTask(taskId, g_Os.taskList[taskId].priority - 1);
+                retVal = OS_RESULT_OK;
+            }
+
+            osResumeContextSwitching();
+
+            if(OS_RESULT_OK == retVal)
+            {
+                /* Llamamos al scheduler por si la tarea reanudada es de mayor prioridad */
+                schedule();
+            }
+        }
+
+        return retVal;
+    }
+#endif
+
+#if ( OS_USE_TASK_DELAY == 1 )
+    /**
+    * @fn void taskUnsuspendWithinAPI(uint8_t taskId)
+    * @brief Funcion que desbloquea una tarea
+    * @param  taskId : id de la tarea a desbloquear
+    * @return Nada
+    * @warning NO DEBE SER USADA POR EL USUARIO
+    */
+    void taskUnsuspendWithinAPI(uint8_t taskId)
+    {
+        /* Si la tarea esperaba con timeout la sacamos de la lista de tareas demoradas */
+        if(OS_DELAY_LIST_CONTAINS(taskId))
+        {
+            delayListRemove(taskId);
+        }
+        /* Si la tarea esperaba un objeto del SO la sacamos de su lista de espera */
+        if(NULL != g_Os.taskList[taskId].waitList)
+        {
+            waitListRemove(g_Os.taskList[taskId].waitList, taskId);
+        }
+        g_Os.taskList[taskId].ticksToWait = 0;
+        g_Os.taskList[taskId].state = TASK_STATE_READY;
+        addReadyTask(taskId, g_Os.taskList[taskId].priority - 1);
+    }
+#endif
+
+#if ( OS_USE_TASK_DELAY == 1 )
+    /**
+    * @fn void waitListInit(waitList_t * list)
+    * @brief Funcion que inicializa una lista de espera vacia
+    * @param  list : Lista de espera a inicializar
+    * @return Nada
+    * @warning NO DEBE SER USADA POR EL USUARIO
+    */
+    void waitListInit(waitList_t * list)
+    {
+        list->head = OS_INVALID_TASK;
+    }
+
+    /**
+    * @fn osReturn_t taskBlockOnWaitList(waitList_t * list, tick_t ticksToWait)
+    * @brief Funcion que bloquea la tarea actual en una lista de espera
+    * @param  list        : Lista de espera en la que se bloquea la tarea
+    * @param  ticksToWait : Ticks maximos a esperar, OS_MAX_DELAY para esperar por siempre
+    * @return OS_RESULT_OK si la tarea fue despertada por taskWakeFromWaitList(),
+              OS_RESULT_ERROR si expiro el timeout, si ticksToWait es 0 o si la llama la idle task
+    * @note La tarea se inserta detras de las tareas de igual o mayor prioridad
+    * @warning Debe ser llamada con el cambio de contexto suspendido y retorna con el mismo suspendido.
+               Mientras la tarea esta bloqueada el cambio de contexto se reanuda.
+    * @warning NO DEBE SER USADA POR EL USUARIO
+    */
+    osReturn_t taskBlockOnWaitList(waitList_t * list, tick_t ticksToWait)
+    {
+        uint8_t   id = g_Os.currentTask;    /**< Tarea a bloquear */
+
+        /* Sin tiempo de espera, desde la idle task o dentro de secciones criticas anidadas no se bloquea */
+        if(0 == ticksToWait || osIsIdleTask(id) || 1 != g_Os.criticalNesting)
+        {
+            return OS_RESULT_ERROR;
+        }
+
+        waitListInsert(list, id);
+        g_Os.taskList[id].waitResult = OS_RESULT_ERROR;
+        taskBlock(id, ticksToWait);
+
+        /* Volvemos a permitir el cambio de contexto y llamamos al scheduler */
+        osResumeContextSwitching();
+        schedule();
+        /* Volvemos al ser despertados o al expirar el timeout */
+        osSuspendContextSwitching();
+
+        return g_Os.taskList[id].waitResult;
+    }
+
+    /**
+    * @fn uint8_t taskWakeFromWaitList(waitList_t * list)
+    * @brief Funcion que despierta la tarea de mayor prioridad de una lista de espera
+    * @param  list : Lista de espera
+    * @return id de la tarea despertada, OS_INVALID_TASK si no habia tareas a la espera
+    * @warning Debe ser llamada con el cambio de contexto suspendido
+    * @warning NO DEBE SER USADA POR EL USUARIO
+    */
+    uint8_t taskWakeFromWaitList(waitList_t * list)
+    {
+        uint8_t id = list->head;    /**< Tarea a despertar */
+
+        if(OS_INVALID_TASK != id)
+        {
+            taskWakeWaiting(id);
+        }
+
+        return id;
+    }
+
+    /**
+    * @fn uint8_t waitListNext(uint8_t taskId)
+    * @brief Funcion que devuelve la tarea siguiente a una tarea dentro de su lista de espera
+    * @param  taskId : id de la tarea, que debe estar en una lista de espera
+    * @return id de la tarea siguiente, OS_INVALID_TASK si es la ultima de la lista
+    * @note Junto con waitList_t.head permite recorrer una lista de espera por orden de prioridad
+    * @warning Debe ser llamada con el cambio de contexto suspendido
+    * @warning NO DEBE SER USADA POR EL USUARIO
+    */
+    uint8_t waitListNext(uint8_t taskId)
+    {
+        return g_Os.taskList[taskId].waitNext;
+    }
+
+    /**
+    * @fn void taskWakeWaiting(uint8_t taskId)
+    * @brief Funcion que despierta una tarea especifica de la lista de espera en la que esta bloqueada
+    * @param  taskId : id de la tarea a despertar
+    * @return Nada
+    * @note Su llamada bloqueante retorna OS_RESULT_OK
+    * @warning Debe ser llamada con el cambio de contexto suspendido
+    * @warning NO DEBE SER USADA POR EL USUARIO
+    */
+    void taskWakeWaiting(uint8_t taskId)
+    {
+        g_Os.taskList[taskId].waitResult = OS_RESULT_OK;
+        /* La saca de la lista de espera y de la de tareas demoradas y la pone en ready */
+        taskUnsuspendWithinAPI(taskId);
+    }
+#endif
+
+#if ( OS_USE_RING == 1 )
+    /**
+    * @fn osReturn_t taskWaitForDeferredWake(tick_t ticksToWait)
+    * @brief Funcion que bloquea la tarea actual hasta que una IRQ la despierte con taskWakeDeferredFromISR()
+    * @param  ticksToWait : Ticks maximos a esperar, OS_MAX_DELAY para esperar por siempre
+    * @return OS_RESULT_OK si la tarea fue despertada, 
+              OS_RESULT_ERROR si expiro el timeout, si ticksToWait es 0 o si la llama la idle task
+    * @warning Debe ser llamada con el cambio de contexto suspendido y retorna con el mismo suspendido.
+               Mientras la tarea esta bloqueada el cambio de contexto se reanuda.
+    * @warning NO DEBE SER USADA POR EL USUARIO
+    */
+    osReturn_t taskWaitForDeferredWake(tick_t ticksToWait)
+    {
+        uint8_t id = g_Os.currentTask;    /**< Tarea a bloquear */
+
+        /* Sin tiempo de espera, desde la idle task o dentro de secciones criticas anidadas no se bloquea */
+        if(0 == ticksToWait || osIsIdleTask(id) || 1 != g_Os.criticalNesting)
+        {
+            return OS_RESULT_ERROR;
+        }
+
+        g_Os.taskList[id].waitResult = OS_RESULT_ERROR;
+        g_Os.taskList[id].deferredWakeable = 1;
+        taskBlock(id, ticksToWait);
+
+        /* Volvemos a permitir el cambio de contexto y llamamos al scheduler */
+        osResumeContextSwitching();
+        schedule();
+        /* Volvemos al ser despertados o al expirar el timeout */
+        osSuspendContextSwitching();
+
+        g_Os.taskList[id].deferredWakeable = 0;
+
+        return g_Os.taskList[id].waitResult;
+    }
+
+    /**
+    * @fn void taskWakeDeferredFromISR(uint8_t taskId)
+    * @brief Funcion que solicita despertar una tarea bloqueada en taskWaitForDeferredWake()
+    * @param  taskId : id de la tarea a despertar
+    * @return Nada
+    * @note No deshabilita interrupciones: registra la solicitud con un acceso exclusivo(LDREX/STREX)
+            y deja pendiente la pendSV, donde el scheduler despierta a la tarea
+    * @note Puede ser llamada desde IRQs o desde tareas
+    */
+    void taskWakeDeferredFromISR(uint8_t taskId)
+    {
+        volatile uint32_t * word = &(g_Os.deferredWake[taskId / 32]);  /**< Palabra del bitmap de la tarea */
+
+        do
+        {
+            /* Nada */
+        }while(0 != __STREXW(__LDREXW(word) | (1UL << (taskId & 31)), word));
+
+        taskYieldFromISR();
+    }
+
+    /**
+    * @fn osReturn_t osReserveSlot(volatile uint32_t * head, const volatile uint32_t * tail, uint32_t mask,
+                                   volatile uint32_t * dropped, uint32_t * slot)
+    * @brief Funcion que reserva un lugar de una cola de varios productores
+    * @param  head    : Indice de escritura
+    * @param  tail    : Indice de lectura
+    * @param  mask    : Largo de la cola - 1, el largo es potencia de 2
+    * @param  dropped : Contador de descartes por cola llena
+    * @param  slot    : Indice reservado
+    * @return OS_RESULT_ERROR si la cola esta llena, OS_RESULT_OK caso contrario
+    * @note No deshabilita interrupciones: si una IRQ anidada reserva otro lugar en el medio, el STREX falla
+            y se reintenta. El productor publica el lugar con osPublishAndWake() al terminar de escribirlo
+    * @note Puede ser llamada desde IRQs o desde tareas
+    * @warning NO DEBE SER USADA POR EL USUARIO
+    */
+    osReturn_t osReserveSlot(volatile uint32_t * head, const volatile uint32_t * tail, uint32_t mask,
+                             volatile uint32_t * dropped, uint32_t * slot)
+    {
+        uint32_t index;     /**< Indice a reservar */
+
+        do
+        {
+            index = __LDREXW(head);
+            /* Si la cola esta llena */
+            if(index - *tail > mask)
+            {
+                __CLREX();
+                /* El contador tambien puede ser incrementado por una IRQ anidada */
+                do
+                {
+                    index = __LDREXW(dropped);
+                }while(0 != __STREXW(index + 1, dropped));
+                return OS_RESULT_ERROR;
+            }
+        }while(0 != __STREXW(index + 1, head));
+
+        *slot = index;
+
+        return OS_RESULT_OK;
+    }
+
+    /**
+    * @fn void osPublishAndWake(volatile uint32_t * marker, uint32_t value, const volatile uint8_t * waiting)
+    * @brief Funcion que publica lo escrito por un productor y despierta al consumidor si espera
+    * @param  marker  : Marca que lee el consumidor, el indice de escritura o la del lugar escrito
+    * @param  value   : Valor de la marca que publica lo escrito
+    * @param  waiting : id del consumidor mientras espera en osWaitForProducer(), OS_INVALID_TASK si no espera
+    * @return Nada
+    * @note El consumidor se despierta en diferido a traves de la pendSV
+    * @note Puede ser llamada desde IRQs o desde tareas
+    * @warning NO DEBE SER USADA POR EL USUARIO
+    */
+    void osPublishAndWake(volatile uint32_t * marker, uint32_t value, const volatile uint8_t * waiting)
+    {
+        uint8_t consumer;   /**< Consumidor a la espera */
+
+        /* Lo escrito debe ser visible antes que la marca */
+        __DMB();
+        *marker = value;
+        /* La marca debe ser visible antes de leer si el consumidor espera */
+        __DMB();
+
+        /* El consumidor solo espera si no vio la marca */
+        consumer = *waiting;
+        if(OS_INVALID_TASK != consumer)
+        {
+            taskWakeDeferredFromISR(consumer);
+        }
+    }
+
+    /**
+    * @fn osReturn_t osWaitForProducer(volatile uint8_t * waiting, osReadyFunction_t isReady, const void * arg,
+                                       tick_t delay)
+    * @brief Funcion que bloquea al consumidor hasta que un productor publique datos con osPublishAndWake()
+    * @param  waiting : id del consumidor mientras espera, lo lee osPublishAndWake()
+    * @param  isReady : Funcion que evalua si hay datos listos
+    * @param  arg     : Argumento de isReady
+    * @param  delay   : Tiempo a esperar a que haya datos listos
+    * @return OS_RESULT_OK si hay datos listos, OS_RESULT_ERROR si expira el delay
+    * @note Un unico consumidor por cada waiting
+    * @warning NO DEBE SER USADA POR EL USUARIO
+    * @danger Desde IRQ o Idle Task con delay 0
+    */
+    osReturn_t osWaitForProducer(volatile uint8_t * waiting, osReadyFunction_t isReady, const void * arg, tick_t delay)
+    {
+        osReturn_t retVal = OS_RESULT_OK;
+
+        while(OS_RESULT_OK == retVal && !isReady(arg))
+        {
+            osSuspendContextSwitching();
+            /* Avisamos que esperamos y volvemos a verificar, por si un productor
+               publico datos sin ver el aviso */
+            *waiting = osGetCurrentTask();
+            __DMB();
+            if(!isReady(arg))
+            {
+                retVal = taskWaitForDeferredWake(delay);
+            }
+            *waiting = OS_INVALID_TASK;
+            osResumeContextSwitching();
+        }
+
+        return retVal;
+    }
+#endif
+
+#if ( OS_USE_TASK_NOTIFY == 1 )
+    /**
+    * @fn osReturn_t taskNotify(uint8_t taskId, uint32_t value, notifyAction_t action)
+    * @brief Funcion que notifica a una tarea
+    * @param  taskId : id de la tarea destino
+    * @param  value  : Valor de la notificacion, no se usa con NOTIFY_ACTION_INCREMENT ni NOTIFY_ACTION_NONE
+    * @param  action : Accion a realizar sobre la palabra de notificacion de la tarea destino
+    * @return OS_RESULT_ERROR si la tarea no existe o es la idle task, OS_RESULT_OK caso contrario
+    * @note Si la tarea no esta esperando, la notificacion queda pendiente hasta su proxima espera
+    */
+    osReturn_t taskNotify(uint8_t taskId, uint32_t value, notifyAction_t action)
+    {
+        osReturn_t retVal = OS_RESULT_ERROR;
+        uint8_t    woken = 0;   /**< Indica si se desperto a la tarea */
+
+        if(OS_MAX_TASK > taskId)
+        {
+            /* Suspendemos cambio de contexto porque estamos manipulando variables globales */
+            osSuspendContextSwitching();
+
+            if(TASK_STATE_TERMINATED != g_Os.taskList[taskId].state && TASK_STATE_DELETED != g_Os.taskList[taskId].state)
+            {
+                woken = taskNotifyUpdate(taskId, value, action);
+                retVal = OS_RESULT_OK;
+            }
+
+            /* Volvemos a permitir el cambio de contexto */
+            osResumeContextSwitching();
+
+            if(woken)
+            {
+                /* Llamamos al scheduler por si la tarea despertada es de mayor prioridad */
+                schedule();
+            }
+        }
+
+        return retVal;
+    }
+
+    /**
+    * @fn osReturn_t taskNotifyFromISR(uint8_t taskId, uint32_t value, notifyAction_t action)
+    * @brief Funcion que notifica a una tarea desde una IRQ
+    * @param  taskId : id de la tarea destino
+    * @param  value  : Valor de la notificacion, no se usa con NOTIFY_ACTION_INCREMENT ni NOTIFY_ACTION_NONE
+    * @param  action : Accion a realizar sobre la palabra de notificacion de la tarea destino
+    * @return OS_RESULT_ERROR si la tarea no existe o es la idle task, OS_RESULT_OK caso contrario
+    * @note Nunca llama al scheduler dentro de la IRQ: si despierta a la tarea solo deja
+            pendiente el cambio de contexto para la salida de la IRQ
+    */
+    osReturn_t taskNotifyFromISR(uint8_t taskId, uint32_t value, notifyAction_t action)
+    {
+        osReturn_t retVal = OS_RESULT_ERROR;
+        uint8_t    woken = 0;   /**< Indica si se desperto a la tarea */
+        uint32_t   mask;
+
+        if(OS_MAX_TASK > taskId)
+        {
+            /* Suspendemos cambio de contexto porque estamos manipulando variables globales */
+            mask = osSuspendContextSwitchingFromISR();
+
+            if(TASK_STATE_TERMINATED != g_Os.taskList[taskId].state && TASK_STATE_DELETED != g_Os.taskList[taskId].state)
+            {
+                woken = taskNotifyUpdate(taskId, value, action);
+                retVal = OS_RESULT_OK;
+            }
+
+            /* Volvemos a permitir el cambio de contexto */
+            osResumeContextSwitchingFromISR(mask);
+
+            if(woken)
+            {
+                /* Dejamos pendiente el cambio de contexto para la salida de la IRQ */
+                taskYieldFromISR();
+            }
+        }
+
+        return retVal;
+    }
+
+    /**
+    * @fn osReturn_t taskNotifyGive(uint8_t taskId)
+    * @brief Funcion que incrementa la palabra de notificacion de una tarea - Equivalente a semphrGive()
+    * @param  taskId : id de la tarea destino
+    * @return OS_RESULT_ERROR si la tarea no existe o es la idle task, OS_RESULT_OK caso contrario
+    * @note La tarea destino la recibe con taskNotifyTake()
+    */
+    osReturn_t taskNotifyGive(uint8_t taskId)
+    {
+        return taskNotify(taskId, 0, NOTIFY_ACTION_INCREMENT);
+    }
+
+    /**
+    * @fn osReturn_t taskNotifyGiveFromISR(uint8_t taskId)
+    * @brief Funcion que incrementa la palabra de notificacion de una tarea desde una IRQ - Equivalente a semphrGiveFromISR()
+    * @param  taskId : id de la tarea destino
+    * @return OS_RESULT_ERROR si la tarea no existe o es la idle task, OS_RESULT_OK caso contrario
+    */
+    osReturn_t taskNotifyGiveFromISR(uint8_t taskId)
+    {
+        return taskNotifyFromISR(taskId, 0, NOTIFY_ACTION_INCREMENT);
+    }
+
+    /**
+    * @fn uint32_t taskNotifyTake(uint8_t clearOnExit, tick_t ticksToWait)
+    * @brief Funcion que espera que la palabra de notificacion de la tarea actual sea distinta de 0 - Equivalente a semphrTake()
+    * @param  clearOnExit : Si es distinto de 0 la palabra se limpia al retornar (semaforo binario),
+                            si es 0 se decrementa en 1 (semaforo contador)
+    * @param  ticksToWait : Ticks maximos a esperar, OS_MAX_DELAY para esperar por siempre
+    * @return Valor de la palabra de notificacion antes de limpiarla o decrementarla, 0 si expiro el timeout
+    * @danger Desde IRQ o Idle Task con ticksToWait 0
+    */
+    uint32_t taskNotifyTake(uint8_t clearOnExit, tick_t ticksToWait)
+    {
+        uint8_t  id = g_Os.currentTask;     /**< Tarea actual */
+        uint32_t value;                     /**< Palabra de notificacion */
+
+        /* Suspendemos cambio de contexto porque estamos manipulando variables globales */
+        osSuspendContextSwitching();
+
+        if(0 == g_Os.taskList[id].notifyValue)
+        {
+            taskNotifyBlock(id, ticksToWait);
+        }
+
+        value = g_Os.taskList[id].notifyValue;
+        if(0 != value)
+        {
+            g_Os.taskList[id].notifyValue = clearOnExit ? 0 : value - 1;
+        }
+        g_Os.taskList[id].notifyState = NOTIFY_STATE_NONE;
+
+        /* Volvemos a permitir el cambio de contexto */
+        osResumeContextSwitching();
+
+        return value;
+    }
+
+    /**
+    * @fn osReturn_t taskNotifyWait(uint32_t clearOnEntry, uint32_t clearOnExit, uint32_t * value, tick_t ticksToWait)
+    * @brief Funcion que espera una notificacion de la tarea actual
+    * @param  clearOnEntry : Bits de la palabra de notificacion a limpiar antes de esperar, si no habia
+                             una notificacion pendiente
+    * @param  clearOnExit  : Bits de la palabra de notificacion a limpiar al recibir la notificacion
+    * @param  value        : Donde se guarda la palabra de notificacion antes de limpiar clearOnExit. Puede ser NULL
+    * @param  ticksToWait  : Ticks maximos a esperar, OS_MAX_DELAY para esperar por siempre
+    * @return OS_RESULT_OK si se recibio una notificacion, OS_RESULT_ERROR si expiro el timeout
+    * @danger Desde IRQ o Idle Task con ticksToWait 0
+    */
+    osReturn_t taskNotifyWait(uint32_t clearOnEntry, uint32_t clearOnExit, uint32_t * value, tick_t ticksToWait)
+    {
+        osReturn_t retVal = OS_RESULT_ERROR;
+        uint8_t    id = g_Os.currentTask;   /**< Tarea actual */
+
+        /* Suspendemos cambio de contexto porque estamos manipulando variables globales */
+        osSuspendContextSwitching();
+
+        if(NOTIFY_STATE_PENDING != g_Os.taskList[id].notifyState)
+        {
+            g_Os.taskList[id].notifyValue &= ~clearOnEntry;
+            taskNotifyBlock(id, ticksToWait);
+        }
+
+        if(NULL != value)
+        {
+            *value = g_Os.taskList[id].notifyValue;
+        }
+
+        /* Aunque haya expirado el timeout, la notificacion pudo llegar antes de que la tarea vuelva a ejecutarse */
+        if(NOTIFY_STATE_PENDING == g_Os.taskList[id].notifyState)
+        {
+            g_Os.taskList[id].notifyValue &= ~clearOnExit;
+            retVal = OS_RESULT_OK;
+        }
+        g_Os.taskList[id].notifyState = NOTIFY_STATE_NONE;
+
+        /* Volvemos a permitir el cambio de contexto */
+        osResumeContextSwitching();
+
+        return retVal;
+    }
+#endif
+
+#if ( OS_USE_MUTEX == 1 )
+    /**
+    * @fn uint32_t taskGetPriority(uint8_t taskId)
+    * @brief Funcion que devuelve la prioridad efectiva de una tarea
+    * @param  taskId : id de la tarea
+    * @return Prioridad de la tarea, incluyendo la heredada
+    */
+    uint32_t taskGetPriority(uint8_t taskId)
+    {
+        return g_Os.taskList[taskId].priority;
+    }
+
+    /**
+    * @fn void taskPriorityInherit(uint8_t taskId, uint32_t priority)
+    * @brief Funcion que eleva la prioridad de una tarea a la de otra tarea que espera por ella
+    * @param  taskId   : id de la tarea cuya prioridad se eleva
+    * @param  priority : Prioridad a heredar
+    * @return Nada
+    * @note Si la tarea esta ready o bloqueada en una lista de espera se reubica segun su nueva prioridad
+    * @note La idle task no hereda prioridades
+    * @warning Debe ser llamada con el cambio de contexto suspendido
+    * @warning NO DEBE SER USADA POR EL USUARIO
+    */
+    void taskPriorityInherit(uint8_t taskId, uint32_t priority)
+    {
+        waitList_t * list;  /**< Lista de espera en la que esta bloqueada la tarea */
+
+        /* Solo se hereda una prioridad mayor - Menor numero */
+        if(osIsIdleTask(taskId) || OS_NULL_PRIORITY == priority || g_Os.taskList[taskId].priority <= priority)
+        {
+            return;
+        }
+
+        if(TASK_STATE_READY == g_Os.taskList[taskId].state)
+        {
+            /* La movemos a la lista de tareas ready de su nueva prioridad */
+            removeReadyTaskById(taskId, g_Os.taskList[taskId].priority - 1);
+            g_Os.taskList[taskId].priority = priority;
+            addReadyTask(taskId, priority - 1);
+        }
+        else if(TASK_STATE_BLOCKED == g_Os.taskList[taskId].state && NULL != g_Os.taskList[taskId].waitList)
+        {
+            /* La reubicamos en la lista de espera segun su nueva prioridad */
+            list = g_Os.taskList[taskId].waitList;
+            waitListRemove(list, taskId);
+            g_Os.taskList[taskId].priority = priority;
+            waitListInsert(list, taskId);
+        }
+        else
+        {
+            g_Os.taskList[taskId].priority = priority;
+        }
+    }
+
+    /**
+    * @fn uint8_t taskPriorityDisinherit(uint8_t taskId)
+    * @brief Funcion que registra la liberacion de un mutex y restaura la prioridad original de la tarea
+    * @param  taskId : id de la tarea que libera el mutex - Debe ser la tarea actual
+    * @return true(1) si la tarea recupero su prioridad original y debe llamarse al scheduler, false(0) caso contrario
+    * @note La prioridad original recien se restaura cuando la tarea libera todos los mutex que tiene tomados
+    * @warning Debe ser llamada con el cambio de contexto suspendido
+    * @warning NO DEBE SER USADA POR EL USUARIO
+    */
+    uint8_t taskPriorityDisinherit(uint8_t taskId)
+    {
+        uint8_t retVal = 0;
+
+        if(0 < g_Os.taskList[taskId].mutexHeld)
+        {
+            g_Os.taskList[taskId].mutexHeld--;
+        }
+
+        /* Si ya no tiene mutex tomados y tenia una prioridad heredada, recupera la original.
+           Al ser la tarea actual no esta en ninguna lista */
+        if(0 == g_Os.taskList[taskId].mutexHeld && 
+            g_Os.taskList[taskId].basePriority != g_Os.taskList[taskId].priority)
+        {
+            g_Os.taskList[taskId].priority = g_Os.taskList[taskId].basePriority;
+            retVal = 1;
+        }
+
+        return retVal;
+    }
+
+    /**
+    * @fn void taskIncrementMutexHeldCount(uint8_t taskId)
+    * @brief Funcion que registra que una tarea tomo un mutex
+    * @param  taskId : id de la tarea
+    * @return Nada
+    * @warning NO DEBE SER USADA POR EL USUARIO
+    */
+    void taskIncrementMutexHeldCount(uint8_t taskId)
+    {
+        g_Os.taskList[taskId].mutexHeld++;
+    }
+#endif
+#if ( OS_USE_TICK_PROFILE == 1 )
+    /**
+    * @fn uint32_t osGetTickUpdateCycles(void)
+    * @brief Funcion que obtiene cuanto tardo el ultimo SysTick en actualizar las tareas demoradas
+    * @param  Ninguno
+    * @return Ciclos del contador de ciclos - En el port de host son nanosegundos
+    * @note No incluye el scheduler ni la entrada y salida de la IRQ
+    */
+    uint32_t osGetTickUpdateCycles(void)
+    {
+        return g_Os.tickUpdateCycles;
+    }
+
+    /**
+    * @fn uint32_t osGetTickCycles(void)
+    * @brief Funcion que obtiene cuanto tardo el ultimo SysTick
+    * @param  Ninguno
+    * @return Ciclos del contador de ciclos - En el port de host son nanosegundos
+    * @note Incluye la contabilizacion de OS_USE_TASK_STATS, la actualizacion de las tareas demoradas y
+            el scheduler, pero no la entrada y salida de la IRQ por hardware
+    */
+    uint32_t osGetTickCycles(void)
+    {
+        return g_Os.tickCycles;
+    }
+#endif
+#if ( OS_USE_TASK_STATS == 1 )
+    /**
+    * @fn void osIsrEnter(void)
+    * @brief Funcion que registra la entrada a una IRQ, para no contabilizar su tiempo a la tarea interrumpida
+    * @param  Ninguno
+    * @return Nada
+    * @note Solo la IRQ mas externa contabiliza, las IRQs anidadas se suman a la que interrumpen
+    * @warning NO DEBE SER USADA POR EL USUARIO - La llaman el SysTick y las IRQs adjuntadas con irqAttach()
+    */
+    void osIsrEnter(void)
+    {
+        uint32_t mask = osSuspendContextSwitchingFromISR();
+
+        if(0 == g_Os.isrNesting++)
+        {
+            statsChargeCurrentTask();
+        }
+        osResumeContextSwitchingFromISR(mask);
+    }
+
+    /**
+    * @fn void osIsrExit(void)
+    * @brief Funcion que registra la salida de una IRQ y le contabiliza el tiempo transcurrido
+    * @param  Ninguno
+    * @return Nada
+    * @warning NO DEBE SER USADA POR EL USUARIO - La llaman el SysTick y las IRQs adjuntadas con irqAttach()
+    */
+    void osIsrExit(void)
+    {
+        uint32_t mask = osSuspendContextSwitchingFromISR();
+
+        if(0 == --g_Os.isrNesting)
+        {
+            statsCharge(&g_Os.isrCycles);
+        }
+        osResumeContextSwitchingFromISR(mask);
+    }
+
+    /**
+    * @fn uint8_t osGetTaskStats(taskStats_t * stats, uint8_t len, uint64_t * isrCycles)
+    * @brief Funcion que obtiene las estadisticas de uso de CPU de todas las tareas
+    * @param  stats     : Arreglo donde se guardan las estadisticas, en orden de id de tarea y la idle task al final
+    * @param  len       : Largo del arreglo
+    * @param  isrCycles : Donde se guardan los ciclos ejecutados en IRQs, puede ser NULL
+    * @return Cantidad de elementos de stats completados
+    * @note Los ciclos son acumulados desde el arranque del scheduler. En el port de host son nanosegundos
+    */
+    uint8_t osGetTaskStats(taskStats_t * stats, uint8_t len, uint64_t * isrCycles)
+    {
+        uint8_t n = 0;  /**< Elementos de stats completados */
+        uint8_t id;     /**< Tarea a copiar */
+
+        /* Suspendemos cambio de contexto para obtener una foto consistente */
+        osSuspendContextSwitching();
+        /* Contabilizamos lo ejecutado hasta ahora por la tarea que consulta */
+        statsChargeCurrentTask();
+
+        /* La idle task ocupa el ultimo lugar de la lista de tareas */
+        for(id = 0; n < len && id < sizeof(g_Os.taskList) / sizeof(g_Os.taskList[0]); id++)
+        {
+            /* Salteamos los lugares libres y las tareas borradas */
+            if(TASK_STATE_TERMINATED != g_Os.taskList[id].state && TASK_STATE_DELETED != g_Os.taskList[id].state)
+            {
+                stats[n].taskId      = id;
+                stats[n].taskName    = (const char *)g_Os.taskList[id].taskName;
+                stats[n].priority    = g_Os.taskList[id].priority;
+                stats[n].cycles      = g_Os.taskList[id].cycles;
+                stats[n].switchCount = g_Os.taskList[id].switchCount;
+                n++;
+            }
+        }
+
+        if(NULL != isrCycles)
+        {
+            *isrCycles = g_Os.isrCycles;
+        }
+
+        osResumeContextSwitching();
+
+        return n;
+    }
+
+    /**
+    * @fn void osTaskStatsDump(osStatsPrint_t print)
+    * @brief Funcion que imprime, al estilo top, el uso de CPU de cada tarea desde la llamada anterior
+    * @param  print : Funcion que imprime cada linea, por ejemplo por UART
+    * @return Nada
+    * @note Llamandola periodicamente se obtiene el uso de CPU de cada periodo
+    * @warning Solo debe ser llamada desde una unica tarea
+    */
+    void osTaskStatsDump(osStatsPrint_t print)
+    {
+        static uint64_t prevCycles[OS_MAX_TASK + 1];            /**< Ciclos de cada tarea en la llamada anterior */
+        static uint32_t prevSwitchCount[OS_MAX_TASK + 1];       /**< Cambios de contexto de cada tarea en la llamada anterior */
+        static uint64_t prevIsrCycles;                          /**< Ciclos de IRQs en la llamada anterior */
+        taskStats_t     stats[OS_MAX_TASK + 1];                 /**< Estadisticas actuales */
+        uint64_t        isrCycles;                              /**< Ciclos de IRQs actuales */
+        uint64_t        total;                                  /**< Ciclos transcurridos desde la llamada anterior */
+        uint32_t        permil;                                 /**< Uso de CPU en por mil */
+        char            line[48 + OS_MAX_TASK_NAME_LEN];        /**< Linea a imprimir */
+        uint8_t         n;                                      /**< Cantidad de tareas */
+        uint8_t         i;                                      /**< Tarea a imprimir */
+
+        n = osGetTaskStats(stats, OS_MAX_TASK + 1, &isrCycles);
+
+        total = isrCycles - prevIsrCycles;
+        for(i = 0; i < n; i++)
+        {
+            /* Si el lugar de la tarea fue reusado, la tarea nueva cuenta desde cero */
+            if(stats[i].cycles < prevCycles[stats[i].taskId])
+            {
+                prevCycles[stats[i].taskId]      = 0;
+                prevSwitchCount[stats[i].taskId] = 0;
+            }
+            total += stats[i].cycles - prevCycles[stats[i].taskId];
+        }
+        if(0 == total)
+        {
+            total = 1;
+        }
+
+        snprintf(line, sizeof(line), "%-*s %4s %6s %8s\n\r", OS_MAX_TASK_NAME_LEN, "TAREA", "PRIO", "CPU", "CAMBIOS");
+        print(line);
+
+        for(i = 0; i < n; i++)
+        {
+            permil = (uint32_t)(((stats[i].cycles - prevCycles[stats[i].taskId]) * 1000) / total);
+            snprintf(line, sizeof(line), "%-*s %4lu %4lu.%lu%% %8lu\n\r", OS_MAX_TASK_NAME_LEN, stats[i].taskName,
+                     (unsigned long)stats[i].priority, (unsigned long)(permil / 10), (unsigned long)(permil % 10),
+                     (unsigned long)(stats[i].switchCount - prevSwitchCount[stats[i].taskId]));
+            print(line);
+
+            prevCycles[stats[i].taskId]      = stats[i].cycles;
+            prevSwitchCount[stats[i].taskId] = stats[i].switchCount;
+        }
+
+        permil = (uint32_t)(((isrCycles - prevIsrCycles) * 1000) / total);
+        snprintf(line, sizeof(line), "%-*s %4s %4lu.%lu%% %8s\n\r", OS_MAX_TASK_NAME_LEN, "IRQs", "-",
+                 (unsigned long)(permil / 10), (unsigned long)(permil % 10), "-");
+        print(line);
+
+        prevIsrCycles = isrCycles;
+    }
+#endif
+
+#if ( OS_USE_STACK_CHECK == 1 )
+    /**
+    * @fn uint32_t taskGetStackHighWaterMark(uint8_t taskId)
+    * @brief Funcion que devuelve el minimo espacio libre que tuvo el stack de una tarea
+    * @param  taskId : id de la tarea, osGetCurrentTask() para la tarea actual
+    * @return Bytes del stack que nunca fueron usados, 0 si la tarea no existe
+    * @note Recorre el stack desde su base hasta la primer palabra sin el patron de pintado,
+            por lo que su tiempo de ejecucion es proporcional al espacio libre
+    * @note Con OS_USE_MPU_STACK_GUARD el recorrido empieza despues de la guarda, que no puede leerse
+            si es la de la tarea actual: el resultado es el espacio libre por encima de la guarda
+    */
+    uint32_t taskGetStackHighWaterMark(uint8_t taskId)
+    {
+        uint32_t   words = 0;   /**< Palabras sin usar desde la base del stack */
+        uint32_t   start = 0;   /**< Primera palabra a recorrer */
+        uint32_t * stack;       /**< Stack de la tarea */
+
+        if(sizeof(g_Os.taskList) / sizeof(g_Os.taskList[0]) > taskId && NULL != g_Os.taskList[taskId].stack)
+        {
+            stack = g_Os.taskList[taskId].stack;
+
+            #if ( OS_USE_MPU_STACK_GUARD == 1 )
+                /* La guarda ocupa los primeros OS_PORT_STACK_GUARD_SIZE bytes alineados del stack,
+                   igual que en osPortStackGuardSet() */
+                start = ((((uint32_t)stack + OS_PORT_STACK_GUARD_SIZE - 1) & ~(OS_PORT_STACK_GUARD_SIZE - 1)) +
+                         OS_PORT_STACK_GUARD_SIZE - (uint32_t)stack) / sizeof(uint32_t);
+            #endif
+
+            /* El stack crece hacia abajo: la porcion nunca usada es la de menor direccion */
+            while(g_Os.taskList[taskId].stackSize / sizeof(uint32_t) > start + words &&
+                  OS_STACK_FILL_PATTERN == stack[start + words])
+            {
+                words++;
+            }
+        }
+
+        return words * sizeof(uint32_t);
+    }
+#endif
+
+/**
+* @fn void osSuspendContextSwitching()
+* @brief Funcion que suspende el context switch - Entra en una seccion critica
+* @param  Ninguno
+* @return Nada
+* @note Es anidable: el context switch se reanuda con el osResumeContextSwitching() mas externo
+* @note Solo enmascara las IRQs que llaman al SO(prioridad >= OS_MAX_SYSCALL_IRQ_PRIO),
+        las de mayor prioridad siguen ejecutandose
+*/
+void osSuspendContextSwitching()
+{
+    OS_PORT_SET_MASK(OS_PORT_SYSCALL_MASK);
+    g_Os.criticalNesting++;
+    g_Os.state = OS_STATE_SUSPENDED;
+}
+
+/**
+* @fn void osResumeContextSwitching()
+* @brief Funcion que resume el context switch - Sale de una seccion critica
+* @param  Ninguno
+* @return Nada
+*/
+void osResumeContextSwitching()
+{
+    if(0 < g_Os.criticalNesting && 0 == --g_Os.criticalNesting)
+    {
+        g_Os.state = OS_STATE_RUNNING;
+        OS_PORT_SET_MASK(0);
+    }
+}
+
+/**
+* @fn uint32_t osSuspendContextSwitchingFromISR(void)
+* @brief Funcion que entra en una seccion critica desde una IRQ
+* @param  Ninguno
+* @return Mascara de IRQs previa, a pasarle a osResumeContextSwitchingFromISR()
+* @note No modifica el anidamiento de las tareas: la IRQ no puede haber interrumpido una seccion critica
+*/
+uint32_t osSuspendContextSwitchingFromISR(void)
+{
+    uint32_t mask = OS_PORT_GET_MASK();
+
+    OS_PORT_SET_MASK(OS_PORT_SYSCALL_MASK);
+
+    return mask;
+}
+
+/**
+* @fn void osResumeContextSwitchingFromISR(uint32_t mask)
+* @brief Funcion que sale de una seccion critica desde una IRQ
+* @param  mask : Mascara de IRQs devuelta por osSuspendContextSwitchingFromISR()
+* @return Nada
+*/
+void osResumeContextSwitchingFromISR(uint32_t mask)
+{
+    OS_PORT_SET_MASK(mask);
+}
+
+/**
+* @fn void osGetCurrentTask()
+* @brief Funcion que devuelve la tarea en ejecucion
+* @param  Ninguno
+* @return Id de la tarea en ejecucion
+*/
+uint8_t osGetCurrentTask()
+{
+    return g_Os.currentTask;
+}
+
+/**
+* @fn vuint8_t osIsIdleTask(uint8_t taskId)
 * @brief Funcion que devuelve si una tarea es la idle task
 * @param  Ninguno
 * @return true(1) si la tarea es la idle task, false(0) caso contrario
 */
 uint8_t osIsIdleTask(uint8_t taskId)
 {
-    return g_Os.maxTask == taskId;
+    return OS_IDLE_TASK == taskId;
 }
 /*==================[IRQ Handlers]======================================*/
 /**
@@ -645,18 +2584,45 @@ uint8_t osIsIdleTask(uint8_t taskId)
 */
 void SysTick_Handler( void )
 {
-    
+    uint32_t mask;
+    #if ( OS_USE_TICK_PROFILE == 1 )
+        uint32_t entry = OS_PORT_CYCLE_COUNT();     /**< Cuenta del contador de ciclos al entrar */
+        uint32_t start;                             /**< Cuenta del contador de ciclos al comenzar la actualizacion */
+    #endif
+
+    #if ( OS_USE_TASK_STATS == 1 )
+        /* El tiempo del tick no se contabiliza a la tarea interrumpida */
+        osIsrEnter();
+    #endif
+
+    /* El SysTick tiene la menor prioridad: las IRQs de prioridad OS_MAX_SYSCALL_IRQ_PRIO o menor que
+       modifican las listas de delay, de espera y de tareas ready no deben interrumpir su actualizacion */
+    mask = osSuspendContextSwitchingFromISR();
+
     /* Incrementa el tick del SO */
     if(OS_RESULT_OK == osIncrementTick())
     {
         /* Si estamos usando delay, actualizamos los ticks de cada tarea bloqueada */
-        #if ( OS_USE_TASK_DELAY == 1 )
-            delayUpdate();
+        #if ( OS_USE_TICK_PROFILE == 1 )
+            start = OS_PORT_CYCLE_COUNT();
+            delayUpdate(1);
+            g_Os.tickUpdateCycles = OS_PORT_CYCLE_COUNT() - start;
+        #elif ( OS_USE_TASK_DELAY == 1 )
+            delayUpdate(1);
         #endif
         /* Llamamos al scheduler */
         schedule();
     }
-    
+
+    osResumeContextSwitchingFromISR(mask);
+
+    #if ( OS_USE_TASK_STATS == 1 )
+        osIsrExit();
+    #endif
+
+    #if ( OS_USE_TICK_PROFILE == 1 )
+        g_Os.tickCycles = OS_PORT_CYCLE_COUNT() - entry;
+    #endif
 }
 /*==================[end of file]============================================*/
 
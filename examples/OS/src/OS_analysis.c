@@ -0,0 +1,298 @@
+/**
+* @file  OS_analysis.c
+* @brief Analisis de planificabilidad de tareas periodicas para EDF y rate-monotonic
+* @note  Pensado para usarse fuera de linea o en la inicializacion, para validar un conjunto de tareas
+         antes de crearlas. Los tiempos de ejecucion de peor caso los provee el usuario, por ejemplo a
+         partir de las estadisticas de OS_USE_TASK_STATS
+* @note  Copyright 2019 - Esp. Ing. Matias Alvarez.
+*/
+
+/*==================[inclusions]=============================================*/
+#include "OS_analysis.h"
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+/**
+* @def SCHED_DEADLINE(task)
+* @brief Macro que devuelve el deadline de una tarea, que por defecto es su periodo
+*/
+#define SCHED_DEADLINE(task)    ( (0 == (task)->deadline) ? (task)->period : (task)->deadline )
+
+/**
+* @def SCHED_CEIL(a, b)
+* @brief Macro que devuelve la division entera de a por b redondeada hacia arriba
+*/
+#define SCHED_CEIL(a, b)        ( ((a) + (b) - 1) / (b) )
+
+/**
+* @def SCHED_MAX_HORIZON
+* @brief Maximo intervalo analizado - Mas alla el analisis se considera no factible
+*/
+#define SCHED_MAX_HORIZON       ( (uint64_t)OS_MAX_DELAY )
+/*==================[typedef]================================================*/
+
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+#if ( OS_USE_SCHED_ANALYSIS == 1 )
+/**
+* @fn static bool schedValid(const schedTask_t * tasks, uint32_t count)
+* @brief Funcion que valida los parametros de un conjunto de tareas
+* @param  tasks : Tareas
+* @param  count : Cantidad de tareas
+* @return true si todas las tareas cumplen 0 < wcet <= deadline <= period, false caso contrario
+*/
+static bool schedValid(const schedTask_t * tasks, uint32_t count)
+{
+    uint32_t i;
+
+    if(NULL == tasks || 0 == count)
+    {
+        return false;
+    }
+
+    for(i = 0; i < count; i++)
+    {
+        if(0 == tasks[i].wcet || SCHED_DEADLINE(&tasks[i]) < tasks[i].wcet || tasks[i].period < SCHED_DEADLINE(&tasks[i]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+* @fn static uint64_t schedGcd(uint64_t a, uint64_t b)
+* @brief Funcion que calcula el maximo comun divisor
+* @param  a : Primer valor
+* @param  b : Segundo valor
+* @return Maximo comun divisor de a y b
+*/
+static uint64_t schedGcd(uint64_t a, uint64_t b)
+{
+    uint64_t r;
+
+    while(0 != b)
+    {
+        r = a % b;
+        a = b;
+        b = r;
+    }
+
+    return a;
+}
+
+/**
+* @fn static uint64_t schedDemand(const schedTask_t * tasks, uint32_t count, uint64_t t)
+* @brief Funcion que calcula la demanda de procesador de los trabajos con activacion y deadline dentro de [0, t]
+* @param  tasks : Tareas
+* @param  count : Cantidad de tareas
+* @param  t     : Largo del intervalo
+* @return Ticks de ejecucion requeridos, con todas las tareas activadas en el instante 0
+*/
+static uint64_t schedDemand(const schedTask_t * tasks, uint32_t count, uint64_t t)
+{
+    uint64_t demand = 0;
+    uint32_t i;
+
+    for(i = 0; i < count; i++)
+    {
+        if(t >= SCHED_DEADLINE(&tasks[i]))
+        {
+            demand += ((t - SCHED_DEADLINE(&tasks[i])) / tasks[i].period + 1) * tasks[i].wcet;
+        }
+    }
+
+    return demand;
+}
+/*==================[external functions definition]==========================*/
+/**
+* @fn uint32_t schedUtilization(const schedTask_t * tasks, uint32_t count)
+* @brief Funcion que calcula la utilizacion de CPU de un conjunto de tareas
+* @param  tasks : Tareas
+* @param  count : Cantidad de tareas
+* @return Suma de wcet / period en milesimas, redondeada hacia arriba
+*/
+uint32_t schedUtilization(const schedTask_t * tasks, uint32_t count)
+{
+    uint64_t fraction = 0;   /**< Utilizacion en punto fijo de 32 bits fraccionales */
+    uint32_t i;
+
+    for(i = 0; i < count; i++)
+    {
+        fraction += SCHED_CEIL((uint64_t)tasks[i].wcet << 32, tasks[i].period);
+    }
+
+    return (uint32_t)SCHED_CEIL(fraction * 1000, (uint64_t)1 << 32);
+}
+
+/**
+* @fn osReturn_t schedEdfTest(const schedTask_t * tasks, uint32_t count)
+* @brief Funcion que evalua si un conjunto de tareas periodicas es planificable con EDF
+* @param  tasks : Tareas
+* @param  count : Cantidad de tareas
+* @return OS_RESULT_OK si ningun trabajo pierde su deadline, OS_RESULT_ERROR caso contrario o si los parametros no son validos
+* @note Con deadline igual al periodo el test es exacto: utilizacion menor o igual a 1. Con deadlines menores
+        al periodo se verifica ademas la demanda de procesador en cada deadline del primer periodo ocupado
+* @note Si el hiperperiodo no es representable la utilizacion se evalua redondeada hacia arriba, por lo que
+        el test puede rechazar conjuntos con utilizacion exactamente 1
+*/
+osReturn_t schedEdfTest(const schedTask_t * tasks, uint32_t count)
+{
+    uint64_t hyperperiod = 1;       /**< Minimo comun multiplo de los periodos */
+    uint64_t horizon;               /**< Maximo largo del periodo ocupado */
+    uint64_t busy;                  /**< Largo del periodo ocupado */
+    uint64_t next;
+    uint64_t fraction = 0;
+    uint64_t deadline;
+    bool     constrained = false;   /**< Indica si alguna tarea tiene deadline menor a su periodo */
+    uint32_t i;
+
+    if(!schedValid(tasks, count))
+    {
+        return OS_RESULT_ERROR;
+    }
+
+    for(i = 0; i < count && SCHED_MAX_HORIZON >= hyperperiod; i++)
+    {
+        hyperperiod = hyperperiod / schedGcd(hyperperiod, tasks[i].period) * tasks[i].period;
+    }
+
+    /* Utilizacion menor o igual a 1 */
+    if(SCHED_MAX_HORIZON >= hyperperiod)
+    {
+        /* Exacta: la demanda de un hiperperiodo no puede superarlo */
+        horizon = hyperperiod;
+        for(i = 0, next = 0; i < count; i++)
+        {
+            next += (hyperperiod / tasks[i].period) * tasks[i].wcet;
+        }
+        if(next > hyperperiod)
+        {
+            return OS_RESULT_ERROR;
+        }
+    }
+    else
+    {
+        horizon = SCHED_MAX_HORIZON;
+        for(i = 0; i < count; i++)
+        {
+            fraction += SCHED_CEIL((uint64_t)tasks[i].wcet << 32, tasks[i].period);
+        }
+        if(fraction > ((uint64_t)1 << 32))
+        {
+            return OS_RESULT_ERROR;
+        }
+    }
+
+    for(i = 0; i < count; i++)
+    {
+        constrained |= (SCHED_DEADLINE(&tasks[i]) < tasks[i].period);
+    }
+    if(!constrained)
+    {
+        return OS_RESULT_OK;
+    }
+
+    /* Periodo ocupado sincronico: punto fijo de la demanda de todos los trabajos activados */
+    for(i = 0, busy = 0; i < count; i++)
+    {
+        busy += tasks[i].wcet;
+    }
+    while(1)
+    {
+        for(i = 0, next = 0; i < count; i++)
+        {
+            next += SCHED_CEIL(busy, tasks[i].period) * tasks[i].wcet;
+        }
+        if(next == busy)
+        {
+            break;
+        }
+        if(next > horizon)
+        {
+            return OS_RESULT_ERROR;
+        }
+        busy = next;
+    }
+
+    /* Demanda de procesador en cada deadline dentro del periodo ocupado */
+    for(i = 0; i < count; i++)
+    {
+        for(deadline = SCHED_DEADLINE(&tasks[i]); deadline <= busy; deadline += tasks[i].period)
+        {
+            if(schedDemand(tasks, count, deadline) > deadline)
+            {
+                return OS_RESULT_ERROR;
+            }
+        }
+    }
+
+    return OS_RESULT_OK;
+}
+
+/**
+* @fn osReturn_t schedRmTest(const schedTask_t * tasks, uint32_t count, tick_t * response)
+* @brief Funcion que evalua si un conjunto de tareas periodicas es planificable con prioridades fijas rate-monotonic
+* @param  tasks    : Tareas
+* @param  count    : Cantidad de tareas
+* @param  response : Donde se guarda el tiempo de respuesta de peor caso de cada tarea, mayor a su deadline
+                     si lo pierde. Puede ser NULL
+* @return OS_RESULT_OK si ningun trabajo pierde su deadline, OS_RESULT_ERROR caso contrario o si los parametros no son validos
+* @note Analisis exacto de tiempo de respuesta. Las prioridades se asignan por deadline(deadline-monotonic, que
+        con deadline igual al periodo es rate-monotonic) y a igual deadline por orden en tasks. Las tareas deben
+        crearse con esas prioridades relativas, sin compartir prioridad con tareas de otro deadline
+*/
+osReturn_t schedRmTest(const schedTask_t * tasks, uint32_t count, tick_t * response)
+{
+    osReturn_t retVal = OS_RESULT_OK;
+    uint64_t   wcrt;    /**< Tiempo de respuesta de peor caso */
+    uint64_t   prev;
+    uint32_t   i;
+    uint32_t   j;
+
+    if(!schedValid(tasks, count))
+    {
+        return OS_RESULT_ERROR;
+    }
+
+    for(i = 0; i < count; i++)
+    {
+        /* El tiempo de respuesta es el punto fijo de la ejecucion propia mas la interferencia
+           de las tareas de mayor prioridad */
+        wcrt = tasks[i].wcet;
+        prev = 0;
+        while(wcrt != prev && wcrt <= SCHED_DEADLINE(&tasks[i]))
+        {
+            prev = wcrt;
+            wcrt = tasks[i].wcet;
+            for(j = 0; j < count; j++)
+            {
+                if(SCHED_DEADLINE(&tasks[j]) < SCHED_DEADLINE(&tasks[i]) ||
+                   (SCHED_DEADLINE(&tasks[j]) == SCHED_DEADLINE(&tasks[i]) && j < i))
+                {
+                    wcrt += SCHED_CEIL(prev, tasks[j].period) * tasks[j].wcet;
+                }
+            }
+        }
+
+        if(wcrt > SCHED_DEADLINE(&tasks[i]))
+        {
+            retVal = OS_RESULT_ERROR;
+        }
+        if(NULL != response)
+        {
+            response[i] = (wcrt > SCHED_MAX_HORIZON) ? OS_MAX_DELAY : (tick_t)wcrt;
+        }
+    }
+
+    return retVal;
+}
+#endif
+/*==================[end of file]============================================*/
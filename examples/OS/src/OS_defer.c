@@ -0,0 +1,183 @@
+/**
+* @file  OS_defer.c
+* @brief Procesamiento diferido de interrupciones
+* @note  Las IRQs encolan trabajos con irqDefer() sin deshabilitar interrupciones, y una tarea del SO
+         los ejecuta por orden de llegada. Varias IRQs, incluso anidadas, pueden encolar a la vez: cada
+         una reserva su lugar con un acceso exclusivo(LDREX/STREX) y lo marca como listo al terminar
+         de escribirlo
+* @note  Copyright 2019 - Esp. Ing. Matias Alvarez.
+*/
+
+/*==================[inclusions]=============================================*/
+#include "OS_defer.h"
+#include "OS_port.h"
+/*==================[macros]=================================================*/
+/**
+* @def IRQ_DEFER_MASK
+* @brief Mascara para obtener el lugar de la cola de trabajos a partir de un indice
+*/
+#define IRQ_DEFER_MASK              ( OS_IRQ_DEFER_QUEUE_LEN - 1 )
+
+/**
+* @def IRQ_DEFER_READY(index)
+* @brief Macro para evaluar si el trabajo del indice index ya fue escrito por su IRQ
+*/
+#define IRQ_DEFER_READY(index)      ( (index) + 1 == g_deferQueue[(index) & IRQ_DEFER_MASK].seq )
+/*==================[typedef]================================================*/
+#if ( OS_USE_IRQ_DEFER == 1 )
+/**
+* @struct irqDeferWork_t
+* @brief Trabajo diferido
+*/
+typedef struct
+{
+    irqDeferFunction_t  fx;         /**< Funcion a ejecutar */
+    void *              arg;        /**< Argumento de la funcion */
+    tick_t              tick;       /**< Tick en que se difirio el trabajo */
+    volatile uint32_t   seq;        /**< Indice del trabajo + 1 una vez escrito - Distingue cada vuelta de la cola */
+}irqDeferWork_t;
+/*==================[internal data declaration]==============================*/
+/**
+* @var static irqDeferWork_t g_deferQueue[OS_IRQ_DEFER_QUEUE_LEN]
+* @brief Cola de trabajos diferidos
+*/
+static irqDeferWork_t g_deferQueue[OS_IRQ_DEFER_QUEUE_LEN];
+
+/**
+* @var static volatile uint32_t g_deferHead
+* @brief Indice de escritura - Lo reservan las IRQs con LDREX/STREX
+*/
+static volatile uint32_t g_deferHead;
+
+/**
+* @var static volatile uint32_t g_deferTail
+* @brief Indice de lectura - Solo lo modifica la tarea de trabajos diferidos
+*/
+static volatile uint32_t g_deferTail;
+
+/**
+* @var static volatile uint32_t g_deferDropped
+* @brief Cantidad de trabajos descartados por cola llena
+*/
+static volatile uint32_t g_deferDropped;
+
+/**
+* @var static volatile uint8_t g_deferWaiting
+* @brief id de la tarea de trabajos diferidos mientras espera trabajos, OS_INVALID_TASK si no espera
+*/
+static volatile uint8_t g_deferWaiting = OS_INVALID_TASK;
+
+/**
+* @var static uint32_t g_deferTaskStack[OS_IRQ_DEFER_STACK_SIZE / sizeof(uint32_t)]
+* @brief Stack de la tarea de trabajos diferidos
+*/
+static uint32_t g_deferTaskStack[OS_IRQ_DEFER_STACK_SIZE / sizeof(uint32_t)];
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+* @fn static bool irqDeferReady(const void * tail)
+* @brief Funcion que evalua si el proximo trabajo ya fue escrito por su IRQ
+* @param  tail : Puntero al indice de lectura
+* @return true si el trabajo esta listo, false caso contrario
+*/
+static bool irqDeferReady(const void * tail)
+{
+    return IRQ_DEFER_READY(*(const uint32_t *)tail);
+}
+
+/**
+* @fn static void irqDeferTask(void * parameters)
+* @brief Tarea de trabajos diferidos - Ejecuta los trabajos encolados por las IRQs
+* @param  parameters : No se usa
+* @return Nada
+* @note Por cada despertar ejecuta todos los trabajos encolados, por lo que una rafaga de IRQs
+        cuesta un unico cambio de contexto
+*/
+static void irqDeferTask(void * parameters)
+{
+    uint32_t       tail = g_deferTail;  /**< Indice de lectura */
+    irqDeferWork_t work;                /**< Trabajo a ejecutar */
+
+    while(1)
+    {
+        osWaitForProducer(&g_deferWaiting, irqDeferReady, &tail, OS_MAX_DELAY);
+
+        /* Ejecutamos los trabajos listos por orden de llegada. Si una IRQ reservo un lugar y aun no lo
+           escribio, los siguientes esperan aunque ya esten listos */
+        while(IRQ_DEFER_READY(tail))
+        {
+            /* El trabajo se lee despues de ver su indice */
+            __DMB();
+            work.fx   = g_deferQueue[tail & IRQ_DEFER_MASK].fx;
+            work.arg  = g_deferQueue[tail & IRQ_DEFER_MASK].arg;
+            work.tick = g_deferQueue[tail & IRQ_DEFER_MASK].tick;
+            /* Terminamos de leer antes de liberar el lugar */
+            __DMB();
+            tail++;
+            g_deferTail = tail;
+
+            work.fx(work.arg, work.tick);
+        }
+    }
+}
+/*==================[external functions definition]==========================*/
+/**
+* @fn void irqDeferServiceInit(void)
+* @brief Funcion que crea la tarea de trabajos diferidos
+* @param  Ninguno
+* @return Nada
+* @note La llama taskStartScheduler(). La tarea ocupa uno de los OS_MAX_TASK lugares de tareas
+* @warning NO DEBE SER USADA POR EL USUARIO
+*/
+void irqDeferServiceInit(void)
+{
+    taskCreate(irqDeferTask, OS_IRQ_DEFER_TASK_PRIORITY, g_deferTaskStack, sizeof(g_deferTaskStack), "DeferTask",
+               (void *)0, NULL);
+}
+
+/**
+* @fn osReturn_t irqDefer(irqDeferFunction_t fx, void * arg)
+* @brief Funcion que difiere un trabajo a la tarea de trabajos diferidos
+* @param  fx  : Funcion a ejecutar
+* @param  arg : Argumento de la funcion
+* @return OS_RESULT_ERROR si la cola de trabajos esta llena y el trabajo se descarta, OS_RESULT_OK caso contrario
+* @note No deshabilita interrupciones. Si la tarea de trabajos diferidos espera, se la despierta
+        en diferido a traves de la pendSV
+* @note Apta para IRQs de prioridad OS_MAX_SYSCALL_IRQ_PRIO o menor, y para tareas
+*/
+osReturn_t irqDefer(irqDeferFunction_t fx, void * arg)
+{
+    uint32_t head;      /**< Indice reservado */
+
+    if(OS_RESULT_OK != osReserveSlot(&g_deferHead, &g_deferTail, IRQ_DEFER_MASK, &g_deferDropped, &head))
+    {
+        return OS_RESULT_ERROR;
+    }
+
+    g_deferQueue[head & IRQ_DEFER_MASK].fx   = fx;
+    g_deferQueue[head & IRQ_DEFER_MASK].arg  = arg;
+    g_deferQueue[head & IRQ_DEFER_MASK].tick = taskGetTickCount();
+    /* Marcamos el trabajo como listo y despertamos a la tarea si espera */
+    osPublishAndWake(&g_deferQueue[head & IRQ_DEFER_MASK].seq, head + 1, &g_deferWaiting);
+
+    return OS_RESULT_OK;
+}
+
+/**
+* @fn uint32_t irqDeferGetDropped(void)
+* @brief Funcion que devuelve la cantidad de trabajos descartados por cola llena
+* @param  Ninguno
+* @return Cantidad de trabajos descartados
+* @note Permite dimensionar OS_IRQ_DEFER_QUEUE_LEN
+*/
+uint32_t irqDeferGetDropped(void)
+{
+    return g_deferDropped;
+}
+#endif
+/*==================[end of file]============================================*/
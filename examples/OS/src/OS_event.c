@@ -0,0 +1,251 @@
+/**
+* @file  OS_event.c
+* @brief Grupos de eventos de 32 bits
+* @note  Copyright 2019 - Esp. Ing. Matias Alvarez.
+*/
+
+/*==================[inclusions]=============================================*/
+#include "OS_event.h"
+/*==================[macros]=================================================*/
+/**
+* @def EVENT_MATCH(bits, mask, mode)
+* @brief Macro para evaluar si los eventos seteados cumplen la condicion de espera
+*/
+#define EVENT_MATCH(bits, mask, mode)   ( (EVENT_WAIT_ALL == (mode)) ? (((bits) & (mask)) == (mask)) : \
+                                                                      (0 != ((bits) & (mask))) )
+/*==================[typedef]================================================*/
+#if ( OS_USE_EVENT == 1 )
+/**
+* @struct eventWaiter_t
+* @brief Condicion de espera de una tarea bloqueada en un grupo de eventos
+*/
+typedef struct
+{
+    uint32_t        mask;           /**< Eventos esperados */
+    eventWaitMode_t mode;           /**< Condicion de espera */
+    bool            clearOnExit;    /**< Indica si se limpian los eventos esperados al despertar */
+    uint32_t        bits;           /**< Eventos seteados al despertar la tarea */
+}eventWaiter_t;
+/*==================[internal data declaration]==============================*/
+/**
+* @var static eventWaiter_t g_eventWaiter[OS_MAX_TASK + 1]
+* @brief Condicion de espera de cada tarea, por id de tarea
+* @note Una tarea solo puede estar bloqueada en un objeto a la vez, por lo que alcanza con
+        un lugar por tarea en lugar de uno por grupo de eventos
+*/
+static eventWaiter_t g_eventWaiter[OS_MAX_TASK + 1];
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+* @fn static bool eventUpdate(event_t * event)
+* @brief Funcion que despierta a todas las tareas cuya condicion de espera se cumple
+* @param  event : Puntero al grupo de eventos
+* @return true si desperto alguna tarea, false caso contrario
+* @note Todas las tareas se evaluan contra los mismos eventos: los que se limpian al despertar
+        se limpian al final de la recorrida
+* @note Debe ser llamada con el cambio de contexto suspendido
+*/
+static bool eventUpdate(event_t * event)
+{
+    uint8_t  id = event->waitList.head;     /**< Tarea a evaluar */
+    uint8_t  next;                          /**< Tarea siguiente, se obtiene antes de despertar a la actual */
+    uint32_t clearMask = 0;                 /**< Eventos a limpiar */
+    bool     woken = false;
+
+    while(OS_INVALID_TASK != id)
+    {
+        next = waitListNext(id);
+
+        if(EVENT_MATCH(event->bits, g_eventWaiter[id].mask, g_eventWaiter[id].mode))
+        {
+            g_eventWaiter[id].bits = event->bits;
+            if(g_eventWaiter[id].clearOnExit)
+            {
+                clearMask |= g_eventWaiter[id].mask;
+            }
+            taskWakeWaiting(id);
+            woken = true;
+        }
+
+        id = next;
+    }
+
+    event->bits &= ~clearMask;
+
+    return woken;
+}
+/*==================[external functions definition]==========================*/
+/**
+* @fn void eventInit(event_t * event)
+* @brief Funcion que inicializa un grupo de eventos sin eventos seteados
+* @param  event : Puntero al grupo de eventos
+* @return Nada
+*/
+void eventInit(event_t * event)
+{
+    event->bits = 0;
+    waitListInit(&(event->waitList));
+}
+
+/**
+* @fn osReturn_t eventWait(event_t * event, uint32_t mask, eventWaitMode_t mode, bool clearOnExit, tick_t delay,
+                     uint32_t * bits)
+* @brief Funcion que espera a que se seteen uno o todos los eventos de una mascara
+* @param  event       : Puntero al grupo de eventos
+* @param  mask        : Eventos a esperar
+* @param  mode        : EVENT_WAIT_ANY para esperar cualquiera de los eventos, EVENT_WAIT_ALL para esperarlos todos
+* @param  clearOnExit : Si es true se limpian los eventos de mask al cumplirse la condicion
+* @param  delay       : Tiempo maximo de espera
+* @param  bits        : Donde se guardan los eventos seteados al cumplirse la condicion o al expirar el delay.
+                        Puede ser NULL
+* @return OS_RESULT_OK si se cumplio la condicion,
+          OS_RESULT_ERROR si expiro el delay, si mask es 0 o si se llama desde la idle task sin cumplirse
+* @note Varias tareas pueden esperar el mismo grupo de eventos, un mismo set despierta a todas las que cumplan
+* @danger Desde IRQ o Idle Task con delay 0
+*/
+osReturn_t eventWait(event_t * event, uint32_t mask, eventWaitMode_t mode, bool clearOnExit, tick_t delay,
+                     uint32_t * bits)
+{
+    osReturn_t retVal = OS_RESULT_ERROR;
+    uint8_t    id;          /**< Tarea actual */
+    uint32_t   value;       /**< Eventos seteados */
+
+    /* Suspendemos cambio de contexto porque estamos manipulando variables globales */
+    osSuspendContextSwitching();
+
+    value = event->bits;
+
+    if(0 != mask)
+    {
+        /* Si ya se cumple la condicion no esperamos */
+        if(EVENT_MATCH(event->bits, mask, mode))
+        {
+            if(clearOnExit)
+            {
+                event->bits &= ~mask;
+            }
+            retVal = OS_RESULT_OK;
+        }
+        else
+        {
+            id = osGetCurrentTask();
+            g_eventWaiter[id].mask        = mask;
+            g_eventWaiter[id].mode        = mode;
+            g_eventWaiter[id].clearOnExit = clearOnExit;
+
+            /* Si al volver de la espera nos despertaron, eventUpdate() ya limpio los eventos */
+            retVal = taskBlockOnWaitList(&(event->waitList), delay);
+            value = (OS_RESULT_OK == retVal) ? g_eventWaiter[id].bits : event->bits;
+        }
+    }
+
+    /* Volvemos a permitir el cambio de contexto */
+    osResumeContextSwitching();
+
+    if(NULL != bits)
+    {
+        *bits = value;
+    }
+
+    return retVal;
+}
+
+/**
+* @fn void eventSet(event_t * event, uint32_t bits)
+* @brief Funcion que setea eventos de un grupo de eventos
+* @param  event : Puntero al grupo de eventos
+* @param  bits  : Eventos a setear
+* @return Nada
+* @note Despierta en una sola pasada a todas las tareas cuya condicion se cumple
+*/
+void eventSet(event_t * event, uint32_t bits)
+{
+    bool woken;
+
+    /* Suspendemos cambio de contexto porque estamos manipulando variables globales */
+    osSuspendContextSwitching();
+
+    event->bits |= bits;
+    woken = eventUpdate(event);
+
+    /* Volvemos a permitir el cambio de contexto */
+    osResumeContextSwitching();
+
+    if(woken)
+    {
+        /* Llamamos al scheduler por si alguna tarea despertada es de mayor prioridad */
+        taskYield();
+    }
+}
+
+/**
+* @fn void eventSetFromISR(event_t * event, uint32_t bits)
+* @brief Funcion que setea eventos de un grupo de eventos desde una IRQ
+* @param  event : Puntero al grupo de eventos
+* @param  bits  : Eventos a setear
+* @return Nada
+* @note Nunca llama al scheduler dentro de la IRQ: si despierta tareas solo deja
+        pendiente el cambio de contexto para la salida de la IRQ
+*/
+void eventSetFromISR(event_t * event, uint32_t bits)
+{
+    uint32_t mask;
+    bool     woken;
+
+    /* Suspendemos cambio de contexto porque estamos manipulando variables globales */
+    mask = osSuspendContextSwitchingFromISR();
+
+    event->bits |= bits;
+    woken = eventUpdate(event);
+
+    /* Volvemos a permitir el cambio de contexto */
+    osResumeContextSwitchingFromISR(mask);
+
+    if(woken)
+    {
+        /* Dejamos pendiente el cambio de contexto para la salida de la IRQ */
+        taskYieldFromISR();
+    }
+}
+
+/**
+* @fn uint32_t eventClear(event_t * event, uint32_t bits)
+* @brief Funcion que limpia eventos de un grupo de eventos
+* @param  event : Puntero al grupo de eventos
+* @param  bits  : Eventos a limpiar
+* @return Eventos seteados antes de limpiarlos
+* @note Puede llamarse desde una IRQ
+*/
+uint32_t eventClear(event_t * event, uint32_t bits)
+{
+    uint32_t mask;
+    uint32_t value;
+
+    mask = osSuspendContextSwitchingFromISR();
+
+    value = event->bits;
+    event->bits &= ~bits;
+
+    osResumeContextSwitchingFromISR(mask);
+
+    return value;
+}
+
+/**
+* @fn uint32_t eventGetBits(event_t * event)
+* @brief Funcion que devuelve los eventos seteados de un grupo de eventos
+* @param  event : Puntero al grupo de eventos
+* @return Eventos seteados
+* @note Puede llamarse desde una IRQ
+*/
+uint32_t eventGetBits(event_t * event)
+{
+    return event->bits;
+}
+#endif
+/*==================[end of file]============================================*/
@@ -9,6 +9,18 @@
 #include "OS_irq.h"
 /*==================[macros]=================================================*/
 #define OS_MAX_IRQ      53
+
+/**
+* @def OS_IRQ_VECTOR_OFFSET
+* @brief Posicion de la IRQ 0 en la tabla de vectores, luego de las 16 excepciones del Cortex-M
+*/
+#define OS_IRQ_VECTOR_OFFSET    16
+
+/**
+* @def OS_VECTOR_TABLE_ALIGN
+* @brief Alineacion de la tabla de vectores en RAM - VTOR exige la potencia de 2 mayor o igual a su tamaño
+*/
+#define OS_VECTOR_TABLE_ALIGN   512
 /*==================[typedef]================================================*/
 
 /*==================[internal data declaration]==============================*/
@@ -17,6 +29,20 @@
 * @brief Arreglo de callbacks para cada irq del sistema
 */
 static irqCbFunction_t irqCbFunction[OS_MAX_IRQ];
+
+#if ( OS_USE_RAM_VECTORS == 1 )
+/**
+* @var static irqCbFunction_t g_ramVectors[OS_IRQ_VECTOR_OFFSET + OS_MAX_IRQ]
+* @brief Tabla de vectores en RAM, a la que apunta VTOR luego del primer irqAttach()
+*/
+static irqCbFunction_t g_ramVectors[OS_IRQ_VECTOR_OFFSET + OS_MAX_IRQ] __attribute__ ((aligned(OS_VECTOR_TABLE_ALIGN)));
+
+/**
+* @var static const irqCbFunction_t * g_flashVectors
+* @brief Tabla de vectores original, NULL mientras VTOR no fue reubicado
+*/
+static const irqCbFunction_t * g_flashVectors = NULL;
+#endif
 /*==================[internal functions declaration]=========================*/
 /**
 * @fn static void irqHandler(IRQn_Type IRQn)
@@ -26,32 +52,77 @@ static irqCbFunction_t irqCbFunction[OS_MAX_IRQ];
 */
 static void irqHandler(IRQn_Type IRQn)
 {
+    #if ( OS_USE_TASK_STATS == 1 )
+        /* El tiempo de la IRQ no se contabiliza a la tarea interrumpida */
+        osIsrEnter();
+    #endif
     /* Llamamos al callback */
     irqCbFunction[IRQn]();
     /* Limpiamos la interrupcion */
     NVIC_ClearPendingIRQ(IRQn);
+    #if ( OS_USE_TASK_STATS == 1 )
+        osIsrExit();
+    #endif
 }
 /*==================[internal data definition]===============================*/
 
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+#if ( OS_USE_RAM_VECTORS == 1 )
+/**
+* @fn static void irqRelocateVectors(void)
+* @brief Copia la tabla de vectores a RAM y reubica VTOR
+* @param  Ninguno
+* @return Nada
+* @note Las dos tablas son iguales al momento del cambio, por lo que una IRQ que llegue durante la
+        reubicacion se atiende con el mismo manejador
+*/
+static void irqRelocateVectors(void)
+{
+    uint32_t i;
 
+    g_flashVectors = (const irqCbFunction_t *)SCB->VTOR;
+    for(i = 0; i < OS_IRQ_VECTOR_OFFSET + OS_MAX_IRQ; i++)
+    {
+        g_ramVectors[i] = g_flashVectors[i];
+    }
+
+    SCB->VTOR = (uint32_t)g_ramVectors;
+    __DSB();
+}
+#endif
 /*==================[external functions definition]==========================*/
 /**
-* @fn osReturn_t irqAttach(IRQn_Type IRQn, irqCbFunction_t irqCbFunction)
+* @fn osReturn_t irqAttach(IRQn_Type IRQn, irqCbFunction_t irqCbFunction, uint32_t priority)
 * @brief Adjunta un callback a una dada interrupcion
 * @params IRQn : Numero de interrupcion
 * @params irqCbFunction : Callback a adjuntar
-* @return OS_RESULT_ERROR si ya habia un callback adjuntado, OS_RESULT_OK caso contrario
+* @params priority : Prioridad de la IRQ en el NVIC - Menor numero mayor prioridad
+* @return OS_RESULT_ERROR si la IRQ no existe, ya habia un callback adjuntado o la prioridad no existe en el NVIC,
+          OS_RESULT_OK caso contrario
+* @note Con OS_USE_RAM_VECTORS == 1 el callback se instala directamente en la tabla de vectores, sin pasar
+        por el manejador generico
+* @danger Si el callback llama al SO la prioridad debe ser OS_MAX_SYSCALL_IRQ_PRIO o de menor prioridad(mayor numero)
 */
-osReturn_t irqAttach(IRQn_Type IRQn, irqCbFunction_t irqCbPointer)
+osReturn_t irqAttach(IRQn_Type IRQn, irqCbFunction_t irqCbPointer, uint32_t priority)
 {
     osReturn_t retVal = OS_RESULT_ERROR;
 
-    if(NULL == irqCbFunction[IRQn])
+    if(0 <= IRQn && OS_MAX_IRQ > IRQn && NULL == irqCbFunction[IRQn] && (1UL << __NVIC_PRIO_BITS) > priority)
     {
         irqCbFunction[IRQn] = irqCbPointer;
+        #if ( OS_USE_RAM_VECTORS == 1 )
+            if(NULL == g_flashVectors)
+            {
+                irqRelocateVectors();
+            }
+            /* La IRQ se deshabilita antes de cambiar el vector por si estaba habilitada y pendiente */
+            NVIC_DisableIRQ(IRQn);
+            g_ramVectors[OS_IRQ_VECTOR_OFFSET + IRQn] = irqCbPointer;
+            __DSB();
+        #endif
+        NVIC_SetPriority(IRQn, priority);
         NVIC_ClearPendingIRQ(IRQn);
         NVIC_EnableIRQ(IRQn);
         retVal = OS_RESULT_OK;
@@ -64,17 +135,21 @@ osReturn_t irqAttach(IRQn_Type IRQn, irqCbFunction_t irqCbPointer)
 * @fn osReturn_t irqDetach(IRQn_Type IRQn)
 * @brief Desadjunta un callback a una dada interrupcion
 * @params IRQn : Numero de interrupcion
-* @return OS_RESULT_ERROR si NO habia un callback adjuntado, OS_RESULT_OK caso contrario
+* @return OS_RESULT_ERROR si la IRQ no existe o NO habia un callback adjuntado, OS_RESULT_OK caso contrario
 */
 osReturn_t irqDetach(IRQn_Type IRQn)
 {   
     osReturn_t retVal = OS_RESULT_ERROR;
 
-    if(NULL != irqCbFunction[IRQn])
+    if(0 <= IRQn && OS_MAX_IRQ > IRQn && NULL != irqCbFunction[IRQn])
     {
         irqCbFunction[IRQn] = NULL;
         NVIC_ClearPendingIRQ(IRQn);
         NVIC_DisableIRQ(IRQn);
+        #if ( OS_USE_RAM_VECTORS == 1 )
+            /* Volvemos al manejador original de la tabla */
+            g_ramVectors[OS_IRQ_VECTOR_OFFSET + IRQn] = g_flashVectors[OS_IRQ_VECTOR_OFFSET + IRQn];
+        #endif
         retVal = OS_RESULT_OK;
     }
 
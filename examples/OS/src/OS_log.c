@@ -0,0 +1,231 @@
+/**
+* @file  OS_log.c
+* @brief Log binario diferido
+* @note  OS_LOG() no formatea: encola la posicion del formato dentro de OS_LOG_SECTION y los argumentos
+         crudos, sin deshabilitar interrupciones. Varias tareas e IRQs, incluso anidadas, pueden encolar a
+         la vez: cada una reserva su lugar con un acceso exclusivo(LDREX/STREX) y lo marca como listo al
+         terminar de escribirlo. logRead() serializa los registros y tools/oslog_decode.py arma el texto
+         con los formatos del ELF
+* @note  Cada registro es una palabra de cabecera, (posicion del formato << 8) | OS_LOG_SYNC | cantidad
+         de argumentos, seguida de un uint32_t por argumento, todo en little endian
+* @note  Copyright 2019 - Esp. Ing. Matias Alvarez.
+*/
+
+/*==================[inclusions]=============================================*/
+#include "OS_log.h"
+#include "OS_port.h"
+#include <string.h>
+/*==================[macros]=================================================*/
+/**
+* @def LOG_MASK
+* @brief Mascara para obtener el lugar de la cola de registros a partir de un indice
+*/
+#define LOG_MASK                ( OS_LOG_QUEUE_LEN - 1 )
+
+/**
+* @def LOG_READY(index)
+* @brief Macro para evaluar si el registro del indice index ya fue escrito por su productor
+*/
+#define LOG_READY(index)        ( (index) + 1 == g_logQueue[(index) & LOG_MASK].seq )
+
+/**
+* @def LOG_NARGS(header)
+* @brief Macro para obtener la cantidad de argumentos de la cabecera de un registro
+*/
+#define LOG_NARGS(header)       ( (header) & 0x07 )
+/*==================[typedef]================================================*/
+#if ( OS_USE_LOG == 1 )
+/**
+* @struct logRecord_t
+* @brief Registro de log encolado
+*/
+typedef struct
+{
+    uint32_t            words[1 + OS_LOG_MAX_ARGS]; /**< Cabecera y argumentos - Se copian tal cual a logRead() */
+    volatile uint32_t   seq;                        /**< Indice del registro + 1 una vez escrito - Distingue cada vuelta de la cola */
+}logRecord_t;
+/*==================[internal data declaration]==============================*/
+/**
+* @var extern const char __start_os_log_fmt[]
+* @brief Comienzo de OS_LOG_SECTION - Lo define el linker
+*/
+extern const char __start_os_log_fmt[];
+
+/**
+* @var static logRecord_t g_logQueue[OS_LOG_QUEUE_LEN]
+* @brief Cola de registros
+*/
+static logRecord_t g_logQueue[OS_LOG_QUEUE_LEN];
+
+/**
+* @var static volatile uint32_t g_logHead
+* @brief Indice de escritura - Lo reservan los productores con LDREX/STREX
+*/
+static volatile uint32_t g_logHead;
+
+/**
+* @var static volatile uint32_t g_logTail
+* @brief Indice de lectura - Solo lo modifica logRead()
+*/
+static volatile uint32_t g_logTail;
+
+/**
+* @var static volatile uint32_t g_logDropped
+* @brief Cantidad de registros descartados por cola llena
+*/
+static volatile uint32_t g_logDropped;
+
+/**
+* @var static uint32_t g_logReported
+* @brief Cantidad de registros descartados ya informados en el log por logRead()
+*/
+static uint32_t g_logReported;
+
+/**
+* @var static volatile uint8_t g_logWaiting
+* @brief id de la tarea que espera en logRead(), OS_INVALID_TASK si no espera
+*/
+static volatile uint8_t g_logWaiting = OS_INVALID_TASK;
+
+/**
+* @var static const char g_logDroppedFmt[]
+* @brief Formato del registro con el que logRead() informa los registros descartados
+* @note Ademas garantiza que OS_LOG_SECTION exista aunque la aplicacion no use OS_LOG()
+*/
+static const char g_logDroppedFmt[] __attribute__((section(OS_LOG_SECTION))) =
+    "[log] %u registros descartados\n";
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+* @fn static bool logReady(const void * tail)
+* @brief Funcion que evalua si hay algo para logRead(): un registro listo o descartes sin informar
+* @param  tail : Puntero al indice de lectura
+* @return true si hay algo para leer, false caso contrario
+*/
+static bool logReady(const void * tail)
+{
+    return LOG_READY(*(const uint32_t *)tail) || g_logReported != g_logDropped;
+}
+
+/**
+* @fn static uint32_t logHeader(const char * fmt, uint32_t nargs)
+* @brief Funcion que arma la cabecera de un registro
+* @param  fmt   : Formato, dentro de OS_LOG_SECTION
+* @param  nargs : Cantidad de argumentos
+* @return Cabecera del registro
+*/
+static uint32_t logHeader(const char * fmt, uint32_t nargs)
+{
+    return ((uint32_t)(fmt - __start_os_log_fmt) << 8) | OS_LOG_SYNC | nargs;
+}
+/*==================[external functions definition]==========================*/
+/**
+* @fn osReturn_t logWrite(const char * fmt, uint32_t nargs, const uint32_t * args)
+* @brief Funcion que encola un registro de log
+* @param  fmt   : Formato, dentro de OS_LOG_SECTION
+* @param  nargs : Cantidad de argumentos - Hasta OS_LOG_MAX_ARGS
+* @param  args  : Argumentos
+* @return OS_RESULT_ERROR si sobran argumentos o la cola de registros esta llena y el registro se descarta,
+          OS_RESULT_OK caso contrario
+* @note No deshabilita interrupciones. Si hay una tarea esperando en logRead(), se la despierta
+        en diferido a traves de la pendSV
+* @warning NO DEBE SER USADA POR EL USUARIO - Usar OS_LOG()
+*/
+osReturn_t logWrite(const char * fmt, uint32_t nargs, const uint32_t * args)
+{
+    uint32_t      head;         /**< Indice reservado */
+    uint32_t      i;
+    logRecord_t * record;       /**< Lugar reservado */
+
+    if(OS_LOG_MAX_ARGS < nargs)
+    {
+        return OS_RESULT_ERROR;
+    }
+
+    if(OS_RESULT_OK != osReserveSlot(&g_logHead, &g_logTail, LOG_MASK, &g_logDropped, &head))
+    {
+        return OS_RESULT_ERROR;
+    }
+
+    record = &g_logQueue[head & LOG_MASK];
+    record->words[0] = logHeader(fmt, nargs);
+    for(i = 0; i < nargs; i++)
+    {
+        record->words[1 + i] = args[i];
+    }
+    /* Marcamos el registro como listo y despertamos a la tarea de logRead() si espera */
+    osPublishAndWake(&record->seq, head + 1, &g_logWaiting);
+
+    return OS_RESULT_OK;
+}
+
+/**
+* @fn uint32_t logRead(uint8_t * buffer, uint32_t size, tick_t delay)
+* @brief Funcion que saca de la cola los registros de log y los serializa en buffer
+* @param  buffer : Porcion de memoria donde se copian los registros
+* @param  size   : Tamaño de buffer - Al menos OS_LOG_RECORD_MAX_SIZE
+* @param  delay  : Tiempo a esperar a que haya un registro en la cola
+* @return Cantidad de bytes copiados, siempre registros completos. 0 si expira el delay sin registros
+* @note Si se descartaron registros desde la ultima lectura, primero agrega un registro que lo informa
+* @note Un unico lector. Los bytes se envian tal cual, por ejemplo por la UART, a tools/oslog_decode.py
+* @danger Desde IRQ o Idle Task con delay 0
+*/
+uint32_t logRead(uint8_t * buffer, uint32_t size, tick_t delay)
+{
+    uint32_t   tail = g_logTail;    /**< Indice de lectura */
+    uint32_t   len = 0;             /**< Bytes copiados */
+    uint32_t   recordSize;          /**< Tamaño del proximo registro */
+    uint32_t   words[2];            /**< Registro de descartados */
+
+    /* Esperamos registros en la cola o descartes sin informar. Si expira el delay, no hay nada que copiar */
+    osWaitForProducer(&g_logWaiting, logReady, &tail, delay);
+
+    if(g_logReported != g_logDropped && sizeof(words) <= size)
+    {
+        words[1] = g_logDropped - g_logReported;
+        words[0] = logHeader(g_logDroppedFmt, 1);
+        g_logReported += words[1];
+        memcpy(buffer, words, sizeof(words));
+        len = sizeof(words);
+    }
+
+    /* Copiamos los registros listos por orden de llegada mientras entren completos. Si un productor
+       reservo un lugar y aun no lo escribio, los siguientes esperan aunque ya esten listos */
+    while(LOG_READY(tail))
+    {
+        /* El registro se lee despues de ver su indice */
+        __DMB();
+        recordSize = (1 + LOG_NARGS(g_logQueue[tail & LOG_MASK].words[0])) * sizeof(uint32_t);
+        if(size - len < recordSize)
+        {
+            break;
+        }
+        memcpy(&buffer[len], g_logQueue[tail & LOG_MASK].words, recordSize);
+        len += recordSize;
+        /* Terminamos de leer antes de liberar el lugar */
+        __DMB();
+        tail++;
+        g_logTail = tail;
+    }
+
+    return len;
+}
+
+/**
+* @fn uint32_t logGetDropped(void)
+* @brief Funcion que devuelve la cantidad de registros descartados por cola llena
+* @param  Ninguno
+* @return Cantidad de registros descartados
+* @note Permite dimensionar OS_LOG_QUEUE_LEN
+*/
+uint32_t logGetDropped(void)
+{
+    return g_logDropped;
+}
+#endif
+/*==================[end of file]============================================*/
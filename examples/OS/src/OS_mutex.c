@@ -0,0 +1,162 @@
+/** 
+* @file  OS_mutex.c
+* @brief 
+* @note  Copyright 2019 - Esp. Ing. Matias Alvarez.
+*/
+
+/*==================[inclusions]=============================================*/
+#include "OS_mutex.h"
+/*==================[macros]=================================================*/
+
+/*==================[typedef]================================================*/
+
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+
+/*==================[external functions definition]==========================*/
+#if ( OS_USE_MUTEX == 1 )
+/**
+* @fn void mutexInit(mutex_t * mutex)
+* @brief Funcion que inicializa un mutex libre
+* @param  mutex : Puntero a la estructura del mutex a inicializar
+* @return Nada
+*/
+void mutexInit(mutex_t * mutex)
+{
+
+    mutex->owner = OS_INVALID_TASK;
+    mutex->lockCount = 0;
+    waitListInit(&(mutex->waitList));
+
+}
+
+/**
+* @fn osReturn_t mutexLock(mutex_t * mutex, tick_t delay)
+* @brief Funcion que toma un mutex
+* @param  mutex : Puntero a la estructura del mutex a tomar
+* @param  delay : Tiempo maximo de espera hasta la liberacion del mutex
+* @return OS_RESULT_OK si se pudo tomar el mutex,
+          OS_RESULT_ERROR si expiro el delay sin que se liberase el mutex
+* @note La tarea duenia puede volver a tomar el mutex, debiendo liberarlo la misma cantidad de veces
+* @note Mientras la tarea espera, la tarea duenia hereda su prioridad si esta es mayor, 
+        evitando que tareas de prioridad intermedia demoren la liberacion del mutex
+* @danger Desde IRQ o Idle Task con delay 0
+*/
+osReturn_t mutexLock(mutex_t * mutex, tick_t delay)
+{
+    osReturn_t retVal = OS_RESULT_ERROR;
+    uint8_t    task;    /**< Tarea que toma el mutex */
+
+    if(NULL != mutex)
+    {
+        /* Suspendemos cambio de contexto porque estamos manipulando variables globales */
+        osSuspendContextSwitching();
+
+        task = osGetCurrentTask();
+
+        /* Si esta libre lo tomamos */
+        if(OS_INVALID_TASK == mutex->owner)
+        {
+            mutex->owner = task;
+            mutex->lockCount = 1;
+            taskIncrementMutexHeldCount(task);
+            retVal = OS_RESULT_OK;
+        }
+        /* Si ya lo tenemos tomado lo volvemos a tomar */
+        else if(task == mutex->owner)
+        {
+            mutex->lockCount++;
+            retVal = OS_RESULT_OK;
+        }
+        /* Si no, esperamos */
+        else
+        {
+            /* Si vamos a bloquearnos, la tarea duenia hereda nuestra prioridad */
+            if(0 < delay)
+            {
+                taskPriorityInherit(mutex->owner, taskGetPriority(task));
+            }
+            /* Si nos despertaron, mutexUnlock() ya nos transfirio el mutex */
+            retVal = taskBlockOnWaitList(&(mutex->waitList), delay);
+        }
+
+        /* Volvemos a permitir el cambio de contexto */
+        osResumeContextSwitching();
+    }
+
+    return retVal;
+}
+
+/**
+* @fn osReturn_t mutexUnlock(mutex_t * mutex)
+* @brief Funcion que libera un mutex
+* @param  mutex : Puntero a la estructura del mutex a liberar
+* @return OS_RESULT_OK si se libero el mutex,
+          OS_RESULT_ERROR si la tarea actual no es la duenia del mutex
+* @note Al liberarlo por ultima vez la tarea recupera su prioridad original y el mutex 
+        se transfiere directamente a la tarea en espera de mayor prioridad
+*/
+osReturn_t mutexUnlock(mutex_t * mutex)
+{
+    osReturn_t retVal = OS_RESULT_ERROR;
+    uint8_t    task;            /**< Tarea que libera el mutex */
+    uint8_t    next;            /**< Tarea a la que se transfiere el mutex */
+    uint8_t    yield = 0;       /**< Indica si se debe llamar al scheduler */
+
+    if(NULL != mutex)
+    {
+        /* Suspendemos cambio de contexto porque estamos manipulando variables globales */
+        osSuspendContextSwitching();
+
+        task = osGetCurrentTask();
+
+        if(task == mutex->owner)
+        {
+            retVal = OS_RESULT_OK;
+            mutex->lockCount--;
+
+            /* Si es la ultima liberacion */
+            if(0 == mutex->lockCount)
+            {
+                /* Recuperamos la prioridad original si ya no tenemos mutex tomados */
+                yield = taskPriorityDisinherit(task);
+
+                /* Transferimos el mutex a la tarea en espera de mayor prioridad */
+                next = taskWakeFromWaitList(&(mutex->waitList));
+                mutex->owner = next;
+
+                if(OS_INVALID_TASK != next)
+                {
+                    mutex->lockCount = 1;
+                    taskIncrementMutexHeldCount(next);
+                    /* La nueva duenia hereda la prioridad de las tareas que siguen esperando */
+                    if(OS_INVALID_TASK != mutex->waitList.head)
+                    {
+                        taskPriorityInherit(next, taskGetPriority(mutex->waitList.head));
+                    }
+                    yield = 1;
+                }
+            }
+        }
+
+        /* Volvemos a permitir el cambio de contexto */
+        osResumeContextSwitching();
+
+        if(yield)
+        {
+            taskYield();
+        }
+    }
+
+    return retVal;
+}
+
+#endif
+/*==================[end of file]============================================*/
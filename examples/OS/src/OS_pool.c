@@ -0,0 +1,282 @@
+/**
+* @file  OS_pool.c
+* @brief Pools de bloques de memoria de tamaño fijo
+* @note  Reservar y liberar un bloque es O(1): los bloques libres forman una lista enlazada a traves
+         de su primera palabra. Al liberar un bloque con tareas a la espera, se entrega directamente
+         a la de mayor prioridad
+* @note  Copyright 2019 - Esp. Ing. Matias Alvarez.
+*/
+
+/*==================[inclusions]=============================================*/
+#include "OS_pool.h"
+/*==================[macros]=================================================*/
+
+/*==================[typedef]================================================*/
+
+/*==================[internal data declaration]==============================*/
+#if ( OS_USE_POOL == 1 )
+/**
+* @var static void * g_poolWaiterBlock[OS_MAX_TASK + 1]
+* @brief Bloque entregado por poolFree() a cada tarea en espera, por id de tarea
+* @note Una tarea solo puede estar bloqueada en un objeto a la vez, por lo que alcanza con
+        un lugar por tarea en lugar de uno por pool
+*/
+static void * g_poolWaiterBlock[OS_MAX_TASK + 1];
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+* @fn static void * poolPop(pool_t * pool)
+* @brief Funcion que saca el primer bloque de la lista de bloques libres
+* @param  pool : Puntero al pool
+* @return Puntero al bloque, NULL si no hay bloques libres
+* @note Debe ser llamada con el cambio de contexto suspendido
+*/
+static void * poolPop(pool_t * pool)
+{
+    void * block = pool->freeList;  /**< Bloque reservado */
+
+    if(NULL != block)
+    {
+        pool->freeList = *((void **)block);
+        pool->freeCount--;
+
+        if(pool->blockCount - pool->freeCount > pool->highWater)
+        {
+            pool->highWater = pool->blockCount - pool->freeCount;
+        }
+    }
+
+    return block;
+}
+
+/**
+* @fn static bool poolOwns(pool_t * pool, void * block)
+* @brief Funcion que evalua si un puntero es el comienzo de un bloque del pool
+* @param  pool  : Puntero al pool
+* @param  block : Puntero a evaluar
+* @return true si el puntero es un bloque del pool, false caso contrario
+*/
+static bool poolOwns(pool_t * pool, void * block)
+{
+    uint8_t * ptr = (uint8_t *)block;
+
+    return (pool->buffer <= ptr && ptr < pool->buffer + (pool->blockSize * pool->blockCount) &&
+            0 == (uint32_t)(ptr - pool->buffer) % pool->blockSize);
+}
+
+/**
+* @fn static uint8_t poolRelease(pool_t * pool, void * block)
+* @brief Funcion que entrega un bloque a la tarea en espera de mayor prioridad o lo devuelve a la lista de bloques libres
+* @param  pool  : Puntero al pool
+* @param  block : Puntero al bloque
+* @return id de la tarea despertada, OS_INVALID_TASK si no habia tareas a la espera
+* @note Debe ser llamada con el cambio de contexto suspendido
+*/
+static uint8_t poolRelease(pool_t * pool, void * block)
+{
+    uint8_t id = pool->waitList.head;   /**< Tarea a la que se entrega el bloque */
+
+    if(OS_INVALID_TASK != id)
+    {
+        /* El bloque nunca vuelve a la lista de bloques libres, por lo que las estadisticas no cambian */
+        g_poolWaiterBlock[id] = block;
+        taskWakeFromWaitList(&(pool->waitList));
+    }
+    else
+    {
+        *((void **)block) = pool->freeList;
+        pool->freeList = block;
+        pool->freeCount++;
+    }
+
+    return id;
+}
+/*==================[external functions definition]==========================*/
+/**
+* @fn osReturn_t poolInit(pool_t * pool, void * buffer, uint32_t blockSize, uint32_t blockCount)
+* @brief Funcion que inicializa un pool con todos sus bloques libres
+* @param  pool       : Puntero al pool
+* @param  buffer     : Memoria de los bloques, de blockSize * blockCount bytes y alineada a sizeof(void *)
+* @param  blockSize  : Tamaño en bytes de cada bloque - Multiplo de sizeof(void *), ver POOL_BLOCK_SIZE()
+* @param  blockCount : Cantidad de bloques - Mayor a 0
+* @return OS_RESULT_ERROR si el tamaño de bloque o la cantidad de bloques no son validos, OS_RESULT_OK caso contrario
+*/
+osReturn_t poolInit(pool_t * pool, void * buffer, uint32_t blockSize, uint32_t blockCount)
+{
+    osReturn_t retVal = OS_RESULT_ERROR;
+    uint32_t   i;
+
+    if(NULL != buffer && 0 < blockCount && 0 < blockSize && 0 == blockSize % sizeof(void *))
+    {
+        pool->buffer     = (uint8_t *)buffer;
+        pool->blockSize  = blockSize;
+        pool->blockCount = blockCount;
+        pool->freeCount  = blockCount;
+        pool->highWater  = 0;
+        pool->freeList   = NULL;
+        waitListInit(&(pool->waitList));
+
+        /* Encadenamos los bloques de atras hacia adelante para que se reserven por orden de direccion */
+        for(i = blockCount; 0 < i; i--)
+        {
+            *((void **)(pool->buffer + (i - 1) * blockSize)) = pool->freeList;
+            pool->freeList = pool->buffer + (i - 1) * blockSize;
+        }
+
+        retVal = OS_RESULT_OK;
+    }
+
+    return retVal;
+}
+
+/**
+* @fn void * poolAlloc(pool_t * pool, tick_t delay)
+* @brief Funcion que reserva un bloque de un pool
+* @param  pool  : Puntero al pool
+* @param  delay : Tiempo maximo de espera de un bloque libre
+* @return Puntero al bloque, NULL si expiro el delay sin que se liberase un bloque
+* @note Varias tareas pueden esperar el mismo pool, se les entregan los bloques por orden de prioridad
+* @danger Desde IRQ o Idle Task con delay 0
+*/
+void * poolAlloc(pool_t * pool, tick_t delay)
+{
+    void *  block;
+    uint8_t id;
+
+    /* Suspendemos cambio de contexto porque estamos manipulando variables globales */
+    osSuspendContextSwitching();
+
+    block = poolPop(pool);
+
+    if(NULL == block)
+    {
+        id = osGetCurrentTask();
+        /* Si al volver de la espera nos despertaron, poolFree() ya nos entrego un bloque */
+        if(OS_RESULT_OK == taskBlockOnWaitList(&(pool->waitList), delay))
+        {
+            block = g_poolWaiterBlock[id];
+        }
+    }
+
+    /* Volvemos a permitir el cambio de contexto */
+    osResumeContextSwitching();
+
+    return block;
+}
+
+/**
+* @fn void * poolAllocFromISR(pool_t * pool)
+* @brief Funcion que reserva un bloque de un pool desde una IRQ, sin esperar
+* @param  pool : Puntero al pool
+* @return Puntero al bloque, NULL si no hay bloques libres
+*/
+void * poolAllocFromISR(pool_t * pool)
+{
+    void *   block;
+    uint32_t mask;
+
+    mask = osSuspendContextSwitchingFromISR();
+    block = poolPop(pool);
+    osResumeContextSwitchingFromISR(mask);
+
+    return block;
+}
+
+/**
+* @fn osReturn_t poolFree(pool_t * pool, void * block)
+* @brief Funcion que libera un bloque de un pool
+* @param  pool  : Puntero al pool
+* @param  block : Puntero al bloque, obtenido con poolAlloc() o poolAllocFromISR()
+* @return OS_RESULT_ERROR si el puntero no es un bloque del pool, OS_RESULT_OK caso contrario
+* @note Si hay tareas a la espera, el bloque se entrega directamente a la de mayor prioridad
+* @danger Liberar dos veces el mismo bloque corrompe la lista de bloques libres
+*/
+osReturn_t poolFree(pool_t * pool, void * block)
+{
+    osReturn_t retVal = OS_RESULT_ERROR;
+    uint8_t    woken = OS_INVALID_TASK;
+
+    if(poolOwns(pool, block))
+    {
+        /* Suspendemos cambio de contexto porque estamos manipulando variables globales */
+        osSuspendContextSwitching();
+        woken = poolRelease(pool, block);
+        /* Volvemos a permitir el cambio de contexto */
+        osResumeContextSwitching();
+
+        if(OS_INVALID_TASK != woken)
+        {
+            /* Llamamos al scheduler por si la tarea despertada es de mayor prioridad */
+            taskYield();
+        }
+
+        retVal = OS_RESULT_OK;
+    }
+
+    return retVal;
+}
+
+/**
+* @fn osReturn_t poolFreeFromISR(pool_t * pool, void * block)
+* @brief Funcion que libera un bloque de un pool desde una IRQ
+* @param  pool  : Puntero al pool
+* @param  block : Puntero al bloque, obtenido con poolAlloc() o poolAllocFromISR()
+* @return OS_RESULT_ERROR si el puntero no es un bloque del pool, OS_RESULT_OK caso contrario
+* @note Nunca llama al scheduler dentro de la IRQ: si despierta una tarea solo deja
+        pendiente el cambio de contexto para la salida de la IRQ
+*/
+osReturn_t poolFreeFromISR(pool_t * pool, void * block)
+{
+    osReturn_t retVal = OS_RESULT_ERROR;
+    uint8_t    woken = OS_INVALID_TASK;
+    uint32_t   mask;
+
+    if(poolOwns(pool, block))
+    {
+        mask = osSuspendContextSwitchingFromISR();
+        woken = poolRelease(pool, block);
+        osResumeContextSwitchingFromISR(mask);
+
+        if(OS_INVALID_TASK != woken)
+        {
+            /* Dejamos pendiente el cambio de contexto para la salida de la IRQ */
+            taskYieldFromISR();
+        }
+
+        retVal = OS_RESULT_OK;
+    }
+
+    return retVal;
+}
+
+/**
+* @fn uint32_t poolGetFree(pool_t * pool)
+* @brief Funcion que devuelve la cantidad de bloques libres de un pool
+* @param  pool : Puntero al pool
+* @return Cantidad de bloques libres
+* @note Puede llamarse desde una IRQ
+*/
+uint32_t poolGetFree(pool_t * pool)
+{
+    return pool->freeCount;
+}
+
+/**
+* @fn uint32_t poolGetHighWater(pool_t * pool)
+* @brief Funcion que devuelve la maxima cantidad de bloques de un pool reservados a la vez desde su inicializacion
+* @param  pool : Puntero al pool
+* @return Maxima cantidad de bloques reservados a la vez
+* @note Permite dimensionar blockCount: si alcanza blockCount hubo reservas que esperaron o fallaron
+* @note Puede llamarse desde una IRQ
+*/
+uint32_t poolGetHighWater(pool_t * pool)
+{
+    return pool->highWater;
+}
+#endif
+/*==================[end of file]============================================*/
@@ -0,0 +1,140 @@
+/**
+* @file  OS_port.c
+* @brief Port del SO para Cortex-M4(LPC4337)
+* @note  El cambio de contexto se realiza en PendSVHandler.S
+* @note  Copyright 2019 - Esp. Ing. Matias Alvarez.
+*/
+
+/*==================[inclusions]=============================================*/
+#include "OS_port.h"
+#include <strings.h>
+/*==================[macros]=================================================*/
+/**
+* @def EXC_RETURN
+* @var Valor de retorno de interrupcion
+*/
+#define EXC_RETURN          0xFFFFFFF9
+/*==================[typedef]================================================*/
+
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+
+/*==================[external functions definition]==========================*/
+/**
+* @fn uint32_t osPortInitStack(uint8_t taskId, uint32_t * stack, uint32_t stackSize, taskFunction_t taskFx,
+                         void * parameters, void (*returnHook)(void))
+* @brief Funcion que arma el contexto inicial de una tarea en su stack
+* @param taskId     : id de la tarea - No se usa en este port
+* @param stack      : Puntero al stack de la tarea
+* @param stackSize  : Tamaño del stack de la tarea
+* @param taskFx     : Prototipo de la tarea
+* @param parameters : Puntero a los parametros a pasarle a la tarea
+* @param returnHook : Funcion a ejecutarse si la tarea retorna
+* @return Stack pointer inicial de la tarea
+* @warning NO DEBE SER USADA POR EL USUARIO
+*/
+uint32_t osPortInitStack(uint8_t taskId, uint32_t * stack, uint32_t stackSize, taskFunction_t taskFx,
+                         void * parameters, void (*returnHook)(void))
+{
+    /* Inicializo el frame en cero - El resto del stack conserva el patron de pintado */
+    bzero(&(stack[stackSize/4 - 17]), 17 * sizeof(uint32_t));
+
+    /* Ultimo elemento del contexto inicial: xPSR
+     * Necesita el bit 24 (T, modo Thumb) en 1
+     */
+    stack[stackSize/4 - 1]  = 1 << 24;
+
+    /* Anteultimo elemento: PC (entry point) */
+    stack[stackSize/4 - 2]  = (uint32_t)taskFx;
+
+    /* Penultimo elemento: LR (return hook) */
+    stack[stackSize/4 - 3]  = (uint32_t)returnHook;
+
+    /* Elemento -8: R0 (parámetro) */
+    stack[stackSize/4 - 8]  = (uint32_t)parameters;
+
+    stack[stackSize/4 - 9]  = EXC_RETURN;
+
+    /* Stack pointer inicial considerando lo otros 8 registros pusheados */
+    return (uint32_t)&(stack[stackSize/4 - 17]);
+}
+
+/**
+* @fn void osPortStartTick(uint32_t tickRateHz)
+* @brief Funcion que configura la pendSV y arranca el tick del sistema
+* @param tickRateHz : Frecuencia del tick del sistema
+* @return Nada
+* @warning NO DEBE SER USADA POR EL USUARIO
+*/
+void osPortStartTick(uint32_t tickRateHz)
+{
+    /* PendSV con menor prioridad posible */
+    NVIC_SetPriority(PendSV_IRQn, (1 << __NVIC_PRIO_BITS) - 1);
+
+    SysTick_Config(SystemCoreClock / tickRateHz);
+}
+
+/**
+* @fn void osPortCycleCounterInit(void)
+* @brief Funcion que habilita el contador de ciclos del DWT
+* @param Ninguno
+* @return Nada
+* @warning NO DEBE SER USADA POR EL USUARIO
+*/
+void osPortCycleCounterInit(void)
+{
+    /* Habilitamos el bloque de trazas y el contador de ciclos */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+#if ( OS_USE_MPU_STACK_GUARD == 1 )
+    /**
+    * @fn void osPortStackGuardInit(void)
+    * @brief Funcion que habilita el MPU y el MemManage fault
+    * @param Ninguno
+    * @return Nada
+    * @note Con PRIVDEFENA los accesos privilegiados usan el mapa de memoria por defecto,
+            por lo que la unica region que restringe accesos es la guarda del stack
+    * @warning NO DEBE SER USADA POR EL USUARIO
+    */
+    void osPortStackGuardInit(void)
+    {
+        /* El desborde se reporta como MemManage fault y no escala a HardFault */
+        SCB->SHCSR |= SCB_SHCSR_MEMFAULTENA_Msk;
+
+        MPU->CTRL = MPU_CTRL_PRIVDEFENA_Msk | MPU_CTRL_ENABLE_Msk;
+        __DSB();
+        __ISB();
+    }
+
+    /**
+    * @fn void osPortStackGuardSet(uint32_t * stack)
+    * @brief Funcion que mueve la region de guarda a la base del stack de una tarea
+    * @param stack : Puntero al stack de la tarea
+    * @return Nada
+    * @note La region debe estar alineada a su tamaño, por lo que se ubica en los primeros
+            OS_PORT_STACK_GUARD_SIZE bytes alineados del stack
+    * @warning NO DEBE SER USADA POR EL USUARIO - La llama el scheduler en cada cambio de contexto
+    */
+    void osPortStackGuardSet(uint32_t * stack)
+    {
+        uint32_t base = ((uint32_t)stack + OS_PORT_STACK_GUARD_SIZE - 1) & ~(OS_PORT_STACK_GUARD_SIZE - 1);
+
+        /* Con VALID, RBAR tambien selecciona la region */
+        MPU->RBAR = base | MPU_RBAR_VALID_Msk | OS_PORT_STACK_GUARD_REGION;
+        /* Sin acceso(AP = 0), sin ejecucion, tamaño 2^(SIZE + 1) bytes */
+        MPU->RASR = MPU_RASR_XN_Msk | ((5 - 1) << MPU_RASR_SIZE_Pos) | MPU_RASR_ENABLE_Msk;
+        __DSB();
+        __ISB();
+    }
+#endif
+/*==================[end of file]============================================*/
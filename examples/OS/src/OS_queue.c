@@ -25,6 +25,20 @@
 * @brief Macro para mover alguno de los dos punteros(lectura o escritura)
 */
 #define QUEUE_MOVE_PTR(ptr, queueLen) (ptr = (ptr + 1) % queueLen)
+
+/**
+* @def QUEUE_NO_SPACE(q)
+* @brief Macro para detectar si no hay lugar disponible para escribir: la cola esta llena 
+         o el lugar libre esta reservado con queueReserve()
+*/
+#define QUEUE_NO_SPACE(q) (QUEUE_IS_FULL(q) || q->writeReserved)
+
+/**
+* @def QUEUE_NO_DATA(q)
+* @brief Macro para detectar si no hay elementos disponibles para leer: la cola esta vacia 
+         o el primer elemento esta tomado con queuePeek()
+*/
+#define QUEUE_NO_DATA(q) (QUEUE_IS_EMPTY(q) || q->readReserved)
 /*==================[typedef]================================================*/
 
 /*==================[internal data declaration]==============================*/
@@ -57,6 +71,8 @@ void queueInit(queue_t * q, uint32_t queueLen, uint8_t * dataBuffer, uint32_t da
     q->queueLen = queueLen;
     q->data = dataBuffer;
     q->dataSize = dataSize;
+    q->writeReserved = false;
+    q->readReserved = false;
     semphrInit(&(q->queuePushSem));
     semphrInit(&(q->queuePullSem));
 }
@@ -69,24 +85,25 @@ void queueInit(queue_t * q, uint32_t queueLen, uint8_t * dataBuffer, uint32_t da
 * @params delay : Tiempo a esperar a que se desocupe un lugar en la cola
 * @return OS_RESULT_OK si se pudo agregar el elemento,
           OS_RESULT_ERROR si expira el delay antes de poder agregar el elemento
+* @note Varias tareas pueden esperar lugar en la misma cola. Al despertar se vuelve a verificar
+        el lugar, ya que otra tarea de mayor prioridad pudo haberlo ocupado antes, y se espera solo
+        lo que resta de delay
 * @danger Desde IRQ o Idle Task con delay 0
 */
 osReturn_t queuePush(queue_t * q, void * data, tick_t delay)
 {
-    osReturn_t retVal = OS_RESULT_ERROR;
+    osReturn_t retVal = OS_RESULT_OK;
+    tick_t     start = taskGetTickCount();   /**< Tick de entrada, desde el que se cuenta delay */
 
     /* Suspendemos cambio de contexto porque estamos manipulando variables globales */
     osSuspendContextSwitching();
-    /* Si la cola esta llena */
-    if(QUEUE_IS_FULL(q))
+    /* Mientras la cola este llena */
+    while(OS_RESULT_OK == retVal && QUEUE_NO_SPACE(q))
     {
         /* Esperamos a que se desocupe un lugar */
-        retVal = semphrTake(&(q->queuePushSem), delay);
-        
-    }
-    else
-    {
-        retVal = OS_RESULT_OK;
+        osResumeContextSwitching();
+        retVal = semphrTake(&(q->queuePushSem), taskRemainingDelay(start, delay));
+        osSuspendContextSwitching();
     }
 
     /* Si hay un lugar libre */
@@ -96,13 +113,17 @@ osReturn_t queuePush(queue_t * q, void * data, tick_t delay)
         memcpy(&(q->data[q->writePtr * q->dataSize]), data, q->dataSize);
         /* Movemos el puntero un elemento mas */
         QUEUE_MOVE_PTR(q->writePtr, q->queueLen);
+    }
+
+    osResumeContextSwitching();
+
+    if(OS_RESULT_OK == retVal)
+    {
         /* Liberamos el semaforo indicando que hay un elemento por si existe
            alguna otra tarea esperando que haya un elemento en la cola */
         semphrGive(&(q->queuePullSem));
     }
 
-    osResumeContextSwitching();
-
     return retVal;
 
 }
@@ -115,24 +136,25 @@ osReturn_t queuePush(queue_t * q, void * data, tick_t delay)
 * @params delay : Tiempo a esperar a que haya un elemento en la cola
 * @return OS_RESULT_OK si se pudo obtener el elemento,
           OS_RESULT_ERROR si expira el delay antes de poder obtener el elemento
+* @note Varias tareas pueden esperar elementos de la misma cola. Al despertar se vuelve a verificar
+        que haya elementos, ya que otra tarea de mayor prioridad pudo haberlos tomado antes, y se
+        espera solo lo que resta de delay
 * @danger Desde IRQ o Idle Task con delay 0
 */
 osReturn_t queuePull(queue_t * q, void * data, tick_t delay)
 {
-    osReturn_t retVal = OS_RESULT_ERROR;
+    osReturn_t retVal = OS_RESULT_OK;
+    tick_t     start = taskGetTickCount();   /**< Tick de entrada, desde el que se cuenta delay */
 
     /* Suspendemos cambio de contexto porque estamos manipulando variables globales */
     osSuspendContextSwitching();
-    /* Si no hay elementos en la cola */
-    if(QUEUE_IS_EMPTY(q))
+    /* Mientras no haya elementos en la cola */
+    while(OS_RESULT_OK == retVal && QUEUE_NO_DATA(q))
     {
         /* Esperamos a que haya un elemento */
-        retVal = semphrTake(&(q->queuePullSem), delay);
-    
-    }
-    else
-    {
-        retVal = OS_RESULT_OK;
+        osResumeContextSwitching();
+        retVal = semphrTake(&(q->queuePullSem), taskRemainingDelay(start, delay));
+        osSuspendContextSwitching();
     }
     
     /* Si hay al menos un elemento en la cola */
@@ -142,104 +164,256 @@ osReturn_t queuePull(queue_t * q, void * data, tick_t delay)
         memcpy(data, &(q->data[q->readPtr * q->dataSize]), q->dataSize);
         /* Movemos el puntero un elementos mas */
         QUEUE_MOVE_PTR(q->readPtr, q->queueLen);
+    }
+
+    osResumeContextSwitching();
+
+    if(OS_RESULT_OK == retVal)
+    {
         /* Liberamos el semaforo indicando que hay un lugar en la cola por si existe
            alguna otra tarea esperando que haya espacio en la misma */
         semphrGive(&(q->queuePushSem));
     }
 
-    osResumeContextSwitching();
-
     return retVal;
 }
 
 /*
-* @fn osReturn_t queuePush(queue_t * q, void * data, tick_t delay)
-* @brief Agrega un elemento al final de una cola
+* @fn osReturn_t queuePushFromISR(queue_t * q, void * data)
+* @brief Agrega un elemento al final de una cola desde una IRQ, sin esperar
 * @params q     : Puntero a la cola
 * @params data  : Puntero al elemento a agregar a la cola
-* @params delay : Tiempo a esperar a que se desocupe un lugar en la cola
 * @return OS_RESULT_OK si se pudo agregar el elemento,
-          OS_RESULT_ERROR si expira el delay antes de poder agregar el elemento
-* @danger Desde IRQ o Idle Task con delay 0
+          OS_RESULT_ERROR si la cola esta llena
 */
 osReturn_t queuePushFromISR(queue_t * q, void * data)
 {
     osReturn_t retVal = OS_RESULT_ERROR;
+    uint32_t   mask;
+
+    /* Suspendemos cambio de contexto porque estamos manipulando variables globales */
+    mask = osSuspendContextSwitchingFromISR();
+
+    /* Si hay un lugar libre */
+    if(!QUEUE_NO_SPACE(q))
+    {
+        /* Agregamos el elemento */
+        memcpy(&(q->data[q->writePtr * q->dataSize]), data, q->dataSize);
+        /* Movemos el puntero un elemento mas */
+        QUEUE_MOVE_PTR(q->writePtr, q->queueLen);
+        retVal = OS_RESULT_OK;
+    }
+
+    osResumeContextSwitchingFromISR(mask);
+
+    if(OS_RESULT_OK == retVal)
+    {
+        /* Liberamos el semaforo indicando que hay un elemento por si existe
+           alguna otra tarea esperando que haya un elemento en la cola */
+        semphrGiveFromISR(&(q->queuePullSem));
+    }
+
+    return retVal;
+
+}
+
+/*
+* @fn osReturn_t queuePullFromISR(queue_t * q, void * data)
+* @brief Obtiene un elemento del principio de una cola desde una IRQ, sin esperar
+* @params q     : Puntero a la cola
+* @params data  : Porcion de memoria donde se guarda un elemento de la cola
+* @return OS_RESULT_OK si se pudo obtener el elemento,
+          OS_RESULT_ERROR si la cola esta vacia
+*/
+osReturn_t queuePullFromISR(queue_t * q, void * data)
+{
+    osReturn_t retVal = OS_RESULT_ERROR;
+    uint32_t   mask;
+
+    /* Suspendemos cambio de contexto porque estamos manipulando variables globales */
+    mask = osSuspendContextSwitchingFromISR();
+
+    /* Si hay al menos un elemento en la cola */
+    if(!QUEUE_NO_DATA(q))
+    {
+        /* Obtenemos el elemento */
+        memcpy(data, &(q->data[q->readPtr * q->dataSize]), q->dataSize);
+        /* Movemos el puntero un elementos mas */
+        QUEUE_MOVE_PTR(q->readPtr, q->queueLen);
+        retVal = OS_RESULT_OK;
+    }
+
+    osResumeContextSwitchingFromISR(mask);
+
+    if(OS_RESULT_OK == retVal)
+    {
+        /* Liberamos el semaforo indicando que hay un lugar en la cola por si existe
+           alguna otra tarea esperando que haya espacio en la misma */
+        semphrGiveFromISR(&(q->queuePushSem));
+    }
+
+    return retVal;
+}
+
+/*
+* @fn osReturn_t queueReserve(queue_t * q, void ** slot, tick_t delay)
+* @brief Reserva el lugar del final de una cola para construir el elemento directamente en la misma
+* @params q     : Puntero a la cola
+* @params slot  : Donde se guarda el puntero al lugar reservado dentro del buffer de la cola
+* @params delay : Tiempo a esperar a que se desocupe un lugar en la cola
+* @return OS_RESULT_OK si se pudo reservar el lugar,
+          OS_RESULT_ERROR si expira el delay antes de poder reservarlo
+* @note El elemento recien es visible para los consumidores luego de queueCommit()
+* @note Hay una unica reserva por cola: mientras tanto el resto de los productores esperan
+* @danger Desde IRQ o Idle Task con delay 0
+*/
+osReturn_t queueReserve(queue_t * q, void ** slot, tick_t delay)
+{
+    osReturn_t retVal = OS_RESULT_OK;
+    tick_t     start = taskGetTickCount();   /**< Tick de entrada, desde el que se cuenta delay */
 
     /* Suspendemos cambio de contexto porque estamos manipulando variables globales */
     osSuspendContextSwitching();
-    /* Si la cola esta llena */
-    if(QUEUE_IS_FULL(q))
+    /* Mientras no haya lugar disponible */
+    while(OS_RESULT_OK == retVal && QUEUE_NO_SPACE(q))
     {
         /* Esperamos a que se desocupe un lugar */
-        retVal = semphrTakeFromISR(&(q->queuePushSem));
-        
+        osResumeContextSwitching();
+        retVal = semphrTake(&(q->queuePushSem), taskRemainingDelay(start, delay));
+        osSuspendContextSwitching();
     }
-    else
+
+    /* Si hay un lugar libre lo reservamos */
+    if(OS_RESULT_OK == retVal)
     {
+        q->writeReserved = true;
+        *slot = &(q->data[q->writePtr * q->dataSize]);
+    }
+
+    osResumeContextSwitching();
+
+    return retVal;
+}
+
+/*
+* @fn osReturn_t queueCommit(queue_t * q)
+* @brief Agrega a la cola el elemento construido en el lugar reservado con queueReserve()
+* @params q     : Puntero a la cola
+* @return OS_RESULT_OK si se agrego el elemento, OS_RESULT_ERROR si no habia lugar reservado
+* @note Debe llamarla la misma tarea que hizo la reserva
+*/
+osReturn_t queueCommit(queue_t * q)
+{
+    osReturn_t retVal = OS_RESULT_ERROR;
+    bool       space = false;
+
+    /* Suspendemos cambio de contexto porque estamos manipulando variables globales */
+    osSuspendContextSwitching();
+
+    if(q->writeReserved)
+    {
+        /* Movemos el puntero un elemento mas y liberamos la reserva */
+        QUEUE_MOVE_PTR(q->writePtr, q->queueLen);
+        q->writeReserved = false;
+        space = !QUEUE_IS_FULL(q);
         retVal = OS_RESULT_OK;
     }
 
-    /* Si hay un lugar libre */
+    osResumeContextSwitching();
+
     if(OS_RESULT_OK == retVal)
     {
-        /* Agregamos el elemento */
-        memcpy(&(q->data[q->writePtr * q->dataSize]), data, q->dataSize);
-        /* Movemos el puntero un elemento mas */
-        QUEUE_MOVE_PTR(q->writePtr, q->queueLen);
         /* Liberamos el semaforo indicando que hay un elemento por si existe
            alguna otra tarea esperando que haya un elemento en la cola */
         semphrGive(&(q->queuePullSem));
+        /* Si queda lugar, avisamos a los productores que esperaban a que terminase la reserva */
+        if(space)
+        {
+            semphrGive(&(q->queuePushSem));
+        }
     }
 
-    osResumeContextSwitching();
-
     return retVal;
-
 }
 
 /*
-* @fn osReturn_t queuePull(queue_t * q, void * data, tick_t delay)
-* @brief Obtiene un elemento del principio de una cola
+* @fn osReturn_t queuePeek(queue_t * q, void ** slot, tick_t delay)
+* @brief Toma el primer elemento de una cola para procesarlo directamente en la misma
 * @params q     : Puntero a la cola
-* @params data  : Porcion de memoria donde se guarda un elemento de la cola
+* @params slot  : Donde se guarda el puntero al elemento dentro del buffer de la cola
 * @params delay : Tiempo a esperar a que haya un elemento en la cola
-* @return OS_RESULT_OK si se pudo obtener el elemento,
-          OS_RESULT_ERROR si expira el delay antes de poder obtener el elemento
+* @return OS_RESULT_OK si se pudo tomar el elemento,
+          OS_RESULT_ERROR si expira el delay antes de poder tomarlo
+* @note El lugar del elemento recien se libera para los productores luego de queueRelease()
+* @note Hay una unica toma por cola: mientras tanto el resto de los consumidores esperan
 * @danger Desde IRQ o Idle Task con delay 0
 */
-osReturn_t queuePullFromISR(queue_t * q, void * data)
+osReturn_t queuePeek(queue_t * q, void ** slot, tick_t delay)
 {
-    osReturn_t retVal = OS_RESULT_ERROR;
+    osReturn_t retVal = OS_RESULT_OK;
+    tick_t     start = taskGetTickCount();   /**< Tick de entrada, desde el que se cuenta delay */
 
     /* Suspendemos cambio de contexto porque estamos manipulando variables globales */
     osSuspendContextSwitching();
-    /* Si no hay elementos en la cola */
-    if(QUEUE_IS_EMPTY(q))
+    /* Mientras no haya elementos disponibles */
+    while(OS_RESULT_OK == retVal && QUEUE_NO_DATA(q))
     {
         /* Esperamos a que haya un elemento */
-        retVal = semphrTakeFromISR(&(q->queuePullSem));
-    
+        osResumeContextSwitching();
+        retVal = semphrTake(&(q->queuePullSem), taskRemainingDelay(start, delay));
+        osSuspendContextSwitching();
     }
-    else
+
+    /* Si hay al menos un elemento lo tomamos */
+    if(OS_RESULT_OK == retVal)
     {
+        q->readReserved = true;
+        *slot = &(q->data[q->readPtr * q->dataSize]);
+    }
+
+    osResumeContextSwitching();
+
+    return retVal;
+}
+
+/*
+* @fn osReturn_t queueRelease(queue_t * q)
+* @brief Remueve de la cola el elemento tomado con queuePeek() y libera su lugar
+* @params q     : Puntero a la cola
+* @return OS_RESULT_OK si se removio el elemento, OS_RESULT_ERROR si no habia elemento tomado
+* @note Debe llamarla la misma tarea que tomo el elemento
+*/
+osReturn_t queueRelease(queue_t * q)
+{
+    osReturn_t retVal = OS_RESULT_ERROR;
+    bool       data = false;
+
+    /* Suspendemos cambio de contexto porque estamos manipulando variables globales */
+    osSuspendContextSwitching();
+
+    if(q->readReserved)
+    {
+        /* Movemos el puntero un elemento mas y liberamos la toma */
+        QUEUE_MOVE_PTR(q->readPtr, q->queueLen);
+        q->readReserved = false;
+        data = !QUEUE_IS_EMPTY(q);
         retVal = OS_RESULT_OK;
     }
-    
-    /* Si hay al menos un elemento en la cola */
+
+    osResumeContextSwitching();
+
     if(OS_RESULT_OK == retVal)
     {
-        /* Obtenemos el elemento */
-        memcpy(data, &(q->data[q->readPtr * q->dataSize]), q->dataSize);
-        /* Movemos el puntero un elementos mas */
-        QUEUE_MOVE_PTR(q->readPtr, q->queueLen);
         /* Liberamos el semaforo indicando que hay un lugar en la cola por si existe
            alguna otra tarea esperando que haya espacio en la misma */
         semphrGive(&(q->queuePushSem));
+        /* Si quedan elementos, avisamos a los consumidores que esperaban a que terminase la toma */
+        if(data)
+        {
+            semphrGive(&(q->queuePullSem));
+        }
     }
 
-    osResumeContextSwitching();
-
     return retVal;
 }
 
@@ -0,0 +1,131 @@
+/** 
+* @file  OS_ring.c
+* @brief 
+* @note  Copyright 2019 - Esp. Ing. Matias Alvarez.
+*/
+
+/*==================[inclusions]=============================================*/
+#include "OS_ring.h"
+#include "OS_port.h"
+#include <string.h>
+/*==================[macros]=================================================*/
+/**
+* @def RING_IS_EMPTY(r)
+* @brief Macro para detectar si la cola esta vacia
+*/
+#define RING_IS_EMPTY(r) ((r)->tail == (r)->head)
+/*==================[typedef]================================================*/
+
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+#if ( OS_USE_RING == 1 )
+/**
+* @fn static bool ringNotEmpty(const void * ring)
+* @brief Funcion que evalua si la cola tiene elementos
+* @param  ring : Puntero a la cola
+* @return true si la cola tiene elementos, false caso contrario
+*/
+static bool ringNotEmpty(const void * ring)
+{
+    return !RING_IS_EMPTY((const ring_t *)ring);
+}
+#endif
+/*==================[external functions definition]==========================*/
+#if ( OS_USE_RING == 1 )
+/*
+* @fn osReturn_t ringInit(ring_t * ring, uint32_t ringLen, uint8_t * dataBuffer, uint32_t dataSize)
+* @brief Inicializa una cola lock-free
+* @params ring : Puntero a la cola a ser inicializada
+* @params ringLen : Cantidad de elementos de la cola - Debe ser potencia de 2
+* @params dataBuffer : Puntero a buffer donde almacenar los elementos de la cola
+* @params dataSize : Tamaño de los elementos de la cola
+* @return OS_RESULT_ERROR si ringLen no es potencia de 2, OS_RESULT_OK caso contrario
+* @danger ringLen * dataSize debe ser igual al largo de dataBuffer
+*/
+osReturn_t ringInit(ring_t * ring, uint32_t ringLen, uint8_t * dataBuffer, uint32_t dataSize)
+{
+    if(0 == ringLen || 0 != (ringLen & (ringLen - 1)))
+    {
+        return OS_RESULT_ERROR;
+    }
+
+    ring->data = dataBuffer;
+    ring->dataSize = dataSize;
+    ring->mask = ringLen - 1;
+    ring->head = 0;
+    ring->tail = 0;
+    ring->consumer = OS_INVALID_TASK;
+
+    return OS_RESULT_OK;
+}
+
+/*
+* @fn osReturn_t ringPush(ring_t * ring, void * data)
+* @brief Agrega un elemento al final de la cola, sin esperar
+* @params ring  : Puntero a la cola
+* @params data  : Puntero al elemento a agregar a la cola
+* @return OS_RESULT_OK si se pudo agregar el elemento, OS_RESULT_ERROR si la cola esta llena
+* @note No deshabilita interrupciones. Si el consumidor espera elementos, se lo despierta
+        en diferido a traves de la pendSV
+* @note Apta para IRQs. Un unico productor por cola
+*/
+osReturn_t ringPush(ring_t * ring, void * data)
+{
+    uint32_t head = ring->head;     /**< Indice de escritura */
+
+    /* Si la cola esta llena */
+    if(head - ring->tail > ring->mask)
+    {
+        return OS_RESULT_ERROR;
+    }
+
+    /* Agregamos el elemento */
+    memcpy(&(ring->data[(head & ring->mask) * ring->dataSize]), data, ring->dataSize);
+    /* Publicamos el nuevo indice y despertamos al consumidor si espera */
+    osPublishAndWake(&ring->head, head + 1, &ring->consumer);
+
+    return OS_RESULT_OK;
+}
+
+/*
+* @fn osReturn_t ringPull(ring_t * ring, void * data, tick_t delay)
+* @brief Obtiene un elemento del principio de la cola
+* @params ring  : Puntero a la cola
+* @params data  : Porcion de memoria donde se guarda un elemento de la cola
+* @params delay : Tiempo a esperar a que haya un elemento en la cola
+* @return OS_RESULT_OK si se pudo obtener el elemento,
+          OS_RESULT_ERROR si expira el delay antes de poder obtener el elemento
+* @note Un unico consumidor por cola
+* @danger Desde IRQ o Idle Task con delay 0
+*/
+osReturn_t ringPull(ring_t * ring, void * data, tick_t delay)
+{
+    osReturn_t retVal;
+    uint32_t   tail = ring->tail;   /**< Indice de lectura */
+
+    /* Esperamos que haya elementos en la cola */
+    retVal = osWaitForProducer(&ring->consumer, ringNotEmpty, ring, delay);
+
+    if(OS_RESULT_OK == retVal)
+    {
+        /* El elemento se lee despues de ver el nuevo indice */
+        __DMB();
+        /* Obtenemos el elemento */
+        memcpy(data, &(ring->data[(tail & ring->mask) * ring->dataSize]), ring->dataSize);
+        /* Terminamos de leer antes de liberar el lugar */
+        __DMB();
+        ring->tail = tail + 1;
+    }
+
+    return retVal;
+}
+
+#endif
+/*==================[end of file]============================================*/
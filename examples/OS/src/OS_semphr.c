@@ -31,10 +31,26 @@
 void semphrInit(semaphore_t * sem)
 {
     
+    /* Inicializamos el semaforo binario tomado */
+    semphrInitCounting(sem, 0, 1);
+
+}
+
+/**
+* @fn void semphrInitCounting(semaphore_t * sem, uint32_t initialValue, uint32_t maxValue)
+* @brief Funcion que inicializa un semaforo contador
+* @param  sem          : Puntero a la estructura del semaforo a inicializar
+* @param  initialValue : Valor inicial del semaforo
+* @param  maxValue     : Valor maximo del semaforo - Los semphrGive() por encima del mismo se descartan
+* @return Nada
+*/
+void semphrInitCounting(semaphore_t * sem, uint32_t initialValue, uint32_t maxValue)
+{
+
     /* Inicializamos el semaforo */
-    sem->value = 0;
-    sem->task = OS_INVALID_TASK;
-    sem->taskWaiting = false;
+    sem->maxValue = maxValue;
+    sem->value = (initialValue < maxValue) ? initialValue : maxValue;
+    waitListInit(&(sem->waitList));
 
 }
 
@@ -43,21 +59,19 @@ void semphrInit(semaphore_t * sem)
 * @brief Funcion que libera un semaforo
 * @param  sem : Puntero a la estructura del semaforo a liberar
 * @return Nada
+* @note Si hay tareas a la espera, el semaforo se entrega directamente a la de mayor prioridad
 */
 void semphrGive(semaphore_t * sem)
 {
-    /* Suspendemos cambio de contexto porque estamos manipulando variables globales */
-    osSuspendContextSwitching();
-
     /* NOTE: La idle task SI puede liberar semaforos */
     if (NULL != sem)
     {   
-        /* Si el semaforo esta tomado */
-        if(sem->taskWaiting)
+        /* Suspendemos cambio de contexto porque estamos manipulando variables globales */
+        osSuspendContextSwitching();
+
+        /* Si hay tareas bloqueadas, le entregamos el semaforo a la de mayor prioridad : Signal() */
+        if(OS_INVALID_TASK != taskWakeFromWaitList(&(sem->waitList)))
         {
-            /* Liberamos a la tarea bloqueada : Signal() */
-            sem->taskWaiting = false;
-            taskUnsuspendWithinAPI(sem->task);
             /* Volvemos a permitir el cambio de contexto antes de llamar al scheduler */
             osResumeContextSwitching();
             /* Llamamos al scheduler aun dentro de una IRQ porque la pendSV tiene la menor prioridad del
@@ -66,18 +80,64 @@ void semphrGive(semaphore_t * sem)
         } 
         else
         {
-            /* Si no, liberamos el semaforo */
-            sem->value = 1;
+            /* Si no, liberamos el semaforo sin superar su valor maximo */
+            if(sem->maxValue > sem->value)
+            {
+                sem->value++;
+            }
+            /* Volvemos a permitir el cambio de contexto */
+            osResumeContextSwitching();
         }  
-
-        /* Volvemos a permitir el cambio de contexto
-        en caso que no hayamos llegado a liberarlo antes de llamar al scheduler*/
-        osResumeContextSwitching();
-            
     }
  
 }
 
+/**
+* @fn osReturn_t semphrGiveFromISR(semaphore_t * sem)
+* @brief Funcion que libera un semaforo desde una IRQ
+* @param  sem : Puntero a la estructura del semaforo a liberar
+* @return OS_RESULT_OK si se libero el semaforo,
+          OS_RESULT_ERROR si el semaforo ya estaba en su valor maximo y el evento se descarta
+* @note Nunca llama al scheduler dentro de la IRQ: si despierta una tarea solo deja
+        pendiente el cambio de contexto para la salida de la IRQ
+*/
+osReturn_t semphrGiveFromISR(semaphore_t * sem)
+{
+    osReturn_t retVal = OS_RESULT_ERROR;
+    uint32_t   mask;
+    bool       yield = false;
+
+    if (NULL != sem)
+    {   
+        /* Suspendemos cambio de contexto porque estamos manipulando variables globales */
+        mask = osSuspendContextSwitchingFromISR();
+
+        /* Si hay tareas bloqueadas, le entregamos el semaforo a la de mayor prioridad : Signal() */
+        if(OS_INVALID_TASK != taskWakeFromWaitList(&(sem->waitList)))
+        {
+            yield = true;
+            retVal = OS_RESULT_OK;
+        } 
+        /* Si no, liberamos el semaforo sin superar su valor maximo */
+        else if(sem->maxValue > sem->value)
+        {
+            sem->value++;
+            retVal = OS_RESULT_OK;
+        }
+
+        /* Volvemos a permitir el cambio de contexto */
+        osResumeContextSwitchingFromISR(mask);
+
+        if(yield)
+        {
+            /* Dejamos pendiente el cambio de contexto para la salida de la IRQ */
+            taskYieldFromISR();
+        }
+    }
+
+    return retVal;
+}
+
 /**
 * @fn osReturn_t semphrTake(semaphore_t * sem, tick_t delay)
 * @brief Funcion que toma un semaforo
@@ -86,6 +146,7 @@ void semphrGive(semaphore_t * sem)
 * @return OS_RESULT_ERROR si se llama a la funcion desde la IDLE TASK,
           OS_RESULT_ERROR si expiro el delay sin que se liberase el semaforo
           OS_RESULT_OK si se pudo tomar el semaforo
+* @note Varias tareas pueden esperar el mismo semaforo, se despiertan por orden de prioridad
 * @danger Desde IRQ o Idle Task con delay 0
 */
 osReturn_t semphrTake(semaphore_t * sem, tick_t delay)
@@ -98,37 +159,19 @@ osReturn_t semphrTake(semaphore_t * sem, tick_t delay)
 
     if(NULL != sem)
     {
-        /* Si no hay otra tarea bloqueada en el semaforo */
-        if(OS_INVALID_TASK == sem->task)
+        /* Si esta liberado lo tomo */
+        if(0 < sem->value)
         {
-            /* Si esta liberado lo tomo */
-            if(0 < sem->value)
-            {
-                sem->value = 0;
+            sem->value--;
 
-                retVal = OS_RESULT_OK;
-            }
-            /* Si no espero : Wait() */
-            else
-            {
-                sem->taskWaiting = true;
-                sem->task = osGetCurrentTask();
-                /* Volvemos a permitir el cambio de contexto antes de llamar al scheduler */
-                osResumeContextSwitching();
-                /* Wait() */
-                taskDelay(delay);
-                /* Suspendemos cambio de contexto porque estamos manipulando variables globales */
-                osSuspendContextSwitching();
-                /* Si al volver del delay el semaforo esta liberado retornamos verdadero */
-                /* Pude haber vuelto del delay porque expiro el tiempo */
-                if(!sem->taskWaiting)
-                {
-                    retVal = OS_RESULT_OK;
-                }
-                /* Ahora no hay tareas bloqueadas a la espera de la liberacion del semaforo */
-                sem->taskWaiting = false;
-                sem->task = OS_INVALID_TASK;
-            }
+            retVal = OS_RESULT_OK;
+        }
+        /* Si no espero : Wait() */
+        else
+        {
+            /* Si al volver de la espera nos despertaron, semphrGive() ya nos entrego el semaforo */
+            /* Pude haber vuelto porque expiro el tiempo */
+            retVal = taskBlockOnWaitList(&(sem->waitList), delay);
         }
 
     }
@@ -140,32 +183,35 @@ osReturn_t semphrTake(semaphore_t * sem, tick_t delay)
 
 }
 
-
+/**
+* @fn osReturn_t semphrTakeFromISR(semaphore_t * sem)
+* @brief Funcion que toma un semaforo desde una IRQ, sin esperar
+* @param  sem : Puntero a la estructura del semaforo a tomar
+* @return OS_RESULT_ERROR si el semaforo no estaba liberado, OS_RESULT_OK caso contrario
+* @note No despierta tareas, por lo que no deja pendiente ningun cambio de contexto
+*/
 osReturn_t semphrTakeFromISR(semaphore_t * sem)
 {
 
     osReturn_t retVal = OS_RESULT_ERROR;
+    uint32_t   mask;
 
     /* Suspendemos cambio de contexto porque estamos manipulando variables globales */
-    osSuspendContextSwitching();
+    mask = osSuspendContextSwitchingFromISR();
 
     if(NULL != sem)
     {
-        /* Si no hay otra tarea bloqueada en el semaforo */
-        if(OS_INVALID_TASK == sem->task)
+        /* Si esta liberado lo tomo */
+        if(0 < sem->value)
         {
-            /* Si esta liberado lo tomo */
-            if(0 < sem->value)
-            {
-                sem->value = 0;
+            sem->value--;
 
-                retVal = OS_RESULT_OK;
-            }
+            retVal = OS_RESULT_OK;
         }
     }
 
     /* Volvemos a permitir el cambio de contexto */
-    osResumeContextSwitching();
+    osResumeContextSwitchingFromISR(mask);
 
     return retVal;
 
@@ -0,0 +1,622 @@
+/**
+* @file  OS_stream.c
+* @brief Buffers de stream y de mensajes de largo variable
+* @note  Un buffer de stream transporta bytes sueltos: el receptor se despierta cuando hay al menos
+         triggerLevel bytes. Un buffer de mensajes guarda cada mensaje precedido por su largo, por lo
+         que los mensajes se reciben enteros y no ocupan mas lugar que su largo real
+* @note  Copyright 2019 - Esp. Ing. Matias Alvarez.
+*/
+
+/*==================[inclusions]=============================================*/
+#include "OS_stream.h"
+#include <string.h>
+/*==================[macros]=================================================*/
+/**
+* @def STREAM_MIN(a, b)
+* @brief Macro que devuelve el menor de dos valores
+*/
+#define STREAM_MIN(a, b)            ( ((a) < (b)) ? (a) : (b) )
+
+/**
+* @def STREAM_SPACE(s)
+* @brief Macro que devuelve los bytes libres del buffer
+*/
+#define STREAM_SPACE(s)             ( (s)->size - (s)->count )
+
+/**
+* @def STREAM_RX_READY(s)
+* @brief Macro para evaluar si hay datos suficientes para despertar al receptor
+*/
+#define STREAM_RX_READY(s)          ( (s)->isMessage ? (0 < (s)->count) : ((s)->triggerLevel <= (s)->count) )
+/*==================[typedef]================================================*/
+
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+#if ( OS_USE_STREAM == 1 )
+/**
+* @fn static void streamCopyIn(stream_t * stream, const void * data, uint32_t len)
+* @brief Funcion que escribe bytes al final del buffer
+* @param  stream : Puntero al buffer
+* @param  data   : Bytes a escribir
+* @param  len    : Cantidad de bytes - Debe haber lugar para todos
+* @return Nada
+* @note Debe ser llamada con el cambio de contexto suspendido
+*/
+static void streamCopyIn(stream_t * stream, const void * data, uint32_t len)
+{
+    uint32_t first = STREAM_MIN(len, stream->size - stream->writePtr);   /**< Bytes hasta el final del buffer */
+
+    memcpy(&(stream->buffer[stream->writePtr]), data, first);
+    memcpy(stream->buffer, (const uint8_t *)data + first, len - first);
+
+    stream->writePtr = (stream->writePtr + len) % stream->size;
+    stream->count += len;
+}
+
+/**
+* @fn static void streamPeek(stream_t * stream, void * data, uint32_t len)
+* @brief Funcion que copia bytes del principio del buffer sin sacarlos
+* @param  stream : Puntero al buffer
+* @param  data   : Donde se copian los bytes
+* @param  len    : Cantidad de bytes - Debe haber al menos len bytes en el buffer
+* @return Nada
+* @note Debe ser llamada con el cambio de contexto suspendido
+*/
+static void streamPeek(stream_t * stream, void * data, uint32_t len)
+{
+    uint32_t first = STREAM_MIN(len, stream->size - stream->readPtr);    /**< Bytes hasta el final del buffer */
+
+    memcpy(data, &(stream->buffer[stream->readPtr]), first);
+    memcpy((uint8_t *)data + first, stream->buffer, len - first);
+}
+
+/**
+* @fn static void streamCopyOut(stream_t * stream, void * data, uint32_t len)
+* @brief Funcion que saca bytes del principio del buffer
+* @param  stream : Puntero al buffer
+* @param  data   : Donde se copian los bytes, NULL para descartarlos
+* @param  len    : Cantidad de bytes - Debe haber al menos len bytes en el buffer
+* @return Nada
+* @note Debe ser llamada con el cambio de contexto suspendido
+*/
+static void streamCopyOut(stream_t * stream, void * data, uint32_t len)
+{
+    if(NULL != data)
+    {
+        streamPeek(stream, data, len);
+    }
+
+    stream->readPtr = (stream->readPtr + len) % stream->size;
+    stream->count -= len;
+}
+
+/**
+* @fn static bool streamWakeAll(waitList_t * list)
+* @brief Funcion que despierta a todas las tareas de una lista de espera
+* @param  list : Lista de espera
+* @return true si desperto alguna tarea, false caso contrario
+* @note Cada tarea despertada vuelve a evaluar si tiene los datos o el lugar que necesita, ya que
+        un mismo cambio puede alcanzarle a una y no a otra
+* @note Debe ser llamada con el cambio de contexto suspendido
+*/
+static bool streamWakeAll(waitList_t * list)
+{
+    bool woken = false;
+
+    while(OS_INVALID_TASK != taskWakeFromWaitList(list))
+    {
+        woken = true;
+    }
+
+    return woken;
+}
+
+/**
+* @fn static bool streamWrite(stream_t * stream, const void * data, uint32_t len, uint32_t * sent)
+* @brief Funcion que escribe en un buffer de stream todos los bytes que entren
+* @param  stream : Puntero al buffer
+* @param  data   : Bytes a escribir
+* @param  len    : Cantidad de bytes a escribir
+* @param  sent   : Bytes ya escritos, se actualiza
+* @return true si desperto a algun receptor, false caso contrario
+* @note Debe ser llamada con el cambio de contexto suspendido
+*/
+static bool streamWrite(stream_t * stream, const void * data, uint32_t len, uint32_t * sent)
+{
+    uint32_t n = STREAM_MIN(len - *sent, STREAM_SPACE(stream));    /**< Bytes a escribir */
+
+    if(0 == n)
+    {
+        return false;
+    }
+
+    streamCopyIn(stream, (const uint8_t *)data + *sent, n);
+    *sent += n;
+
+    return STREAM_RX_READY(stream) && streamWakeAll(&(stream->rxWaitList));
+}
+
+/**
+* @fn static uint32_t streamRead(stream_t * stream, void * data, uint32_t maxLen, bool * woken)
+* @brief Funcion que lee de un buffer de stream todos los bytes disponibles que entren en data
+* @param  stream : Puntero al buffer
+* @param  data   : Donde se copian los bytes
+* @param  maxLen : Maxima cantidad de bytes a leer
+* @param  woken  : Se pone en true si se desperto a algun emisor
+* @return Bytes leidos
+* @note Debe ser llamada con el cambio de contexto suspendido
+*/
+static uint32_t streamRead(stream_t * stream, void * data, uint32_t maxLen, bool * woken)
+{
+    uint32_t n = STREAM_MIN(maxLen, stream->count);   /**< Bytes a leer */
+
+    if(0 < n)
+    {
+        streamCopyOut(stream, data, n);
+        *woken = streamWakeAll(&(stream->txWaitList));
+    }
+
+    return n;
+}
+
+/**
+* @fn static bool messageWrite(stream_t * stream, const void * data, uint32_t len)
+* @brief Funcion que escribe un mensaje en un buffer de mensajes
+* @param  stream : Puntero al buffer
+* @param  data   : Mensaje
+* @param  len    : Largo del mensaje - Debe haber lugar para el mensaje y su largo
+* @return true si desperto a algun receptor, false caso contrario
+* @note Debe ser llamada con el cambio de contexto suspendido
+*/
+static bool messageWrite(stream_t * stream, const void * data, uint32_t len)
+{
+    uint16_t header = (uint16_t)len;  /**< Largo del mensaje */
+
+    streamCopyIn(stream, &header, MESSAGE_HEADER_SIZE);
+    streamCopyIn(stream, data, len);
+
+    return streamWakeAll(&(stream->rxWaitList));
+}
+
+/**
+* @fn static uint32_t messageRead(stream_t * stream, void * data, uint32_t maxLen, bool * woken)
+* @brief Funcion que lee el primer mensaje de un buffer de mensajes
+* @param  stream : Puntero al buffer
+* @param  data   : Donde se copia el mensaje
+* @param  maxLen : Tamaño de data
+* @param  woken  : Se pone en true si se desperto a algun emisor
+* @return Largo del mensaje, 0 si no hay mensajes o si el mensaje no entra en data
+* @note Debe ser llamada con el cambio de contexto suspendido
+*/
+static uint32_t messageRead(stream_t * stream, void * data, uint32_t maxLen, bool * woken)
+{
+    uint16_t header = 0;  /**< Largo del mensaje */
+
+    if(0 < stream->count)
+    {
+        streamPeek(stream, &header, MESSAGE_HEADER_SIZE);
+
+        /* Si el mensaje no entra queda en el buffer */
+        if(header <= maxLen)
+        {
+            streamCopyOut(stream, NULL, MESSAGE_HEADER_SIZE);
+            streamCopyOut(stream, data, header);
+            *woken = streamWakeAll(&(stream->txWaitList));
+        }
+        else
+        {
+            header = 0;
+        }
+    }
+
+    return header;
+}
+/*==================[external functions definition]==========================*/
+/**
+* @fn osReturn_t streamInit(stream_t * stream, uint8_t * buffer, uint32_t size, uint32_t triggerLevel)
+* @brief Funcion que inicializa un buffer de stream vacio
+* @param  stream       : Puntero al buffer
+* @param  buffer       : Memoria del buffer
+* @param  size         : Tamaño en bytes de la memoria del buffer - Mayor a 0
+* @param  triggerLevel : Bytes a partir de los cuales se despierta al receptor - Entre 1 y size
+* @return OS_RESULT_ERROR si el tamaño o el trigger level no son validos, OS_RESULT_OK caso contrario
+*/
+osReturn_t streamInit(stream_t * stream, uint8_t * buffer, uint32_t size, uint32_t triggerLevel)
+{
+    if(NULL == buffer || 0 == size || 0 == triggerLevel || size < triggerLevel)
+    {
+        return OS_RESULT_ERROR;
+    }
+
+    stream->buffer       = buffer;
+    stream->size         = size;
+    stream->readPtr      = 0;
+    stream->writePtr     = 0;
+    stream->count        = 0;
+    stream->triggerLevel = triggerLevel;
+    stream->isMessage    = false;
+    waitListInit(&(stream->rxWaitList));
+    waitListInit(&(stream->txWaitList));
+
+    return OS_RESULT_OK;
+}
+
+/**
+* @fn osReturn_t streamSetTriggerLevel(stream_t * stream, uint32_t triggerLevel)
+* @brief Funcion que cambia el trigger level de un buffer de stream
+* @param  stream       : Puntero al buffer
+* @param  triggerLevel : Bytes a partir de los cuales se despierta al receptor - Entre 1 y size
+* @return OS_RESULT_ERROR si el trigger level no es valido, OS_RESULT_OK caso contrario
+*/
+osReturn_t streamSetTriggerLevel(stream_t * stream, uint32_t triggerLevel)
+{
+    osReturn_t retVal = OS_RESULT_ERROR;
+
+    if(0 < triggerLevel && stream->size >= triggerLevel)
+    {
+        osSuspendContextSwitching();
+        stream->triggerLevel = triggerLevel;
+        osResumeContextSwitching();
+        retVal = OS_RESULT_OK;
+    }
+
+    return retVal;
+}
+
+/**
+* @fn uint32_t streamSend(stream_t * stream, const void * data, uint32_t len, tick_t delay)
+* @brief Funcion que envia bytes por un buffer de stream
+* @param  stream : Puntero al buffer
+* @param  data   : Bytes a enviar
+* @param  len    : Cantidad de bytes a enviar
+* @param  delay  : Tiempo maximo de espera de lugar libre, en total
+* @return Bytes enviados - Menos que len si expiro el delay
+* @note Escribe todo lo que entra y espera lugar para el resto
+* @danger Desde IRQ o Idle Task con delay 0
+*/
+uint32_t streamSend(stream_t * stream, const void * data, uint32_t len, tick_t delay)
+{
+    osReturn_t retVal = OS_RESULT_OK;
+    uint32_t   sent = 0;        /**< Bytes enviados */
+    bool       woken = false;   /**< Indica si se desperto a algun receptor */
+    tick_t     start = taskGetTickCount();  /**< Tick de entrada, desde el que se cuenta delay */
+
+    if(stream->isMessage)
+    {
+        return 0;
+    }
+
+    /* Suspendemos cambio de contexto porque estamos manipulando variables globales */
+    osSuspendContextSwitching();
+
+    woken = streamWrite(stream, data, len, &sent);
+    /* Mientras queden bytes por enviar esperamos lugar libre */
+    while(OS_RESULT_OK == retVal && sent < len)
+    {
+        retVal = taskBlockOnWaitList(&(stream->txWaitList), taskRemainingDelay(start, delay));
+        woken |= streamWrite(stream, data, len, &sent);
+    }
+
+    /* Volvemos a permitir el cambio de contexto */
+    osResumeContextSwitching();
+
+    if(woken)
+    {
+        /* Llamamos al scheduler por si algun receptor despertado es de mayor prioridad */
+        taskYield();
+    }
+
+    return sent;
+}
+
+/**
+* @fn uint32_t streamSendFromISR(stream_t * stream, const void * data, uint32_t len)
+* @brief Funcion que envia bytes por un buffer de stream desde una IRQ, sin esperar
+* @param  stream : Puntero al buffer
+* @param  data   : Bytes a enviar
+* @param  len    : Cantidad de bytes a enviar
+* @return Bytes enviados - Los que no entran se descartan
+*/
+uint32_t streamSendFromISR(stream_t * stream, const void * data, uint32_t len)
+{
+    uint32_t sent = 0;
+    bool     woken = false;
+    uint32_t mask;
+
+    if(!stream->isMessage)
+    {
+        mask = osSuspendContextSwitchingFromISR();
+        woken = streamWrite(stream, data, len, &sent);
+        osResumeContextSwitchingFromISR(mask);
+
+        if(woken)
+        {
+            /* Dejamos pendiente el cambio de contexto para la salida de la IRQ */
+            taskYieldFromISR();
+        }
+    }
+
+    return sent;
+}
+
+/**
+* @fn uint32_t streamReceive(stream_t * stream, void * data, uint32_t maxLen, tick_t delay)
+* @brief Funcion que recibe bytes de un buffer de stream
+* @param  stream : Puntero al buffer
+* @param  data   : Donde se copian los bytes
+* @param  maxLen : Maxima cantidad de bytes a recibir
+* @param  delay  : Tiempo maximo de espera a que haya triggerLevel bytes
+* @return Bytes recibidos - Si expira el delay se reciben los disponibles, aunque sean menos que triggerLevel
+* @danger Desde IRQ o Idle Task con delay 0
+*/
+uint32_t streamReceive(stream_t * stream, void * data, uint32_t maxLen, tick_t delay)
+{
+    osReturn_t retVal = OS_RESULT_OK;
+    uint32_t   received = 0;    /**< Bytes recibidos */
+    bool       woken = false;   /**< Indica si se desperto a algun emisor */
+    tick_t     start = taskGetTickCount();  /**< Tick de entrada, desde el que se cuenta delay */
+
+    if(stream->isMessage)
+    {
+        return 0;
+    }
+
+    /* Suspendemos cambio de contexto porque estamos manipulando variables globales */
+    osSuspendContextSwitching();
+
+    while(OS_RESULT_OK == retVal && !STREAM_RX_READY(stream))
+    {
+        retVal = taskBlockOnWaitList(&(stream->rxWaitList), taskRemainingDelay(start, delay));
+    }
+    received = streamRead(stream, data, maxLen, &woken);
+
+    /* Volvemos a permitir el cambio de contexto */
+    osResumeContextSwitching();
+
+    if(woken)
+    {
+        /* Llamamos al scheduler por si algun emisor despertado es de mayor prioridad */
+        taskYield();
+    }
+
+    return received;
+}
+
+/**
+* @fn uint32_t streamReceiveFromISR(stream_t * stream, void * data, uint32_t maxLen)
+* @brief Funcion que recibe los bytes disponibles de un buffer de stream desde una IRQ, sin esperar
+* @param  stream : Puntero al buffer
+* @param  data   : Donde se copian los bytes
+* @param  maxLen : Maxima cantidad de bytes a recibir
+* @return Bytes recibidos
+*/
+uint32_t streamReceiveFromISR(stream_t * stream, void * data, uint32_t maxLen)
+{
+    uint32_t received = 0;
+    bool     woken = false;
+    uint32_t mask;
+
+    if(!stream->isMessage)
+    {
+        mask = osSuspendContextSwitchingFromISR();
+        received = streamRead(stream, data, maxLen, &woken);
+        osResumeContextSwitchingFromISR(mask);
+
+        if(woken)
+        {
+            /* Dejamos pendiente el cambio de contexto para la salida de la IRQ */
+            taskYieldFromISR();
+        }
+    }
+
+    return received;
+}
+
+/**
+* @fn uint32_t streamBytesAvailable(stream_t * stream)
+* @brief Funcion que devuelve los bytes ocupados de un buffer, incluyendo los largos de los mensajes
+* @param  stream : Puntero al buffer
+* @return Bytes ocupados
+* @note Puede llamarse desde una IRQ
+*/
+uint32_t streamBytesAvailable(stream_t * stream)
+{
+    return stream->count;
+}
+
+/**
+* @fn uint32_t streamSpacesAvailable(stream_t * stream)
+* @brief Funcion que devuelve los bytes libres de un buffer
+* @param  stream : Puntero al buffer
+* @return Bytes libres
+* @note Puede llamarse desde una IRQ
+*/
+uint32_t streamSpacesAvailable(stream_t * stream)
+{
+    return STREAM_SPACE(stream);
+}
+
+/**
+* @fn osReturn_t messageInit(stream_t * stream, uint8_t * buffer, uint32_t size)
+* @brief Funcion que inicializa un buffer de mensajes vacio
+* @param  stream : Puntero al buffer
+* @param  buffer : Memoria del buffer
+* @param  size   : Tamaño en bytes de la memoria del buffer - Cada mensaje ocupa su largo mas MESSAGE_HEADER_SIZE
+* @return OS_RESULT_ERROR si el tamaño no alcanza para un mensaje de 1 byte, OS_RESULT_OK caso contrario
+*/
+osReturn_t messageInit(stream_t * stream, uint8_t * buffer, uint32_t size)
+{
+    osReturn_t retVal = OS_RESULT_ERROR;
+
+    if(MESSAGE_HEADER_SIZE < size && OS_RESULT_OK == streamInit(stream, buffer, size, 1))
+    {
+        stream->isMessage = true;
+        retVal = OS_RESULT_OK;
+    }
+
+    return retVal;
+}
+
+/**
+* @fn osReturn_t messageSend(stream_t * stream, const void * data, uint32_t len, tick_t delay)
+* @brief Funcion que envia un mensaje por un buffer de mensajes
+* @param  stream : Puntero al buffer
+* @param  data   : Mensaje
+* @param  len    : Largo del mensaje - Entre 1 y 65535
+* @param  delay  : Tiempo maximo de espera de lugar para el mensaje entero
+* @return OS_RESULT_OK si se envio el mensaje, OS_RESULT_ERROR si expiro el delay o el mensaje no entra en el buffer
+* @danger Desde IRQ o Idle Task con delay 0
+*/
+osReturn_t messageSend(stream_t * stream, const void * data, uint32_t len, tick_t delay)
+{
+    osReturn_t retVal = OS_RESULT_ERROR;
+    bool       woken = false;   /**< Indica si se desperto a algun receptor */
+    tick_t     start = taskGetTickCount();  /**< Tick de entrada, desde el que se cuenta delay */
+
+    if(stream->isMessage && 0 < len && UINT16_MAX >= len && stream->size >= len + MESSAGE_HEADER_SIZE)
+    {
+        retVal = OS_RESULT_OK;
+
+        /* Suspendemos cambio de contexto porque estamos manipulando variables globales */
+        osSuspendContextSwitching();
+
+        /* El mensaje se escribe entero o no se escribe */
+        while(OS_RESULT_OK == retVal && STREAM_SPACE(stream) < len + MESSAGE_HEADER_SIZE)
+        {
+            retVal = taskBlockOnWaitList(&(stream->txWaitList), taskRemainingDelay(start, delay));
+        }
+        if(STREAM_SPACE(stream) >= len + MESSAGE_HEADER_SIZE)
+        {
+            woken = messageWrite(stream, data, len);
+            retVal = OS_RESULT_OK;
+        }
+
+        /* Volvemos a permitir el cambio de contexto */
+        osResumeContextSwitching();
+
+        if(woken)
+        {
+            /* Llamamos al scheduler por si algun receptor despertado es de mayor prioridad */
+            taskYield();
+        }
+    }
+
+    return retVal;
+}
+
+/**
+* @fn osReturn_t messageSendFromISR(stream_t * stream, const void * data, uint32_t len)
+* @brief Funcion que envia un mensaje por un buffer de mensajes desde una IRQ, sin esperar
+* @param  stream : Puntero al buffer
+* @param  data   : Mensaje
+* @param  len    : Largo del mensaje - Entre 1 y 65535
+* @return OS_RESULT_OK si se envio el mensaje, OS_RESULT_ERROR si no hay lugar y el mensaje se descarta
+*/
+osReturn_t messageSendFromISR(stream_t * stream, const void * data, uint32_t len)
+{
+    osReturn_t retVal = OS_RESULT_ERROR;
+    bool       woken = false;
+    uint32_t   mask;
+
+    if(stream->isMessage && 0 < len && UINT16_MAX >= len)
+    {
+        mask = osSuspendContextSwitchingFromISR();
+        if(STREAM_SPACE(stream) >= len + MESSAGE_HEADER_SIZE)
+        {
+            woken = messageWrite(stream, data, len);
+            retVal = OS_RESULT_OK;
+        }
+        osResumeContextSwitchingFromISR(mask);
+
+        if(woken)
+        {
+            /* Dejamos pendiente el cambio de contexto para la salida de la IRQ */
+            taskYieldFromISR();
+        }
+    }
+
+    return retVal;
+}
+
+/**
+* @fn uint32_t messageReceive(stream_t * stream, void * data, uint32_t maxLen, tick_t delay)
+* @brief Funcion que recibe un mensaje de un buffer de mensajes
+* @param  stream : Puntero al buffer
+* @param  data   : Donde se copia el mensaje
+* @param  maxLen : Tamaño de data
+* @param  delay  : Tiempo maximo de espera a que haya un mensaje
+* @return Largo del mensaje, 0 si expiro el delay o si el mensaje no entra en data - En ese caso
+          el mensaje queda en el buffer
+* @danger Desde IRQ o Idle Task con delay 0
+*/
+uint32_t messageReceive(stream_t * stream, void * data, uint32_t maxLen, tick_t delay)
+{
+    osReturn_t retVal = OS_RESULT_OK;
+    uint32_t   len = 0;         /**< Largo del mensaje */
+    bool       woken = false;   /**< Indica si se desperto a algun emisor */
+    tick_t     start = taskGetTickCount();  /**< Tick de entrada, desde el que se cuenta delay */
+
+    if(!stream->isMessage)
+    {
+        return 0;
+    }
+
+    /* Suspendemos cambio de contexto porque estamos manipulando variables globales */
+    osSuspendContextSwitching();
+
+    while(OS_RESULT_OK == retVal && 0 == stream->count)
+    {
+        retVal = taskBlockOnWaitList(&(stream->rxWaitList), taskRemainingDelay(start, delay));
+    }
+    len = messageRead(stream, data, maxLen, &woken);
+
+    /* Volvemos a permitir el cambio de contexto */
+    osResumeContextSwitching();
+
+    if(woken)
+    {
+        /* Llamamos al scheduler por si algun emisor despertado es de mayor prioridad */
+        taskYield();
+    }
+
+    return len;
+}
+
+/**
+* @fn uint32_t messageReceiveFromISR(stream_t * stream, void * data, uint32_t maxLen)
+* @brief Funcion que recibe un mensaje de un buffer de mensajes desde una IRQ, sin esperar
+* @param  stream : Puntero al buffer
+* @param  data   : Donde se copia el mensaje
+* @param  maxLen : Tamaño de data
+* @return Largo del mensaje, 0 si no hay mensajes o si el mensaje no entra en data
+*/
+uint32_t messageReceiveFromISR(stream_t * stream, void * data, uint32_t maxLen)
+{
+    uint32_t len = 0;
+    bool     woken = false;
+    uint32_t mask;
+
+    if(stream->isMessage)
+    {
+        mask = osSuspendContextSwitchingFromISR();
+        len = messageRead(stream, data, maxLen, &woken);
+        osResumeContextSwitchingFromISR(mask);
+
+        if(woken)
+        {
+            /* Dejamos pendiente el cambio de contexto para la salida de la IRQ */
+            taskYieldFromISR();
+        }
+    }
+
+    return len;
+}
+#endif
+/*==================[end of file]============================================*/
@@ -0,0 +1,358 @@
+/**
+* @file  OS_timer.c
+* @brief Timers por software atendidos por una unica tarea del SO
+* @note  Los timers activos se guardan en una lista ordenada por vencimiento. La tarea de timers
+         duerme en un semaforo hasta el vencimiento mas proximo o hasta que se arranque un timer
+         que venza antes
+* @note  Copyright 2019 - Esp. Ing. Matias Alvarez.
+*/
+
+/*==================[inclusions]=============================================*/
+#include "OS_timer.h"
+#include "OS_semphr.h"
+/*==================[macros]=================================================*/
+/**
+* @def TIMER_EXPIRED(timer, now)
+* @brief Macro para evaluar si un timer vencio
+* @note La resta con signo contempla el desborde del tick del sistema
+*/
+#define TIMER_EXPIRED(timer, now)   ( 0 >= (int32_t)((timer)->expiry - (now)) )
+/*==================[typedef]================================================*/
+
+/*==================[internal data declaration]==============================*/
+#if ( OS_USE_TIMER == 1 )
+/**
+* @var static osTimer_t * g_timerList
+* @brief Lista de timers activos, ordenada por vencimiento
+*/
+static osTimer_t * g_timerList = NULL;
+
+/**
+* @var static semaphore_t g_timerSem
+* @brief Semaforo binario con el que se despierta a la tarea de timers
+* @note Se inicializa estaticamente para poder arrancar timers antes que el scheduler
+*/
+static semaphore_t g_timerSem =
+{
+    .value      = 0
+,   .maxValue   = 1
+,   .waitList   = { .head = OS_INVALID_TASK }
+};
+
+/**
+* @var static uint32_t g_timerTaskStack[OS_TIMER_STACK_SIZE / sizeof(uint32_t)]
+* @brief Stack de la tarea de timers
+*/
+static uint32_t g_timerTaskStack[OS_TIMER_STACK_SIZE / sizeof(uint32_t)];
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+* @fn static void timerListRemove(osTimer_t * timer)
+* @brief Funcion que saca un timer de la lista de timers activos
+* @param  timer : Puntero al timer
+* @return Nada
+* @note Debe ser llamada con el cambio de contexto suspendido
+*/
+static void timerListRemove(osTimer_t * timer)
+{
+    osTimer_t ** link = &g_timerList;  /**< Enlace que apunta al timer a evaluar */
+
+    while(NULL != *link)
+    {
+        if(timer == *link)
+        {
+            *link = timer->next;
+            break;
+        }
+        link = &((*link)->next);
+    }
+
+    timer->next   = NULL;
+    timer->active = false;
+}
+
+/**
+* @fn static bool timerListInsert(osTimer_t * timer, tick_t now)
+* @brief Funcion que agrega un timer a la lista de timers activos segun su vencimiento
+* @param  timer : Puntero al timer, con el vencimiento ya calculado
+* @param  now   : Tick actual
+* @return true si el timer quedo primero en la lista, false caso contrario
+* @note Se ordena por ticks restantes, con signo, para contemplar el desborde del tick del sistema y los
+        timers ya vencidos. Los timers de igual vencimiento se atienden por orden de llegada
+* @note Debe ser llamada con el cambio de contexto suspendido
+*/
+static bool timerListInsert(osTimer_t * timer, tick_t now)
+{
+    osTimer_t ** link = &g_timerList;  /**< Enlace tras el cual se inserta el timer */
+
+    while(NULL != *link && (int32_t)((*link)->expiry - now) <= (int32_t)(timer->expiry - now))
+    {
+        link = &((*link)->next);
+    }
+    timer->next   = *link;
+    *link         = timer;
+    timer->active = true;
+
+    return (g_timerList == timer);
+}
+
+/**
+* @fn static void timerTask(void * parameters)
+* @brief Tarea de timers - Ejecuta los callbacks de los timers vencidos
+* @param  parameters : No se usa
+* @return Nada
+*/
+static void timerTask(void * parameters)
+{
+    osTimer_t * timer;  /**< Timer vencido */
+    tick_t      now;    /**< Tick actual */
+    tick_t      wait;   /**< Ticks hasta el proximo vencimiento */
+
+    while(1)
+    {
+        osSuspendContextSwitching();
+
+        now = taskGetTickCount();
+        /* Atendemos los timers vencidos por orden de vencimiento */
+        while(NULL != g_timerList && TIMER_EXPIRED(g_timerList, now))
+        {
+            timer = g_timerList;
+            g_timerList = timer->next;
+            timer->next = NULL;
+
+            if(timer->autoReload)
+            {
+                /* El periodo se cuenta desde el vencimiento y no desde la atencion, para no acumular atraso */
+                timer->expiry += timer->period;
+                /* Si la tarea de timers se atraso mas de un periodo se saltean los vencimientos perdidos,
+                   manteniendo la fase: el proximo vencimiento queda en el futuro */
+                if(TIMER_EXPIRED(timer, now))
+                {
+                    timer->expiry += ((now - timer->expiry) / timer->period + 1) * timer->period;
+                }
+                timerListInsert(timer, now);
+            }
+            else
+            {
+                timer->active = false;
+            }
+
+            /* El callback se ejecuta con el cambio de contexto habilitado */
+            osResumeContextSwitching();
+            timer->callback(timer);
+            osSuspendContextSwitching();
+
+            now = taskGetTickCount();
+        }
+
+        wait = (NULL == g_timerList) ? OS_MAX_DELAY : g_timerList->expiry - now;
+
+        osResumeContextSwitching();
+
+        /* Esperamos el proximo vencimiento o que se arranque un timer que venza antes */
+        semphrTake(&g_timerSem, wait);
+    }
+}
+/*==================[external functions definition]==========================*/
+/**
+* @fn void timerServiceInit(void)
+* @brief Funcion que crea la tarea de timers
+* @param  Ninguno
+* @return Nada
+* @note La llama taskStartScheduler(). La tarea ocupa uno de los OS_MAX_TASK lugares de tareas
+* @warning NO DEBE SER USADA POR EL USUARIO
+*/
+void timerServiceInit(void)
+{
+    taskCreate(timerTask, OS_TIMER_TASK_PRIORITY, g_timerTaskStack, sizeof(g_timerTaskStack), "TimerTask",
+               (void *)0, NULL);
+}
+
+/**
+* @fn void timerInit(osTimer_t * timer, tick_t period, bool autoReload, timerCallback_t callback, void * parameters)
+* @brief Funcion que inicializa un timer detenido
+* @param  timer      : Puntero al timer
+* @param  period     : Periodo del timer en ticks - Mayor a 0
+* @param  autoReload : true para que el timer se recargue al vencer, false para un unico disparo
+* @param  callback   : Funcion a ejecutar al vencer el timer
+* @param  parameters : Puntero a los parametros del callback, accesible como timer->parameters
+* @return Nada
+*/
+void timerInit(osTimer_t * timer, tick_t period, bool autoReload, timerCallback_t callback, void * parameters)
+{
+    timer->period     = period;
+    timer->expiry     = 0;
+    timer->autoReload = autoReload;
+    timer->active     = false;
+    timer->callback   = callback;
+    timer->parameters = parameters;
+    timer->next       = NULL;
+}
+
+/**
+* @fn osReturn_t timerStart(osTimer_t * timer)
+* @brief Funcion que arranca un timer, o lo reinicia si ya estaba activo
+* @param  timer : Puntero al timer
+* @return OS_RESULT_ERROR si el periodo del timer es 0, OS_RESULT_OK caso contrario
+* @note El timer vence al cabo de period ticks de la llamada
+*/
+osReturn_t timerStart(osTimer_t * timer)
+{
+    osReturn_t retVal = OS_RESULT_ERROR;
+    bool       first = false;   /**< Indica si el timer es el proximo en vencer */
+    tick_t     now;
+
+    if(0 < timer->period)
+    {
+        osSuspendContextSwitching();
+
+        if(timer->active)
+        {
+            timerListRemove(timer);
+        }
+        now = taskGetTickCount();
+        timer->expiry = now + timer->period;
+        first = timerListInsert(timer, now);
+
+        osResumeContextSwitching();
+
+        /* La tarea de timers debe recalcular su espera. Antes del arranque del scheduler
+           no hace falta, la calcula en su primera ejecucion */
+        if(first && OS_INVALID_TASK != osGetCurrentTask())
+        {
+            semphrGive(&g_timerSem);
+        }
+
+        retVal = OS_RESULT_OK;
+    }
+
+    return retVal;
+}
+
+/**
+* @fn osReturn_t timerStartFromISR(osTimer_t * timer)
+* @brief Funcion que arranca un timer desde una IRQ, o lo reinicia si ya estaba activo
+* @param  timer : Puntero al timer
+* @return OS_RESULT_ERROR si el periodo del timer es 0, OS_RESULT_OK caso contrario
+*/
+osReturn_t timerStartFromISR(osTimer_t * timer)
+{
+    osReturn_t retVal = OS_RESULT_ERROR;
+    bool       first = false;   /**< Indica si el timer es el proximo en vencer */
+    uint32_t   mask;
+    tick_t     now;
+
+    if(0 < timer->period)
+    {
+        mask = osSuspendContextSwitchingFromISR();
+
+        if(timer->active)
+        {
+            timerListRemove(timer);
+        }
+        now = taskGetTickCount();
+        timer->expiry = now + timer->period;
+        first = timerListInsert(timer, now);
+
+        osResumeContextSwitchingFromISR(mask);
+
+        if(first)
+        {
+            /* La tarea de timers debe recalcular su espera */
+            semphrGiveFromISR(&g_timerSem);
+        }
+
+        retVal = OS_RESULT_OK;
+    }
+
+    return retVal;
+}
+
+/**
+* @fn osReturn_t timerStop(osTimer_t * timer)
+* @brief Funcion que detiene un timer
+* @param  timer : Puntero al timer
+* @return OS_RESULT_ERROR si el timer no estaba activo, OS_RESULT_OK caso contrario
+*/
+osReturn_t timerStop(osTimer_t * timer)
+{
+    osReturn_t retVal = OS_RESULT_ERROR;
+
+    osSuspendContextSwitching();
+
+    if(timer->active)
+    {
+        /* Si era el proximo en vencer la tarea de timers despierta igual y no encuentra nada vencido */
+        timerListRemove(timer);
+        retVal = OS_RESULT_OK;
+    }
+
+    osResumeContextSwitching();
+
+    return retVal;
+}
+
+/**
+* @fn osReturn_t timerStopFromISR(osTimer_t * timer)
+* @brief Funcion que detiene un timer desde una IRQ
+* @param  timer : Puntero al timer
+* @return OS_RESULT_ERROR si el timer no estaba activo, OS_RESULT_OK caso contrario
+*/
+osReturn_t timerStopFromISR(osTimer_t * timer)
+{
+    osReturn_t retVal = OS_RESULT_ERROR;
+    uint32_t   mask;
+
+    mask = osSuspendContextSwitchingFromISR();
+
+    if(timer->active)
+    {
+        timerListRemove(timer);
+        retVal = OS_RESULT_OK;
+    }
+
+    osResumeContextSwitchingFromISR(mask);
+
+    return retVal;
+}
+
+/**
+* @fn osReturn_t timerChangePeriod(osTimer_t * timer, tick_t period)
+* @brief Funcion que cambia el periodo de un timer y lo reinicia
+* @param  timer  : Puntero al timer
+* @param  period : Nuevo periodo en ticks - Mayor a 0
+* @return OS_RESULT_ERROR si el periodo es 0, OS_RESULT_OK caso contrario
+*/
+osReturn_t timerChangePeriod(osTimer_t * timer, tick_t period)
+{
+    osReturn_t retVal = OS_RESULT_ERROR;
+
+    if(0 < period)
+    {
+        osSuspendContextSwitching();
+        timer->period = period;
+        osResumeContextSwitching();
+
+        retVal = timerStart(timer);
+    }
+
+    return retVal;
+}
+
+/**
+* @fn bool timerIsActive(osTimer_t * timer)
+* @brief Funcion que devuelve si un timer esta activo
+* @param  timer : Puntero al timer
+* @return true si el timer esta activo, false caso contrario
+*/
+bool timerIsActive(osTimer_t * timer)
+{
+    return timer->active;
+}
+#endif
+/*==================[end of file]============================================*/
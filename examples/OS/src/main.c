@@ -11,6 +11,8 @@
 #include "OS_semphr.h"
 #include "OS_queue.h"
 #include "OS_irq.h"
+#include "OS_defer.h"
+#include "OS_log.h"
 
 /* Driver & Board Includes */
 #include "board.h"
@@ -19,8 +21,6 @@
 
 /* C Includes */
 #include <stdint.h>
-#include <stdio.h>
-#include <string.h>
 /*==================[macros]=================================================*/
 /**
 * @def MAX_TEC
@@ -47,22 +47,22 @@
 #define REBOUND_DELAY           10
 
 /**
-* @def LED_STRING_LENGTH
-* @brief Largo del string que indica que led debe ser encendido
+* @def LOG_BUFFER_SIZE
+* @brief Tamaño del buffer con el que logTask saca los registros de log para enviarlos via UART
 */
-#define LED_STRING_LENGTH       15
-
-/**
-* @def STRING_TO_SEND_LENGTH
-* @brief Largo del string de log a ser enviado via UART
-*/
-#define STRING_TO_SEND_LENGTH   256
+#define LOG_BUFFER_SIZE         ( 4 * OS_LOG_RECORD_MAX_SIZE )
 
 /**
 * @def QUEUE_LEN
 * @brief Largo de las colas
 */
 #define QUEUE_LEN               5
+
+/**
+* @def UART_TX_BUFFER_SIZE
+* @brief Tamaño del buffer de transmision de la UART - Una lectura de log entera
+*/
+#define UART_TX_BUFFER_SIZE     LOG_BUFFER_SIZE
 /*==================[typedef]================================================*/
 /**
 * @def edge_t
@@ -111,7 +111,7 @@ typedef struct
 */
 typedef  struct
 {
-    char        ledString[LED_STRING_LENGTH];   
+    const char *ledString;
     tick_t    fallingEdgeTime;
     tick_t    risingEdgeTime;
 }logInfo_t;
@@ -149,45 +149,66 @@ static uint8_t   g_ledQueueBuffer[QUEUE_LEN*sizeof(ledInfo_t)];
 static queue_t g_ledQueue;
 
 /**
-* @var static uint8_t   g_logQueueBuffer[QUEUE_LEN*sizeof(logInfo_t)];
-* @brief Buffer para almacenar los elementos de la cola de informacion de log
+* @var static uint8_t g_uartTxBuffer[UART_TX_BUFFER_SIZE]
+* @brief Buffer de transmision de la UART - Lo vacia la IRQ de la UART mientras logTask espera el proximo log
 */
-static uint8_t   g_logQueueBuffer[QUEUE_LEN*sizeof(logInfo_t)];
-/**
-* @var static queue_t g_tecQueue
-* @brief Cola para informacion de log
-*/
-static queue_t g_logQueue;
+static uint8_t g_uartTxBuffer[UART_TX_BUFFER_SIZE];
 /*==================[internal functions declaration]=========================*/
 
 /*==================[internal data definition]===============================*/
 
 /*==================[external data definition]===============================*/
-uint32_t pulseDetectorTaskStack[OS_MINIMAL_STACK_SIZE];
-uint32_t ledTaskStack[OS_MINIMAL_STACK_SIZE];
-uint32_t logTaskStack[OS_MINIMAL_STACK_SIZE];
+uint32_t pulseDetectorTaskStack[OS_MINIMAL_STACK_SIZE / sizeof(uint32_t)];
+uint32_t ledTaskStack[OS_MINIMAL_STACK_SIZE / sizeof(uint32_t)];
+uint32_t logTaskStack[OS_MINIMAL_STACK_SIZE / sizeof(uint32_t)];
+/*==================[internal functions definition]==========================*/
+/**
+* @fn static void logPulse(const logInfo_t * logInfo)
+* @brief Funcion que encola el log de un led encendido
+* @param  logInfo : Informacion del log
+* @return Nada
+* @note Solo encola el formato y los argumentos, el texto lo arma tools/oslog_decode.py en la PC
+*/
+static void logPulse(const logInfo_t * logInfo)
+{
+    OS_LOG("%s encendido:\n\r"
+           "\t Tiempo encendido: %lu ms \n\r"
+           "\t Tiempo entre flancos descendentes: %lu ms \n\r"
+           "\t Tiempo entre flancos ascendentes: %lu ms \n\r"
+           , OS_LOG_STR(logInfo->ledString)
+           , logInfo->risingEdgeTime + logInfo->fallingEdgeTime
+           , logInfo->fallingEdgeTime
+           , logInfo->risingEdgeTime);
+}
 /*==================[external functions definition]==========================*/
-void GPIO0IRQHandler(void){
+void tecEdgeWork(void * arg, tick_t tick)
+{
     tecInfo_t tecInfo;
 
-    tecInfo.tec = TEC1;
+    /* La IRQ empaqueta la tecla y el flanco en el argumento */
+    tecInfo.tec = (gpioMap_t)((uintptr_t)arg >> 1);
+    tecInfo.edge = (edge_t)((uintptr_t)arg & 1);
+    /* El tick es el de la IRQ, no el de la ejecucion del trabajo */
+    tecInfo.edgeTime = tick;
+
+    /* Sin esperar, como antes desde la IRQ */
+    queuePush(&g_tecQueue, (void *)&(tecInfo), 0);
+}
+
+void GPIO0IRQHandler(void){
+    edge_t edge;
 
     /* Si la interrupcion fue a causa de una rising edge */
     if (Chip_PININT_GetRiseStates(LPC_GPIO_PIN_INT) & PININTCH(GPIO_CHANNEL_0)) 
     {
-
-        /* Guardamos el tick actual en edgeTime e indicamos que es rising edge */
-        tecInfo.edgeTime = taskGetTickCount();
-        tecInfo.edge = RISING_EDGE;
+        edge = RISING_EDGE;
         /* Limpiamos el estado de rising edge */
         Chip_PININT_ClearRiseStates(LPC_GPIO_PIN_INT,PININTCH(GPIO_CHANNEL_0));
     }
     /* Si, en cambio, la interrupcion fue a causa de uns falling edge */
     else 
     {
-        /* Guardamos el tick actual en edgeTime e indicamos que es falling edge */
-        tecInfo.edgeTime = taskGetTickCount();
-        tecInfo.edge = FALLING_EDGE;
+        edge = FALLING_EDGE;
         /* Limpiamos el estado de falling edge */
         Chip_PININT_ClearFallStates(LPC_GPIO_PIN_INT,PININTCH(GPIO_CHANNEL_0));
     }
@@ -195,31 +216,24 @@ void GPIO0IRQHandler(void){
     /* Limpiamos el flag de interrupcion del GPIO_CHANNEL_0 */
     Chip_PININT_ClearIntStatus(LPC_GPIO_PIN_INT,PININTCH(GPIO_CHANNEL_0));
 
-    /* Hacemos el push dentro de una IRQ */
-    queuePushFromISR(&g_tecQueue, (void *)&(tecInfo));
+    /* El resto del procesamiento se hace fuera de la IRQ */
+    irqDefer(tecEdgeWork, (void *)(((uintptr_t)TEC1 << 1) | edge));
 }
 
 void GPIO1IRQHandler(void){
-    tecInfo_t tecInfo;
-
-    tecInfo.tec = TEC2;
+    edge_t edge;
 
     /* Si la interrupcion fue a causa de una rising edge */
     if (Chip_PININT_GetRiseStates(LPC_GPIO_PIN_INT) & PININTCH(GPIO_CHANNEL_1)) 
     {
-
-        /* Guardamos el tick actual en edgeTime e indicamos que es rising edge */
-        tecInfo.edgeTime = taskGetTickCount();
-        tecInfo.edge = RISING_EDGE;
+        edge = RISING_EDGE;
         /* Limpiamos el estado de rising edge */
         Chip_PININT_ClearRiseStates(LPC_GPIO_PIN_INT,PININTCH(GPIO_CHANNEL_1));
     }
     /* Si, en cambio, la interrupcion fue a causa de uns falling edge */
     else 
     {
-        /* Guardamos el tick actual en edgeTime e indicamos que es falling edge */
-        tecInfo.edgeTime = taskGetTickCount();
-        tecInfo.edge = FALLING_EDGE;
+        edge = FALLING_EDGE;
         /* Limpiamos el estado de falling edge */
         Chip_PININT_ClearFallStates(LPC_GPIO_PIN_INT,PININTCH(GPIO_CHANNEL_1));
     }
@@ -227,8 +241,8 @@ void GPIO1IRQHandler(void){
     /* Limpiamos el flag de interrupcion del GPIO_CHANNEL_1 */
     Chip_PININT_ClearIntStatus(LPC_GPIO_PIN_INT,PININTCH(GPIO_CHANNEL_1));
 
-    /* Hacemos el push dentro de una IRQ */
-    queuePushFromISR(&g_tecQueue, (void *)&(tecInfo));
+    /* El resto del procesamiento se hace fuera de la IRQ */
+    irqDefer(tecEdgeWork, (void *)(((uintptr_t)TEC2 << 1) | edge));
 }
 
 void pulseDetectorTask(void * parameters)
@@ -352,18 +366,18 @@ void pulseDetectorTask(void * parameters)
                     if(fallingEdgeTime[TEC2_INDEX] >= fallingEdgeTime[TEC1_INDEX])
                     {
                         ledInfo.led = LEDR;
-                        strcpy(logInfo.ledString, "Led Rojo");
+                        logInfo.ledString = "Led Rojo";
                     }
                     /* Si no, es el caso 4 == led azul */
                     else
                     {
                         ledInfo.led = LEDB;
-                        strcpy(logInfo.ledString, "Led Azul");
+                        logInfo.ledString = "Led Azul";
                     }
                     /* Mando a titilar el led */
                     queuePush(&g_ledQueue, (void *)(&ledInfo), OS_MAX_DELAY);
                     /* Envio el log */
-                    queuePush(&g_logQueue, (void *)(&logInfo), OS_MAX_DELAY);
+                    logPulse(&logInfo);
                 }
             break;
 
@@ -388,18 +402,18 @@ void pulseDetectorTask(void * parameters)
                     if(fallingEdgeTime[TEC2_INDEX] >= fallingEdgeTime[TEC1_INDEX])
                     {
                         ledInfo.led = LEDG;
-                        strcpy(logInfo.ledString, "Led Verde");
+                        logInfo.ledString = "Led Verde";
                     }
                     /* Si no, es el caso 3 == led amarillo */
                     else
                     {
                         ledInfo.led = LED2;
-                        strcpy(logInfo.ledString, "Led Amarillo");
+                        logInfo.ledString = "Led Amarillo";
                     }
                     /* Mando a titilar el led */
                     queuePush(&g_ledQueue, (void *)(&ledInfo), OS_MAX_DELAY);
                     /* Envio el log */
-                    queuePush(&g_logQueue, (void *)(&logInfo), OS_MAX_DELAY);
+                    logPulse(&logInfo);
                 }
             break;
 
@@ -409,25 +423,16 @@ void pulseDetectorTask(void * parameters)
 
 void logTask(void * parameters)
 {
-    char stringToSend[STRING_TO_SEND_LENGTH];
-    logInfo_t logInfo;
+    uint8_t  logBuffer[LOG_BUFFER_SIZE];
+    uint32_t len;
 
     while(TRUE)
     {
-        /* Esperamos hasta que haya que logear info porque hubo 2 flancos superpuestos */
-        queuePull(&g_logQueue, (void *)(&logInfo), OS_MAX_DELAY);
-        /* Formatemos el string a enviar */
-        sprintf(stringToSend, "%s encendido:\n\r"
-                "\t Tiempo encendido: %lu ms \n\r"
-                "\t Tiempo entre flancos descendentes: %lu ms \n\r"
-                "\t Tiempo entre flancos ascendentes: %lu ms \n\r"
-                , logInfo.ledString
-                , logInfo.risingEdgeTime + logInfo.fallingEdgeTime
-                , logInfo.fallingEdgeTime
-                , logInfo.risingEdgeTime);
-        /* Enviamos el string por UART */
-        uartWriteString(UART_USB, stringToSend);
-
+        /* Esperamos hasta que haya registros de log porque hubo 2 flancos superpuestos */
+        len = logRead(logBuffer, sizeof(logBuffer), OS_MAX_DELAY);
+        /* Enviamos los registros en binario por UART - Se copian al buffer de transmision, sin esperar a la UART.
+           El texto lo arma tools/oslog_decode.py en la PC */
+        uartWrite(UART_USB, logBuffer, len);
     }
 } 
 
@@ -455,16 +460,17 @@ int main(void)
 
     /* Configuramos UART */
     uartConfig(UART_USB, BAUDRATE_115200);
+    uartConfigTxBuffer(UART_USB, g_uartTxBuffer, sizeof(g_uartTxBuffer));
 
     /* Configuramos GPIO TEC 1*/
     gpioConfig(TEC1, GPIO_INPUT);
     gpioConfigIRQ(TEC1, GPIO_CHANNEL_0, BOTH_EDGE_INT);
-    irqAttach(PIN_INT0_IRQn, GPIO0IRQHandler);
+    irqAttach(PIN_INT0_IRQn, GPIO0IRQHandler, OS_MAX_SYSCALL_IRQ_PRIO);
 
     /* Configuramos GPIO TEC 2*/
     gpioConfig(TEC2, GPIO_INPUT);
     gpioConfigIRQ(TEC2, GPIO_CHANNEL_1, BOTH_EDGE_INT);
-    irqAttach(PIN_INT1_IRQn, GPIO1IRQHandler);
+    irqAttach(PIN_INT1_IRQn, GPIO1IRQHandler, OS_MAX_SYSCALL_IRQ_PRIO);
 
     /* Configuramos leds */
     gpioConfig(LED2, GPIO_OUTPUT);
@@ -475,13 +481,12 @@ int main(void)
     /* Inicializamos las colas */
     queueInit(&g_tecQueue, QUEUE_LEN, g_tecQueueBuffer, sizeof(tecInfo_t));
     queueInit(&g_ledQueue, QUEUE_LEN, g_ledQueueBuffer, sizeof(ledInfo_t));
-    queueInit(&g_logQueue, QUEUE_LEN, g_logQueueBuffer, sizeof(logInfo_t));
 
     /* Creacion de las tareas */
     /* Menor numero mayor prioridad */
-    taskCreate(pulseDetectorTask, 1, pulseDetectorTaskStack, OS_MINIMAL_STACK_SIZE, "plsDetTask", (void *)0);
-    taskCreate(ledTask, 2, ledTaskStack, OS_MINIMAL_STACK_SIZE, "ledTask", (void *)0);
-    taskCreate(logTask, 3, logTaskStack, OS_MINIMAL_STACK_SIZE, "logTask", (void *)0);
+    taskCreate(pulseDetectorTask, 1, pulseDetectorTaskStack, OS_MINIMAL_STACK_SIZE, "plsDetTask", (void *)0, NULL);
+    taskCreate(ledTask, 2, ledTaskStack, OS_MINIMAL_STACK_SIZE, "ledTask", (void *)0, NULL);
+    taskCreate(logTask, 3, logTaskStack, OS_MINIMAL_STACK_SIZE, "logTask", (void *)0, NULL);
       
     /* Start the scheduler */
     taskStartScheduler();
@@ -6,8 +6,74 @@
 /*==================[inclusions]=============================================*/
 #include "uart.h"
 #include "stdint.h"
+#include "OS.h"
+#include "OS_irq.h"
+#include "OS_stream.h"
+#include "OS_semphr.h"
+#include "OS_timer.h"
+#include <string.h>
 /*==================[macros and definitions]=================================*/
 #define UART_IRQ_PRIO   6
+
+/**
+* @def UART_USE_DMA
+* @brief El modo DMA entrega lo recibido en un buffer de stream, muestreado desde un timer del SO
+*/
+#define UART_USE_DMA    ( ( OS_USE_STREAM == 1 ) && ( OS_USE_TIMER == 1 ) )
+
+/**
+* @def UART_DMA_MAX_TRANSFER
+* @brief Maxima cantidad de bytes de un descriptor de GPDMA - El campo TransferSize es de 12 bits
+*/
+#define UART_DMA_MAX_TRANSFER   4095
+
+/**
+* @def UART_DMA_TX_DESCRIPTORS
+* @brief Cantidad de descriptores de cada transferencia de transmision por DMA
+*/
+#define UART_DMA_TX_DESCRIPTORS 8
+
+/**
+* @def UART_DMA_RX_WRITE_IDX(dma)
+* @brief Macro para obtener el proximo byte del anillo que escribira el DMA de recepcion
+*/
+#define UART_DMA_RX_WRITE_IDX(dma)  ( (LPC_GPDMA->CH[(dma)->rxChannel].DESTADDR - (uint32_t)(dma)->rxRing) % (dma)->rxRingSize )
+
+#if ( OS_USE_STREAM == 1 )
+/**
+* @struct uartTx_t
+* @brief Estado de la transmision por interrupcion de una UART.
+*/
+typedef struct{
+    stream_t        txStream;   /**< Buffer circular de transmision - buffer NULL si la UART no lo usa */
+    volatile bool   txActive;   /**< Indica si la IRQ de la UART esta vaciando el buffer */
+} uartTx_t;
+#endif
+
+#if UART_USE_DMA
+/**
+* @struct uartDma_t
+* @brief Estado del modo DMA de una UART.
+*/
+typedef struct{
+    bool                        enabled;        /**< Indica si la UART esta en modo DMA */
+    bool                        rxEnabled;      /**< Indica si la recepcion es por DMA */
+    uint8_t                     txChannel;      /**< Canal de GPDMA de transmision */
+    uint8_t                     rxChannel;      /**< Canal de GPDMA de recepcion */
+    volatile bool               txError;        /**< Indica si la ultima transferencia termino con error */
+    semaphore_t                 txLock;         /**< Canal de transmision libre - Serializa a las tareas que escriben */
+    semaphore_t                 txDone;         /**< Fin de la transferencia - Lo entrega la IRQ de GPDMA */
+    DMA_TransferDescriptor_t    txDesc[UART_DMA_TX_DESCRIPTORS];  /**< Lista de descriptores de transmision */
+    DMA_TransferDescriptor_t    rxDesc[2];      /**< Descriptores de cada mitad del anillo, enlazados entre si */
+    uint8_t *                   rxRing;         /**< Anillo en el que escribe el DMA - Provisto por el usuario */
+    uint32_t                    rxRingSize;     /**< Tamaño del anillo */
+    uint32_t                    rxReadIdx;      /**< Proximo byte del anillo a entregar al stream */
+    uint32_t                    rxLastWriteIdx; /**< Posicion de escritura del DMA en el muestreo anterior */
+    uint32_t                    rxLost;         /**< Bytes descartados por falta de lugar en el stream */
+    stream_t                    rxStream;       /**< Buffer de stream en el que se entregan los bytes recibidos */
+    osTimer_t                   rxTimer;        /**< Timer de muestreo del anillo */
+} uartDma_t;
+#endif
 /*==================[internal data declaration]==============================*/
 /**
 * @var lpcUarts
@@ -38,9 +104,320 @@ static const lpc4337ScuPin_t lpcUart485DirPin =
 {
    6, 2, FUNC2
 };
+
+#if ( OS_USE_STREAM == 1 )
+/**
+* @var g_uartTx
+* @brief Estado de la transmision por interrupcion de cada UART.
+*/
+static uartTx_t g_uartTx[UART_MAP_COUNT];
+#endif
+
+#if UART_USE_DMA
+/**
+* @var uartDmaConn
+* @brief Conexiones de GPDMA { Tx, Rx } de cada UART, 0 si la UART no esta disponible.
+*/
+static const uint8_t uartDmaConn[UART_MAP_COUNT][2] =
+{
+    { GPDMA_CONN_UART0_Tx, GPDMA_CONN_UART0_Rx }
+,   { GPDMA_CONN_UART0_Tx, GPDMA_CONN_UART0_Rx }
+,   { 0,                   0                   }
+,   { GPDMA_CONN_UART2_Tx, GPDMA_CONN_UART2_Rx }
+,   { GPDMA_CONN_UART2_Tx, GPDMA_CONN_UART2_Rx }
+,   { GPDMA_CONN_UART3_Tx, GPDMA_CONN_UART3_Rx }
+};
+
+/**
+* @var g_uartDma
+* @brief Estado del modo DMA de cada UART.
+*/
+static uartDma_t g_uartDma[UART_MAP_COUNT];
+
+/**
+* @var g_uartDmaInit
+* @brief Indica si ya se inicializo el GPDMA y se adjunto su IRQ.
+*/
+static bool g_uartDmaInit = false;
+
+/**
+* @var g_uartDmaChannels
+* @brief Mascara de los canales de GPDMA tomados por las UART.
+*/
+static uint32_t g_uartDmaChannels = 0;
+#endif
 /*==================[internal functions declaration]=========================*/
+#if UART_USE_DMA
+static uint8_t uartDmaRxStart(uartMap_t uart);
+#endif
 
 /*==================[internal functions definition]==========================*/
+#if ( OS_USE_STREAM == 1 )
+/**
+* @fn static void uartIrqHandler(uartMap_t uart)
+* @brief Manejador de la IRQ de la UART - Pasa bytes del buffer de transmision a la FIFO.
+* @param uart : UART que interrumpio.
+* @return Nada.
+* @note Sacar bytes del buffer despierta a las tareas que esperan lugar para escribir.
+* @note Con recepcion por DMA tambien arranca el timer de muestreo del anillo.
+*/
+static void uartIrqHandler(uartMap_t uart)
+{
+    LPC_USART_T * uartAddr = lpcUarts[uart].uartAddr;
+    uint8_t       data[UART_TX_FIFO_SIZE];
+    uint32_t      count;
+    uint32_t      i;
+
+    /* Leer el IIR limpia la interrupcion de THRE */
+    Chip_UART_ReadIntIDReg(uartAddr);
+
+#if UART_USE_DMA
+    /* Con recepcion por DMA la IRQ de recepcion solo avisa que la linea dejo de estar inactiva: el DMA
+       puede haber vaciado la FIFO antes de que se atienda, por lo que no se evalua el IIR */
+    if(g_uartDma[uart].rxEnabled && (Chip_UART_GetIntsEnabled(uartAddr) & UART_IER_RBRINT))
+    {
+        Chip_UART_IntDisable(uartAddr, UART_IER_RBRINT);
+        timerStartFromISR(&g_uartDma[uart].rxTimer);
+    }
+#endif
+
+    /* Con la FIFO vacia se pueden escribir UART_TX_FIFO_SIZE bytes sin esperar */
+    if(g_uartTx[uart].txActive && (Chip_UART_ReadLineStatus(uartAddr) & UART_LSR_THRE))
+    {
+        count = streamReceiveFromISR(&g_uartTx[uart].txStream, data, UART_TX_FIFO_SIZE);
+        for(i = 0; i < count; i++)
+        {
+            Chip_UART_SendByte(uartAddr, data[i]);
+        }
+
+        /* Buffer vacio: la transmision termina hasta el proximo uartWriteString() */
+        if(0 == count)
+        {
+            Chip_UART_IntDisable(uartAddr, UART_IER_THREINT);
+            g_uartTx[uart].txActive = false;
+        }
+    }
+}
+
+static void uart0IrqHandler(void){uartIrqHandler(UART_GPIO);}
+static void uart1IrqHandler(void){uartIrqHandler(UART_RS485);}
+static void uart3IrqHandler(void){uartIrqHandler(UART_USB);}
+static void uart4IrqHandler(void){uartIrqHandler(UART_ENET);}
+static void uart5IrqHandler(void){uartIrqHandler(UART_RS232);}
+
+/**
+* @var uartIrqHandlers
+* @brief Callback de IRQ de cada UART, para irqAttach().
+*/
+static const irqCbFunction_t uartIrqHandlers[UART_MAP_COUNT] =
+{
+    uart0IrqHandler, uart1IrqHandler, NULL, uart3IrqHandler, uart4IrqHandler, uart5IrqHandler
+};
+
+/**
+* @fn static void uartTxStart(uartMap_t uart)
+* @brief Arranca la transmision del buffer por interrupcion si la IRQ no lo esta vaciando.
+* @param uart : UART a utilizar.
+* @return Nada.
+* @note La IRQ de THRE solo se genera cuando la FIFO se vacia, por lo que la primera se fuerza por software.
+*/
+static void uartTxStart(uartMap_t uart)
+{
+    /* La seccion critica enmascara la IRQ de la UART, que tiene prioridad de llamadas al SO */
+    osSuspendContextSwitching();
+
+    if(!g_uartTx[uart].txActive && 0 < streamBytesAvailable(&g_uartTx[uart].txStream))
+    {
+        g_uartTx[uart].txActive = true;
+        Chip_UART_IntEnable(lpcUarts[uart].uartAddr, UART_IER_THREINT);
+        NVIC_SetPendingIRQ(lpcUarts[uart].uartIrqAddr);
+    }
+
+    osResumeContextSwitching();
+}
+#endif
+
+#if UART_USE_DMA
+/**
+* @fn static void uartDmaIrqHandler(void)
+* @brief Manejador de la IRQ de GPDMA - Avisa el fin de las transferencias de transmision y rearranca
+         la recepcion tras un error.
+* @param Ninguno.
+* @return Nada.
+* @note Solo el ultimo descriptor de transmision interrumpe; los de recepcion solo lo hacen por error.
+*/
+static void uartDmaIrqHandler(void)
+{
+    uartDma_t * dma;
+    uint32_t    mask;
+    uint8_t     uart;
+
+    for(uart = 0; uart < UART_MAP_COUNT; uart++)
+    {
+        dma = &g_uartDma[uart];
+        if(!dma->enabled)
+        {
+            continue;
+        }
+
+        mask = 1UL << dma->txChannel;
+        if(LPC_GPDMA->INTERRSTAT & mask)
+        {
+            /* Un error deshabilita el canal: la transferencia termina igual */
+            LPC_GPDMA->INTERRCLR = mask;
+            dma->txError = true;
+            semphrGiveFromISR(&dma->txDone);
+        }
+        else if(LPC_GPDMA->INTTCSTAT & mask)
+        {
+            LPC_GPDMA->INTTCCLEAR = mask;
+            semphrGiveFromISR(&dma->txDone);
+        }
+
+        if(dma->rxEnabled && (LPC_GPDMA->INTERRSTAT & (1UL << dma->rxChannel)))
+        {
+            /* El error detiene el canal de recepcion: se rearranca desde el comienzo del anillo y se
+               descartan los bytes aun no entregados */
+            LPC_GPDMA->INTERRCLR = 1UL << dma->rxChannel;
+            uartDmaRxStart((uartMap_t)uart);
+        }
+    }
+}
+
+/**
+* @fn static void uartDmaRxPoll(osTimer_t * timer)
+* @brief Callback del timer de muestreo - Entrega al stream los bytes que el DMA escribio en el anillo.
+* @param timer : Timer de la UART, con la UART como parametro.
+* @return Nada.
+* @note Los bytes se entregan en un unico bloque cuando la linea queda inactiva un periodo de muestreo
+        (la posicion de escritura no cambio), o antes si hay medio anillo pendiente.
+* @note El DMA mantiene vacia la FIFO de recepcion, por lo que la IRQ de timeout de caracter (CTI) de la
+        UART no se genera: la inactividad de la linea se detecta por software. Con la linea inactiva y
+        todo entregado el timer se detiene y lo vuelve a arrancar la IRQ de recepcion de la UART.
+*/
+static void uartDmaRxPoll(osTimer_t * timer)
+{
+    uartMap_t   uart = (uartMap_t)(uint32_t)timer->parameters;
+    uartDma_t * dma  = &g_uartDma[uart];
+    uint32_t    writeIdx;   /**< Proximo byte del anillo que escribira el DMA */
+    uint32_t    readIdx;    /**< Proximo byte del anillo a entregar */
+    uint32_t    pending;    /**< Bytes escritos por el DMA y no entregados */
+    uint32_t    chunk;
+    uint32_t    sent;
+
+    /* La seccion critica enmascara las IRQ de la UART y de GPDMA, que modifican el estado de la recepcion */
+    osSuspendContextSwitching();
+
+    /* DESTADDR apunta al proximo byte a escribir, en la mitad del anillo que este recorriendo el DMA */
+    writeIdx = UART_DMA_RX_WRITE_IDX(dma);
+    readIdx  = dma->rxReadIdx;
+    pending  = (writeIdx + dma->rxRingSize - readIdx) % dma->rxRingSize;
+
+    if(0 < pending && (writeIdx == dma->rxLastWriteIdx || pending >= dma->rxRingSize / 2))
+    {
+        dma->rxReadIdx = writeIdx;
+    }
+    else if(0 == pending && writeIdx == dma->rxLastWriteIdx)
+    {
+        /* Linea inactiva: el muestreo se detiene hasta la proxima IRQ de recepcion. Un byte que el DMA
+           haya copiado antes de habilitarla no la genera, por lo que se vuelve a leer la posicion */
+        timerStop(timer);
+        Chip_UART_IntEnable(lpcUarts[uart].uartAddr, UART_IER_RBRINT);
+        if(writeIdx != UART_DMA_RX_WRITE_IDX(dma))
+        {
+            Chip_UART_IntDisable(lpcUarts[uart].uartAddr, UART_IER_RBRINT);
+            timerStart(timer);
+        }
+        pending = 0;
+    }
+    else
+    {
+        pending = 0;
+    }
+    dma->rxLastWriteIdx = writeIdx;
+
+    osResumeContextSwitching();
+
+    while(0 < pending)
+    {
+        /* Lo pendiente puede dar la vuelta al anillo */
+        chunk = dma->rxRingSize - readIdx;
+        if(chunk > pending)
+        {
+            chunk = pending;
+        }
+
+        sent = streamSend(&dma->rxStream, dma->rxRing + readIdx, chunk, 0);
+        dma->rxLost += chunk - sent;
+        readIdx      = (readIdx + chunk) % dma->rxRingSize;
+        pending     -= chunk;
+    }
+}
+
+/**
+* @fn static uint8_t uartDmaRxStart(uartMap_t uart)
+* @brief Arranca la recepcion por DMA sobre un anillo de dos descriptores enlazados entre si.
+* @param uart : UART a utilizar.
+* @return TRUE si arranco el canal, FALSE caso contrario.
+*/
+static uint8_t uartDmaRxStart(uartMap_t uart)
+{
+    uartDma_t *              dma  = &g_uartDma[uart];
+    uint32_t                 half = dma->rxRingSize / 2;
+    DMA_TransferDescriptor_t head;
+
+    /* Con siguiente descriptor Chip_GPDMA_PrepareDescriptor() no habilita la IRQ de fin de cuenta */
+    Chip_GPDMA_PrepareDescriptor(LPC_GPDMA, &dma->rxDesc[0], uartDmaConn[uart][1], (uint32_t)dma->rxRing,
+                                 half, GPDMA_TRANSFERTYPE_P2M_CONTROLLER_DMA, &dma->rxDesc[1]);
+    Chip_GPDMA_PrepareDescriptor(LPC_GPDMA, &dma->rxDesc[1], uartDmaConn[uart][1], (uint32_t)(dma->rxRing + half),
+                                 half, GPDMA_TRANSFERTYPE_P2M_CONTROLLER_DMA, &dma->rxDesc[0]);
+
+    /* Chip_GPDMA_SGTransfer() toma el periferico del primer descriptor, que debe indicarlo con el
+       numero de conexion y no con la direccion del registro */
+    head     = dma->rxDesc[0];
+    head.src = uartDmaConn[uart][1];
+
+    dma->rxReadIdx      = 0;
+    dma->rxLastWriteIdx = 0;
+
+    return (SUCCESS == Chip_GPDMA_SGTransfer(LPC_GPDMA, dma->rxChannel, &head,
+                                             GPDMA_TRANSFERTYPE_P2M_CONTROLLER_DMA)) ? TRUE : FALSE;
+}
+
+/**
+* @fn static uint8_t uartDmaGetChannel(uint8_t conn, uint8_t * channel)
+* @brief Toma un canal libre de GPDMA.
+* @param conn    : Conexion de GPDMA del periferico.
+* @param channel : Canal tomado.
+* @return TRUE si habia un canal libre, FALSE caso contrario.
+* @note Chip_GPDMA_GetFreeChannel() devuelve 0 tanto si toma el canal 0 como si no hay canales libres:
+        los canales se toman en orden, por lo que devolver un canal ya tomado indica que no hay libres.
+*/
+static uint8_t uartDmaGetChannel(uint8_t conn, uint8_t * channel)
+{
+    *channel = Chip_GPDMA_GetFreeChannel(LPC_GPDMA, conn);
+    if(g_uartDmaChannels & (1UL << *channel))
+    {
+        return FALSE;
+    }
+
+    g_uartDmaChannels |= 1UL << *channel;
+
+    return TRUE;
+}
+
+/**
+* @fn static void uartDmaFreeChannel(uint8_t channel)
+* @brief Detiene y libera un canal de GPDMA tomado con uartDmaGetChannel().
+* @param channel : Canal a liberar.
+* @return Nada.
+*/
+static void uartDmaFreeChannel(uint8_t channel)
+{
+    Chip_GPDMA_Stop(LPC_GPDMA, channel);
+    g_uartDmaChannels &= ~(1UL << channel);
+}
+#endif
 
 /*==================[external functions definition]==========================*/
 
@@ -145,12 +522,248 @@ void uartWriteByte(uartMap_t uart, uint8_t data)
     Chip_UART_SendByte(lpcUarts[uart].uartAddr, data);
 }
 
-void uartWriteString(uartMap_t uart, char* data)
+#if ( OS_USE_STREAM == 1 )
+uint8_t uartConfigTxBuffer(uartMap_t uart, uint8_t *buffer, uint32_t size)
+{
+    if(NULL == uartIrqHandlers[uart] || NULL != g_uartTx[uart].txStream.buffer ||
+       OS_RESULT_OK != streamInit(&g_uartTx[uart].txStream, buffer, size, 1))
+    {
+        return FALSE;
+    }
+
+    g_uartTx[uart].txActive = false;
+#if UART_USE_DMA
+    /* Con recepcion por DMA la IRQ de la UART ya esta adjunta */
+    if(g_uartDma[uart].rxEnabled)
+    {
+        return TRUE;
+    }
+#endif
+    if(OS_RESULT_OK != irqAttach(lpcUarts[uart].uartIrqAddr, uartIrqHandlers[uart], UART_IRQ_PRIO))
+    {
+        g_uartTx[uart].txStream.buffer = NULL;
+        return FALSE;
+    }
+
+    return TRUE;
+}
+#endif
+
+#if UART_USE_DMA
+uint8_t uartConfigDma(uartMap_t uart, uint8_t *rxRing, uint32_t rxRingSize, uint8_t *rxBuffer, uint32_t rxBufferSize)
+{
+    uartDma_t * dma = &g_uartDma[uart];
+    uint8_t     i;
+
+    if(0 == uartDmaConn[uart][0] || dma->enabled)
+    {
+        return FALSE;
+    }
+
+    /* Las UART que comparten periferico no pueden estar en modo DMA a la vez */
+    for(i = 0; i < UART_MAP_COUNT; i++)
+    {
+        if(g_uartDma[i].enabled && lpcUarts[i].uartAddr == lpcUarts[uart].uartAddr)
+        {
+            return FALSE;
+        }
+    }
+
+    if(NULL != rxRing && (0 != rxRingSize % 2 || 0 == rxRingSize || rxRingSize / 2 > UART_DMA_MAX_TRANSFER ||
+       OS_RESULT_OK != streamInit(&dma->rxStream, rxBuffer, rxBufferSize, 1)))
+    {
+        return FALSE;
+    }
+
+    if(!g_uartDmaInit)
+    {
+        Chip_GPDMA_Init(LPC_GPDMA);
+        if(OS_RESULT_OK != irqAttach(DMA_IRQn, uartDmaIrqHandler, UART_IRQ_PRIO))
+        {
+            return FALSE;
+        }
+        g_uartDmaInit = true;
+    }
+
+    /* La UART pide transferencias al GPDMA en lugar de interrumpir */
+    Chip_UART_SetupFIFOS(lpcUarts[uart].uartAddr, UART_FCR_FIFO_EN     |
+                                                  UART_FCR_TX_RS       |
+                                                  UART_FCR_RX_RS       |
+                                                  UART_FCR_DMAMODE_SEL |
+                                                  UART_FCR_TRG_LEV0);
+
+    semphrInitCounting(&dma->txLock, 1, 1);
+    semphrInit(&dma->txDone);
+    dma->txError   = false;
+    dma->rxLost    = 0;
+    if(TRUE != uartDmaGetChannel(uartDmaConn[uart][0], &dma->txChannel))
+    {
+        return FALSE;
+    }
+
+    if(NULL != rxRing)
+    {
+        dma->rxRing     = rxRing;
+        dma->rxRingSize = rxRingSize;
+
+        /* La IRQ de la UART arranca el muestreo del anillo. Si la UART ya transmite por interrupcion
+           la IRQ ya esta adjunta */
+        if(TRUE != uartDmaGetChannel(uartDmaConn[uart][1], &dma->rxChannel) ||
+           (NULL == g_uartTx[uart].txStream.buffer &&
+            OS_RESULT_OK != irqAttach(lpcUarts[uart].uartIrqAddr, uartIrqHandlers[uart], UART_IRQ_PRIO)))
+        {
+            uartDmaFreeChannel(dma->txChannel);
+            return FALSE;
+        }
+
+        if(TRUE != uartDmaRxStart(uart))
+        {
+            uartDmaFreeChannel(dma->txChannel);
+            uartDmaFreeChannel(dma->rxChannel);
+            return FALSE;
+        }
+
+        /* El timer arranca con la primera IRQ de recepcion */
+        timerInit(&dma->rxTimer, UART_DMA_RX_IDLE_TICKS, true, uartDmaRxPoll, (void *)(uint32_t)uart);
+        dma->rxEnabled = true;
+        Chip_UART_IntEnable(lpcUarts[uart].uartAddr, UART_IER_RBRINT);
+    }
+
+    dma->enabled = true;
+
+    return TRUE;
+}
+
+uint8_t uartWriteDma(uartMap_t uart, const uartDmaSegment_t *segments, uint32_t count, tick_t delay)
 {
-    while(*data)
+    uartDma_t *              dma = &g_uartDma[uart];
+    DMA_TransferDescriptor_t head;
+    uint32_t                 n = 0;     /**< Cantidad de descriptores de la transferencia */
+    uint32_t                 offset;
+    uint32_t                 size;
+    uint32_t                 i;
+    uint8_t                  retVal = FALSE;
+
+    if(!dma->enabled || OS_INVALID_TASK == osGetCurrentTask() ||
+       OS_RESULT_OK != semphrTake(&dma->txLock, delay))
+    {
+        return FALSE;
+    }
+
+    /* Cada segmento ocupa uno o mas descriptores de hasta UART_DMA_MAX_TRANSFER bytes */
+    for(i = 0; i < count && n <= UART_DMA_TX_DESCRIPTORS; i++)
+    {
+        for(offset = 0; offset < segments[i].size && n <= UART_DMA_TX_DESCRIPTORS; offset += size)
+        {
+            size = segments[i].size - offset;
+            if(size > UART_DMA_MAX_TRANSFER)
+            {
+                size = UART_DMA_MAX_TRANSFER;
+            }
+
+            if(n < UART_DMA_TX_DESCRIPTORS)
+            {
+                Chip_GPDMA_PrepareDescriptor(LPC_GPDMA, &dma->txDesc[n], (uint32_t)(segments[i].data + offset),
+                                             uartDmaConn[uart][0], size, GPDMA_TRANSFERTYPE_M2P_CONTROLLER_DMA, NULL);
+            }
+            n++;
+        }
+    }
+
+    if(0 < n && n <= UART_DMA_TX_DESCRIPTORS)
     {
-       uartWriteByte(uart, (uint8_t)*data);
+        /* Solo el ultimo descriptor interrumpe al terminar */
+        for(i = 0; i + 1 < n; i++)
+        {
+            dma->txDesc[i].lli   = (uint32_t)&dma->txDesc[i + 1];
+            dma->txDesc[i].ctrl &= ~GPDMA_DMACCxControl_I;
+        }
+
+        /* Chip_GPDMA_SGTransfer() toma el periferico del primer descriptor, que debe indicarlo con el
+           numero de conexion y no con la direccion del registro */
+        head     = dma->txDesc[0];
+        head.dst = uartDmaConn[uart][0];
+
+        dma->txError = false;
+        if(SUCCESS == Chip_GPDMA_SGTransfer(LPC_GPDMA, dma->txChannel, &head, GPDMA_TRANSFERTYPE_M2P_CONTROLLER_DMA))
+        {
+            semphrTake(&dma->txDone, OS_MAX_DELAY);
+            retVal = dma->txError ? FALSE : TRUE;
+        }
+    }
+
+    semphrGive(&dma->txLock);
+
+    return retVal;
+}
+
+uint32_t uartReadDma(uartMap_t uart, uint8_t *data, uint32_t size, tick_t delay)
+{
+    if(!g_uartDma[uart].rxEnabled)
+    {
+        return 0;
+    }
+
+    return streamReceive(&g_uartDma[uart].rxStream, data, size, delay);
+}
+
+uint32_t uartGetDmaRxLost(uartMap_t uart)
+{
+    return g_uartDma[uart].rxLost;
+}
+#endif
+
+void uartWrite(uartMap_t uart, const uint8_t *data, uint32_t size)
+{
+    #if UART_USE_DMA
+        uartDmaSegment_t segment;
+
+        /* En modo DMA la tarea espera bloqueada el fin de la transferencia */
+        if(g_uartDma[uart].enabled && OS_INVALID_TASK != osGetCurrentTask())
+        {
+            segment.data = data;
+            segment.size = size;
+            uartWriteDma(uart, &segment, 1, OS_MAX_DELAY);
+            return;
+        }
+    #endif
+    #if ( OS_USE_STREAM == 1 )
+        uint32_t len = size;
+        uint32_t sent;
+
+        /* Con buffer y el scheduler corriendo la transmision es por interrupcion */
+        if(NULL != g_uartTx[uart].txStream.buffer && OS_INVALID_TASK != osGetCurrentTask())
+        {
+            while(0 < len)
+            {
+                /* Copiamos lo que entra y arrancamos la transmision */
+                sent = streamSend(&g_uartTx[uart].txStream, data, len, 0);
+                uartTxStart(uart);
+
+                /* Si no entro todo esperamos bloqueados a que la IRQ libere lugar, y enviamos un byte */
+                if(sent < len)
+                {
+                    sent += streamSend(&g_uartTx[uart].txStream, data + sent, 1, OS_MAX_DELAY);
+                }
+                data += sent;
+                len  -= sent;
+            }
+            /* El ultimo byte copiado tambien debe arrancar la transmision */
+            uartTxStart(uart);
+            return;
+        }
+    #endif
+
+    while(0 < size)
+    {
+       uartWriteByte(uart, *data);
        data++;
+       size--;
    }
 }
+
+void uartWriteString(uartMap_t uart, char* data)
+{
+    uartWrite(uart, (const uint8_t *)data, strlen(data));
+}
 /*==================[end of file]============================================*/
\ No newline at end of file
@@ -0,0 +1,61 @@
+/**
+* @file  main.c
+* @brief Micro-benchmarks del kernel sobre el port de host - Los resultados salen por stdout
+* @note  Copyright 2019 - Esp. Ing. Matias Alvarez.
+*/
+
+/*==================[inclusions]=============================================*/
+#include "OS_config.h"
+#include "OS.h"
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+/*==================[macros]=================================================*/
+
+/*==================[typedef]================================================*/
+
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+* @fn static void benchPrint(const char * line)
+* @brief Imprime una linea de resultados
+* @param line : Linea a imprimir
+* @return Nada
+*/
+static void benchPrint(const char * line)
+{
+    fputs(line, stdout);
+    fflush(stdout);
+}
+
+/**
+* @fn static void benchDone(void)
+* @brief Termina el proceso al terminar los benchmarks
+* @param Ninguno
+* @return Nada
+*/
+static void benchDone(void)
+{
+    exit(0);
+}
+/*==================[external functions definition]==========================*/
+int main(int argc, char * argv[])
+{
+    /* Creacion de la tarea de benchmarks */
+    benchInit(benchPrint, benchDone);
+
+    /* Start the scheduler */
+    taskStartScheduler();
+
+    /* No se deberia arribar aqui nunca */
+    return 1;
+}
+
+/*==================[end of file]============================================*/
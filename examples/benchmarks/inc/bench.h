@@ -0,0 +1,95 @@
+/**
+* @file  bench.h
+* @brief Micro-benchmarks del kernel
+* @note  Cada resultado se imprime en una linea CSV:
+         bench,<nombre>,<parametro>,<muestras>,<min>,<promedio>,<max>,<unidad>
+         Las lineas que empiezan con # son comentarios
+* @note  Copyright 2019 - Esp. Ing. Matias Alvarez.
+*/
+#ifndef _BENCH_H_
+#define _BENCH_H_
+/*==================[inclusions]=============================================*/
+#include "OS_config.h"
+#include "OS.h"
+#include "OS_port.h"
+#include "OS_irq.h"
+/*==================[macros]=================================================*/
+/**
+* @def BENCH_NOW()
+* @brief Marca de tiempo de las mediciones - Ciclos del DWT en el target, nanosegundos en el host
+*/
+#define BENCH_NOW()                 OS_PORT_CYCLE_COUNT()
+
+/**
+* @def BENCH_SAMPLES
+* @brief Cantidad de muestras de cada benchmark
+*/
+#define BENCH_SAMPLES               1000
+
+/**
+* @def BENCH_TASK_PRIORITY
+* @brief Prioridad de la tarea de benchmarks - Las tareas auxiliares usan una prioridad mas
+*/
+#define BENCH_TASK_PRIORITY         OS_MAX_TASK_PRIORITY
+
+/**
+* @def BENCH_TASK_STACK_SIZE
+* @brief Tamaño del stack de la tarea de benchmarks - Usa snprintf(), a diferencia de las tareas auxiliares
+*/
+#if ( OS_MINIMAL_STACK_SIZE < 2048 )
+    #define BENCH_TASK_STACK_SIZE   2048
+#else
+    #define BENCH_TASK_STACK_SIZE   OS_MINIMAL_STACK_SIZE
+#endif
+
+#if defined(OS_PORT_HOST)
+    /**
+    * @def BENCH_UNIT
+    * @brief Unidad de los resultados
+    */
+    #define BENCH_UNIT              "ns"
+
+    /**
+    * @def BENCH_IRQ
+    * @brief IRQ que se genera por software para medir la latencia IRQ->tarea
+    */
+    #define BENCH_IRQ               0
+
+    /**
+    * @def BENCH_TRIGGER_IRQ()
+    * @brief Genera la IRQ BENCH_IRQ
+    */
+    #define BENCH_TRIGGER_IRQ()     irqInject(BENCH_IRQ)
+#else
+    #define BENCH_UNIT              "cycles"
+    /* El QEI no se usa: su IRQ queda libre para generarla por software */
+    #define BENCH_IRQ               QEI_IRQn
+    #define BENCH_TRIGGER_IRQ()     NVIC_SetPendingIRQ(BENCH_IRQ)
+#endif
+/*==================[typedef]================================================*/
+/**
+* @def void (*benchPrint_t)(const char *)
+* @brief Definicion de prototipo de la funcion que imprime cada linea de resultados
+*/
+typedef void (*benchPrint_t)(const char *);
+
+/**
+* @def void (*benchDone_t)(void)
+* @brief Definicion de prototipo de la funcion que se llama al terminar los benchmarks
+*/
+typedef void (*benchDone_t)(void);
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+
+/*==================[external functions definition]==========================*/
+osReturn_t benchInit(benchPrint_t print, benchDone_t done);
+
+/*==================[end of file]============================================*/
+#endif /* #ifndef _BENCH_H_ */
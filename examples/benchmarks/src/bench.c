@@ -0,0 +1,682 @@
+/**
+* @file  bench.c
+* @brief Micro-benchmarks del kernel
+* @note  Una unica tarea corre los benchmarks en orden y crea las tareas auxiliares de cada uno,
+         que se borran a si mismas al terminar. Mide:
+         - Cambio de contexto entre dos tareas de igual prioridad con taskYield()
+         - Ida y vuelta semphrGive()/semphrTake() con una tarea de mayor prioridad
+         - Costo por elemento de queuePush()/queuePull() segun el tamaño del elemento
+         - Latencia IRQ->tarea a traves de queuePushFromISR()
+         - Costo de la IRQ del SysTick y de su actualizacion de tareas demoradas segun la cantidad de
+           tareas demoradas, sin vencimientos y con todas venciendo en el tick medido
+         - Costo de OS_LOG() frente a formatear el mismo texto con snprintf()
+* @note  Copyright 2019 - Esp. Ing. Matias Alvarez.
+*/
+
+/*==================[inclusions]=============================================*/
+#include "bench.h"
+#include "OS_semphr.h"
+#include "OS_queue.h"
+#include "OS_ring.h"
+#include "OS_log.h"
+#include <stdio.h>
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+/**
+* @def BENCH_LINE_LENGTH
+* @brief Largo maximo de una linea de resultados
+*/
+#define BENCH_LINE_LENGTH           96
+
+/**
+* @def BENCH_HELPERS
+* @brief Cantidad de stacks para tareas auxiliares - Tantos como tareas demoradas en benchSysTick()
+*/
+#define BENCH_HELPERS               64
+
+/**
+* @def BENCH_QUEUE_LEN
+* @brief Elementos que se cargan y descargan de la cola en cada muestra
+*/
+#define BENCH_QUEUE_LEN             16
+
+/**
+* @def BENCH_QUEUE_MAX_ELEMENT
+* @brief Tamaño maximo de elemento medido en la cola
+*/
+#define BENCH_QUEUE_MAX_ELEMENT     64
+
+/**
+* @def BENCH_QUEUE_SAMPLES
+* @brief Cantidad de muestras por tamaño de elemento - Cada una carga y descarga la cola completa
+*/
+#define BENCH_QUEUE_SAMPLES         100
+
+/**
+* @def BENCH_TICK_SAMPLES
+* @brief Cantidad de IRQs del SysTick medidas por cantidad de tareas
+*/
+#define BENCH_TICK_SAMPLES          200
+
+#if ( OS_MAX_TASK <= BENCH_HELPERS )
+    #error OS_MAX_TASK must be greater than BENCH_HELPERS: compile the benchmarks with OS_BENCH defined.
+#endif
+
+#if ( OS_USE_TICK_PROFILE != 1 )
+    #error OS_USE_TICK_PROFILE must be defined to be equal to 1: compile the benchmarks with OS_BENCH defined.
+#endif
+
+/**
+* @def BENCH_SLEEP_TICKS
+* @brief Delay de las tareas demoradas del benchmark del SysTick - Mayor a la duracion del benchmark
+*/
+#define BENCH_SLEEP_TICKS           100000
+
+/**
+* @def BENCH_LOG_BATCH
+* @brief Registros de log encolados en cada muestra - Entran en la cola sin descartes
+*/
+#define BENCH_LOG_BATCH             ( OS_LOG_QUEUE_LEN / 2 )
+/*==================[typedef]================================================*/
+/**
+* @struct benchStats_t
+* @brief Acumulador de las muestras de un benchmark
+*/
+typedef struct
+{
+    uint32_t    count;      /**< Cantidad de muestras */
+    uint32_t    min;        /**< Menor muestra */
+    uint32_t    max;        /**< Mayor muestra */
+    uint64_t    sum;        /**< Suma de las muestras */
+}benchStats_t;
+/*==================[internal data declaration]==============================*/
+/**
+* @var static benchPrint_t g_benchPrint
+* @brief Funcion que imprime las lineas de resultados
+*/
+static benchPrint_t g_benchPrint = NULL;
+
+/**
+* @var static benchDone_t g_benchDone
+* @brief Funcion que se llama al terminar, puede ser NULL
+*/
+static benchDone_t g_benchDone = NULL;
+
+/**
+* @var static uint32_t g_benchTaskStack[BENCH_TASK_STACK_SIZE / sizeof(uint32_t)]
+* @brief Stack de la tarea de benchmarks
+*/
+static uint32_t g_benchTaskStack[BENCH_TASK_STACK_SIZE / sizeof(uint32_t)];
+
+/**
+* @var static uint32_t g_benchHelperStack[BENCH_HELPERS][OS_MINIMAL_STACK_SIZE / sizeof(uint32_t)]
+* @brief Stacks de las tareas auxiliares
+*/
+static uint32_t g_benchHelperStack[BENCH_HELPERS][OS_MINIMAL_STACK_SIZE / sizeof(uint32_t)];
+
+/**
+* @var static volatile uint32_t g_benchStamp
+* @brief Marca de tiempo que una tarea deja para que la mida otra
+*/
+static volatile uint32_t g_benchStamp;
+
+/**
+* @var static volatile bool g_benchStop
+* @brief Indica a la tarea auxiliar que debe terminar
+*/
+static volatile bool g_benchStop;
+
+/**
+* @var static benchStats_t g_benchStats[2]
+* @brief Acumuladores del benchmark en curso
+*/
+static benchStats_t g_benchStats[2];
+
+static semaphore_t g_pingSem;
+static semaphore_t g_pongSem;
+
+/**
+* @var static queue_t g_benchQueue
+* @brief Cola de los benchmarks de colas y de latencia IRQ->tarea
+*/
+static queue_t g_benchQueue;
+static uint8_t g_benchQueueBuffer[(BENCH_QUEUE_LEN + 1) * BENCH_QUEUE_MAX_ELEMENT];
+
+#if ( OS_USE_RING == 1 )
+/**
+* @var static ring_t g_benchRing
+* @brief Cola lock-free de los benchmarks de ring_t - Comparte el buffer de g_benchQueue
+*/
+static ring_t g_benchRing;
+
+/**
+* @var static volatile bool g_benchUseRing
+* @brief Indica si el benchmark de latencia IRQ->tarea usa g_benchRing en lugar de g_benchQueue
+*/
+static volatile bool g_benchUseRing;
+#endif
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+* @fn static void benchReset(benchStats_t * stats)
+* @brief Funcion que vacia un acumulador
+* @param  stats : Puntero al acumulador
+* @return Nada
+*/
+static void benchReset(benchStats_t * stats)
+{
+    stats->count = 0;
+    stats->min   = UINT32_MAX;
+    stats->max   = 0;
+    stats->sum   = 0;
+}
+
+/**
+* @fn static void benchRecord(benchStats_t * stats, uint32_t value)
+* @brief Funcion que agrega una muestra a un acumulador
+* @param  stats : Puntero al acumulador
+* @param  value : Muestra
+* @return Nada
+*/
+static void benchRecord(benchStats_t * stats, uint32_t value)
+{
+    stats->count++;
+    stats->sum += value;
+    if(value < stats->min)
+    {
+        stats->min = value;
+    }
+    if(value > stats->max)
+    {
+        stats->max = value;
+    }
+}
+
+/**
+* @fn static void benchReport(const char * name, uint32_t param, benchStats_t * stats)
+* @brief Funcion que imprime la linea de resultados de un benchmark
+* @param  name  : Nombre del benchmark
+* @param  param : Parametro del benchmark, 0 si no tiene
+* @param  stats : Puntero al acumulador
+* @return Nada
+*/
+static void benchReport(const char * name, uint32_t param, benchStats_t * stats)
+{
+    char line[BENCH_LINE_LENGTH];
+
+    if(0 == stats->count)
+    {
+        stats->min = 0;
+    }
+
+    snprintf(line, sizeof(line), "bench,%s,%lu,%lu,%lu,%lu,%lu,%s\n", name, (unsigned long)param,
+             (unsigned long)stats->count, (unsigned long)stats->min,
+             (unsigned long)(0 < stats->count ? stats->sum / stats->count : 0),
+             (unsigned long)stats->max, BENCH_UNIT);
+    g_benchPrint(line);
+}
+
+/**
+* @fn static void yieldTask(void * parameters)
+* @brief Tarea auxiliar del benchmark de cambio de contexto - Marca el tiempo y cede la CPU
+* @param  parameters : No se usa
+* @return Nada
+*/
+static void yieldTask(void * parameters)
+{
+    while(!g_benchStop)
+    {
+        g_benchStamp = BENCH_NOW();
+        taskYield();
+    }
+
+    taskDelete(osGetCurrentTask());
+}
+
+/**
+* @fn static void benchContextSwitch(void)
+* @brief Benchmark del cambio de contexto a traves de la PendSV
+* @param  Ninguno
+* @return Nada
+* @note Mide desde la marca de la tarea auxiliar, antes de su taskYield(), hasta que vuelve
+        a correr la tarea de benchmarks
+*/
+static void benchContextSwitch(void)
+{
+    uint32_t i;
+
+    benchReset(&g_benchStats[0]);
+    g_benchStop = false;
+    taskCreate(yieldTask, BENCH_TASK_PRIORITY, g_benchHelperStack[0], sizeof(g_benchHelperStack[0]),
+               "yieldTask", (void *)0, NULL);
+
+    for(i = 0; i < BENCH_SAMPLES; i++)
+    {
+        taskYield();
+        benchRecord(&g_benchStats[0], BENCH_NOW() - g_benchStamp);
+    }
+
+    g_benchStop = true;
+    taskYield();
+
+    benchReport("context_switch", 0, &g_benchStats[0]);
+}
+
+/**
+* @fn static void pongTask(void * parameters)
+* @brief Tarea auxiliar del benchmark de semaforos - Responde cada ping con un pong
+* @param  parameters : No se usa
+* @return Nada
+*/
+static void pongTask(void * parameters)
+{
+    while(1)
+    {
+        semphrTake(&g_pingSem, OS_MAX_DELAY);
+        if(g_benchStop)
+        {
+            break;
+        }
+        semphrGive(&g_pongSem);
+    }
+
+    taskDelete(osGetCurrentTask());
+}
+
+/**
+* @fn static void benchSemphrPingPong(void)
+* @brief Benchmark de ida y vuelta con semaforos binarios
+* @param  Ninguno
+* @return Nada
+* @note Cada muestra incluye dos semphrGive(), dos semphrTake() y dos cambios de contexto
+*/
+static void benchSemphrPingPong(void)
+{
+    uint32_t i;
+    uint32_t start;
+
+    benchReset(&g_benchStats[0]);
+    g_benchStop = false;
+    semphrInit(&g_pingSem);
+    semphrInit(&g_pongSem);
+    taskCreate(pongTask, BENCH_TASK_PRIORITY - 1, g_benchHelperStack[0], sizeof(g_benchHelperStack[0]),
+               "pongTask", (void *)0, NULL);
+
+    for(i = 0; i < BENCH_SAMPLES; i++)
+    {
+        start = BENCH_NOW();
+        semphrGive(&g_pingSem);
+        semphrTake(&g_pongSem, OS_MAX_DELAY);
+        benchRecord(&g_benchStats[0], BENCH_NOW() - start);
+    }
+
+    g_benchStop = true;
+    semphrGive(&g_pingSem);
+
+    benchReport("semphr_pingpong", 0, &g_benchStats[0]);
+}
+
+/**
+* @fn static void benchQueue(void)
+* @brief Benchmark del costo por elemento de queuePush() y queuePull() sin bloqueo
+* @param  Ninguno
+* @return Nada
+*/
+static void benchQueue(void)
+{
+    static const uint32_t sizes[] = { 1, 4, 16, BENCH_QUEUE_MAX_ELEMENT };
+    uint8_t  element[BENCH_QUEUE_MAX_ELEMENT] = { 0 };
+    uint32_t start;
+    uint32_t middle;
+    uint32_t i;
+    uint32_t j;
+    uint32_t k;
+
+    for(i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+    {
+        benchReset(&g_benchStats[0]);
+        benchReset(&g_benchStats[1]);
+        /* La cola guarda un elemento menos que su largo */
+        queueInit(&g_benchQueue, BENCH_QUEUE_LEN + 1, g_benchQueueBuffer, sizes[i]);
+
+        for(j = 0; j < BENCH_QUEUE_SAMPLES; j++)
+        {
+            start = BENCH_NOW();
+            for(k = 0; k < BENCH_QUEUE_LEN; k++)
+            {
+                queuePush(&g_benchQueue, element, 0);
+            }
+            middle = BENCH_NOW();
+            for(k = 0; k < BENCH_QUEUE_LEN; k++)
+            {
+                queuePull(&g_benchQueue, element, 0);
+            }
+            benchRecord(&g_benchStats[0], (middle - start) / BENCH_QUEUE_LEN);
+            benchRecord(&g_benchStats[1], (BENCH_NOW() - middle) / BENCH_QUEUE_LEN);
+        }
+
+        benchReport("queue_push", sizes[i], &g_benchStats[0]);
+        benchReport("queue_pull", sizes[i], &g_benchStats[1]);
+    }
+}
+
+#if ( OS_USE_RING == 1 )
+/**
+* @fn static void benchRing(void)
+* @brief Benchmark del costo por elemento de ringPush() y ringPull() sin bloqueo, comparable con benchQueue()
+* @param  Ninguno
+* @return Nada
+*/
+static void benchRing(void)
+{
+    static const uint32_t sizes[] = { 1, 4, 16, BENCH_QUEUE_MAX_ELEMENT };
+    uint8_t  element[BENCH_QUEUE_MAX_ELEMENT] = { 0 };
+    uint32_t start;
+    uint32_t middle;
+    uint32_t i;
+    uint32_t j;
+    uint32_t k;
+
+    for(i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+    {
+        benchReset(&g_benchStats[0]);
+        benchReset(&g_benchStats[1]);
+        /* La cola lock-free guarda tantos elementos como su largo, que debe ser potencia de 2 */
+        ringInit(&g_benchRing, BENCH_QUEUE_LEN, g_benchQueueBuffer, sizes[i]);
+
+        for(j = 0; j < BENCH_QUEUE_SAMPLES; j++)
+        {
+            start = BENCH_NOW();
+            for(k = 0; k < BENCH_QUEUE_LEN; k++)
+            {
+                ringPush(&g_benchRing, element);
+            }
+            middle = BENCH_NOW();
+            for(k = 0; k < BENCH_QUEUE_LEN; k++)
+            {
+                ringPull(&g_benchRing, element, 0);
+            }
+            benchRecord(&g_benchStats[0], (middle - start) / BENCH_QUEUE_LEN);
+            benchRecord(&g_benchStats[1], (BENCH_NOW() - middle) / BENCH_QUEUE_LEN);
+        }
+
+        benchReport("ring_push", sizes[i], &g_benchStats[0]);
+        benchReport("ring_pull", sizes[i], &g_benchStats[1]);
+    }
+}
+#endif
+
+#if ( OS_USE_LOG == 1 )
+/**
+* @fn static void benchLog(void)
+* @brief Benchmark del costo de OS_LOG() con 4 argumentos frente a snprintf() del mismo formato
+* @param  Ninguno
+* @return Nada
+* @note Tambien informa los bytes de un registro binario y los del texto equivalente
+*/
+static void benchLog(void)
+{
+    static uint8_t buffer[BENCH_LOG_BATCH * OS_LOG_RECORD_MAX_SIZE];
+    char     line[BENCH_LINE_LENGTH];
+    uint32_t start;
+    uint32_t binaryLen = 0;
+    uint32_t textLen = 0;
+    uint32_t i;
+    uint32_t j;
+
+    benchReset(&g_benchStats[0]);
+    benchReset(&g_benchStats[1]);
+
+    for(j = 0; j < BENCH_QUEUE_SAMPLES; j++)
+    {
+        start = BENCH_NOW();
+        for(i = 0; i < BENCH_LOG_BATCH; i++)
+        {
+            OS_LOG("Led %u encendido: %u ms, flancos descendentes %u ms, ascendentes %u ms\n", i, j, 730, 800);
+        }
+        benchRecord(&g_benchStats[0], (BENCH_NOW() - start) / BENCH_LOG_BATCH);
+        binaryLen = logRead(buffer, sizeof(buffer), 0) / BENCH_LOG_BATCH;
+
+        start = BENCH_NOW();
+        for(i = 0; i < BENCH_LOG_BATCH; i++)
+        {
+            textLen = snprintf(line, sizeof(line), "Led %u encendido: %u ms, flancos descendentes %u ms, ascendentes %u ms\n",
+                               (unsigned int)i, (unsigned int)j, 730U, 800U);
+        }
+        benchRecord(&g_benchStats[1], (BENCH_NOW() - start) / BENCH_LOG_BATCH);
+    }
+
+    benchReport("log_write", 4, &g_benchStats[0]);
+    benchReport("log_snprintf", 4, &g_benchStats[1]);
+
+    snprintf(line, sizeof(line), "# log: %lu bytes por registro binario, %lu bytes de texto, %lu descartados\n",
+             (unsigned long)binaryLen, (unsigned long)textLen, (unsigned long)logGetDropped());
+    g_benchPrint(line);
+}
+#endif
+
+/**
+* @fn static void benchIRQHandler(void)
+* @brief IRQ del benchmark de latencia - Envia a la cola la marca de entrada a la IRQ
+* @param  Ninguno
+* @return Nada
+*/
+static void benchIRQHandler(void)
+{
+    uint32_t stamp = BENCH_NOW();
+
+    #if ( OS_USE_RING == 1 )
+        if(g_benchUseRing)
+        {
+            ringPush(&g_benchRing, &stamp);
+            return;
+        }
+    #endif
+    queuePushFromISR(&g_benchQueue, &stamp);
+}
+
+/**
+* @fn static void wakeTask(void * parameters)
+* @brief Tarea auxiliar del benchmark de latencia - Espera las marcas de la IRQ
+* @param  parameters : No se usa
+* @return Nada
+*/
+static void wakeTask(void * parameters)
+{
+    uint32_t isrStamp;
+    uint32_t now;
+
+    while(1)
+    {
+        #if ( OS_USE_RING == 1 )
+            if(g_benchUseRing)
+            {
+                ringPull(&g_benchRing, &isrStamp, OS_MAX_DELAY);
+            }
+            else
+        #endif
+        {
+            queuePull(&g_benchQueue, &isrStamp, OS_MAX_DELAY);
+        }
+        now = BENCH_NOW();
+        if(g_benchStop)
+        {
+            break;
+        }
+        benchRecord(&g_benchStats[0], isrStamp - g_benchStamp);
+        benchRecord(&g_benchStats[1], now - isrStamp);
+    }
+
+    taskDelete(osGetCurrentTask());
+}
+
+/**
+* @fn static void benchIsrWakeup(bool useRing)
+* @brief Benchmark de la latencia desde que se genera una IRQ hasta que corre la tarea que despierta
+* @param  useRing : true para pasar la marca por ringPush(), false para hacerlo por queuePushFromISR() -
+                    Se ignora con OS_USE_RING == 0
+* @return Nada
+* @note Se informan por separado la entrada a la IRQ y el paso de la IRQ a la tarea
+*/
+static void benchIsrWakeup(bool useRing)
+{
+    uint32_t i;
+
+    benchReset(&g_benchStats[0]);
+    benchReset(&g_benchStats[1]);
+    g_benchStop = false;
+    queueInit(&g_benchQueue, 2, g_benchQueueBuffer, sizeof(uint32_t));
+    #if ( OS_USE_RING == 1 )
+        g_benchUseRing = useRing;
+        ringInit(&g_benchRing, 2, g_benchQueueBuffer, sizeof(uint32_t));
+    #else
+        useRing = false;
+    #endif
+    irqAttach(BENCH_IRQ, benchIRQHandler, OS_MAX_SYSCALL_IRQ_PRIO);
+    taskCreate(wakeTask, BENCH_TASK_PRIORITY - 1, g_benchHelperStack[0], sizeof(g_benchHelperStack[0]),
+               "wakeTask", (void *)0, NULL);
+    /* Dejamos que la tarea auxiliar se bloquee en la cola */
+    taskDelay(1);
+
+    for(i = 0; i < BENCH_SAMPLES; i++)
+    {
+        g_benchStamp = BENCH_NOW();
+        BENCH_TRIGGER_IRQ();
+    }
+
+    g_benchStop = true;
+    BENCH_TRIGGER_IRQ();
+    irqDetach(BENCH_IRQ);
+
+    benchReport(useRing ? "ring_isr_entry" : "isr_entry", 0, &g_benchStats[0]);
+    benchReport(useRing ? "ring_isr_to_task" : "isr_to_task", 0, &g_benchStats[1]);
+}
+
+/**
+* @fn static void sleepTask(void * parameters)
+* @brief Tarea auxiliar del benchmark del SysTick - Se demora en un lazo hasta que la borran
+* @param  parameters : Ticks de cada demora
+* @return Nada
+*/
+static void sleepTask(void * parameters)
+{
+    while(1)
+    {
+        taskDelay((tick_t)(uintptr_t)parameters);
+    }
+}
+
+/**
+* @fn static void benchSysTick(tick_t sleepTicks)
+* @brief Benchmark del costo del SysTick y de su actualizacion de tareas demoradas segun su cantidad
+* @param  sleepTicks : Demora de las tareas auxiliares - 1 para que todas venzan en cada tick medido,
+                       BENCH_SLEEP_TICKS para que ninguna venza durante el benchmark
+* @return Nada
+* @note Cada muestra es osGetTickCycles() y osGetTickUpdateCycles() de un tick distinto. El primero
+        incluye la contabilizacion de estadisticas y el scheduler, el segundo solo delayUpdate()
+*/
+static void benchSysTick(tick_t sleepTicks)
+{
+    static const uint32_t counts[] = { 0, 4, 16, BENCH_HELPERS };
+    const char * suffix = (1 == sleepTicks) ? "_expire" : "";
+    char     name[BENCH_LINE_LENGTH];
+    uint8_t  ids[BENCH_HELPERS];
+    tick_t   tick;
+    uint32_t i;
+    uint32_t j;
+
+    for(i = 0; i < sizeof(counts) / sizeof(counts[0]); i++)
+    {
+        benchReset(&g_benchStats[0]);
+        benchReset(&g_benchStats[1]);
+        for(j = 0; j < counts[i]; j++)
+        {
+            taskCreate(sleepTask, BENCH_TASK_PRIORITY - 1, g_benchHelperStack[j], sizeof(g_benchHelperStack[j]),
+                       "sleepTask", (void *)(uintptr_t)sleepTicks, &ids[j]);
+        }
+        /* Dejamos que las tareas auxiliares se demoren */
+        taskDelay(1);
+
+        tick = taskGetTickCount();
+        while(g_benchStats[0].count < BENCH_TICK_SAMPLES)
+        {
+            /* Esperamos el proximo tick. Con demoras de 1 tick las tareas auxiliares, de mayor prioridad,
+               vuelven a demorarse antes de que se lea la medicion */
+            while(tick == taskGetTickCount())
+            {
+            }
+            tick = taskGetTickCount();
+            benchRecord(&g_benchStats[0], osGetTickCycles());
+            benchRecord(&g_benchStats[1], osGetTickUpdateCycles());
+        }
+
+        for(j = 0; j < counts[i]; j++)
+        {
+            taskDelete(ids[j]);
+        }
+
+        snprintf(name, sizeof(name), "systick%s", suffix);
+        benchReport(name, counts[i], &g_benchStats[0]);
+        snprintf(name, sizeof(name), "delay_update%s", suffix);
+        benchReport(name, counts[i], &g_benchStats[1]);
+    }
+}
+
+/**
+* @fn static void benchTask(void * parameters)
+* @brief Tarea que corre los benchmarks
+* @param  parameters : No se usa
+* @return Nada
+*/
+static void benchTask(void * parameters)
+{
+    g_benchPrint("# bench,name,param,samples,min,avg,max,unit\n");
+
+    benchContextSwitch();
+    benchSemphrPingPong();
+    benchQueue();
+    #if ( OS_USE_RING == 1 )
+        benchRing();
+    #endif
+    #if ( OS_USE_LOG == 1 )
+        benchLog();
+    #endif
+    benchIsrWakeup(false);
+    #if ( OS_USE_RING == 1 )
+        benchIsrWakeup(true);
+    #endif
+    benchSysTick(BENCH_SLEEP_TICKS);
+    benchSysTick(1);
+
+    g_benchPrint("# end\n");
+
+    if(NULL != g_benchDone)
+    {
+        g_benchDone();
+    }
+
+    taskDelete(osGetCurrentTask());
+}
+/*==================[external functions definition]==========================*/
+/**
+* @fn osReturn_t benchInit(benchPrint_t print, benchDone_t done)
+* @brief Funcion que crea la tarea de benchmarks, que corre al arrancar el scheduler
+* @param  print : Funcion que imprime cada linea de resultados
+* @param  done  : Funcion a llamar al terminar, NULL si no hace falta
+* @return OS_RESULT_ERROR si no se pudo crear la tarea, OS_RESULT_OK caso contrario
+* @note Las tareas auxiliares ocupan hasta BENCH_HELPERS lugares de tareas ademas de la de benchmarks
+*/
+osReturn_t benchInit(benchPrint_t print, benchDone_t done)
+{
+    g_benchPrint = print;
+    g_benchDone  = done;
+
+    return taskCreate(benchTask, BENCH_TASK_PRIORITY, g_benchTaskStack, sizeof(g_benchTaskStack), "benchTask",
+                      (void *)0, NULL);
+}
+/*==================[end of file]============================================*/
@@ -0,0 +1,68 @@
+/** 
+* @file  main.c
+* @brief Micro-benchmarks del kernel en el target - Los resultados salen por UART_USB
+* @note  Copyright 2019 - Esp. Ing. Matias Alvarez.
+*/
+
+/*==================[inclusions]=============================================*/
+/* OS Includes */
+#include "OS_config.h"
+#include "OS.h"
+#include "bench.h"
+
+/* Driver & Board Includes */
+#include "board.h"
+#include "uart.h"
+
+/* C Includes */
+#include <stdint.h>
+/*==================[macros]=================================================*/
+
+/*==================[typedef]================================================*/
+
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+* @fn static void benchPrint(const char * line)
+* @brief Imprime una linea de resultados
+* @param line : Linea a imprimir
+* @return Nada
+* @note La UART no tiene buffer de transmision: la escritura termina antes del proximo benchmark y
+        no agrega IRQs a las mediciones
+*/
+static void benchPrint(const char * line)
+{
+    uartWriteString(UART_USB, (char *)line);
+}
+/*==================[external functions definition]==========================*/
+int main(void)
+{
+    /* Configuramos placa */
+    Board_Init();
+    SystemCoreClockUpdate();
+
+    /* Configuramos UART */
+    uartConfig(UART_USB, BAUDRATE_115200);
+
+    /* Habilitamos el contador de ciclos del DWT, que usan las mediciones */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    /* Creacion de la tarea de benchmarks */
+    benchInit(benchPrint, NULL);
+
+    /* Start the scheduler */
+    taskStartScheduler();
+
+    /* No se deberia arribar aqui nunca */
+    return 1;
+}
+
+/*==================[end of file]============================================*/
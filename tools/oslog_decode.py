@@ -0,0 +1,171 @@
+#!/usr/bin/env python3
+"""Decodificador del log binario de OS_LOG() (examples/OS/src/OS_log.c).
+
+Lee los registros que envia logRead(), por ejemplo por la UART, y arma el texto con
+los formatos de la seccion os_log_fmt del ELF que corre en la placa.
+
+Uso:
+    oslog_decode.py firmware.axf [log.bin]
+
+Sin archivo de log lee de la entrada estandar, por ejemplo:
+    stty -F /dev/ttyUSB1 115200 raw && oslog_decode.py out/lpc4337_m4/OS.axf < /dev/ttyUSB1
+
+Cada registro es una palabra de cabecera, (posicion del formato << 8) | 0xA0 | cantidad
+de argumentos, seguida de un uint32_t por argumento, todo en little endian. Si el flujo
+se corta en el medio de un registro se descartan bytes hasta volver a sincronizar.
+"""
+
+import re
+import struct
+import sys
+
+LOG_SECTION = "os_log_fmt"
+LOG_SYNC = 0xA0
+LOG_SYNC_MASK = 0xF8
+LOG_NARGS_MASK = 0x07
+
+SHF_ALLOC = 0x2
+SHT_PROGBITS = 1
+
+# Conversiones de printf admitidas: los argumentos viajan como uint32_t
+CONVERSION = re.compile(r"%([-+ #0]*)(\d+)?(?:\.(\d+))?(?:hh|h|ll|l|z|j|t)?([diouxXcs%])")
+
+
+class Elf:
+    """Secciones de un ELF de 32 o 64 bits."""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.data = f.read()
+        if self.data[:4] != b"\x7fELF":
+            raise ValueError("%s no es un ELF" % path)
+        is64 = self.data[4] == 2
+        endian = "<" if self.data[5] == 1 else ">"
+        if is64:
+            shoff, = struct.unpack_from(endian + "Q", self.data, 0x28)
+            shentsize, shnum, shstrndx = struct.unpack_from(endian + "HHH", self.data, 0x3A)
+            shdr = endian + "IIQQQQIIQQ"
+        else:
+            shoff, = struct.unpack_from(endian + "I", self.data, 0x20)
+            shentsize, shnum, shstrndx = struct.unpack_from(endian + "HHH", self.data, 0x2E)
+            shdr = endian + "IIIIIIIIII"
+        raw = [struct.unpack_from(shdr, self.data, shoff + i * shentsize) for i in range(shnum)]
+        names = raw[shstrndx]
+        self.sections = []
+        for name, kind, flags, addr, offset, size, _, _, _, _ in raw:
+            self.sections.append({
+                "name": self._cstring(names[4] + name),
+                "type": kind,
+                "flags": flags,
+                "addr": addr,
+                "data": self.data[offset:offset + size],
+            })
+
+    def _cstring(self, offset):
+        return self.data[offset:self.data.index(b"\0", offset)].decode("latin-1")
+
+    def section(self, name):
+        for section in self.sections:
+            if section["name"] == name:
+                return section["data"]
+        return None
+
+    def string_at(self, addr):
+        """Cadena en la direccion addr de alguna seccion cargada en memoria, None si no existe."""
+        for section in self.sections:
+            if (section["type"] == SHT_PROGBITS and section["flags"] & SHF_ALLOC and
+                    section["addr"] <= addr < section["addr"] + len(section["data"])):
+                data = section["data"]
+                start = addr - section["addr"]
+                end = data.find(b"\0", start)
+                return data[start:end if end >= 0 else len(data)].decode("latin-1")
+        return None
+
+
+class Decoder:
+    """Arma el texto de los registros con los formatos del ELF."""
+
+    def __init__(self, elf):
+        self.elf = elf
+        self.formats = elf.section(LOG_SECTION)
+        if self.formats is None:
+            raise ValueError("el ELF no tiene la seccion %s" % LOG_SECTION)
+        self.cache = {}
+        self.buffer = b""
+        self.skipped = 0
+
+    def _format(self, offset):
+        """Formato en la posicion offset y su cantidad de argumentos, None si no es un formato."""
+        if offset not in self.cache:
+            entry = None
+            if offset < len(self.formats) and (offset == 0 or self.formats[offset - 1] == 0):
+                end = self.formats.find(b"\0", offset)
+                if end > offset:
+                    fmt = self.formats[offset:end].decode("latin-1")
+                    nargs = sum(1 for m in CONVERSION.finditer(fmt) if m.group(4) != "%")
+                    entry = (fmt, nargs)
+            self.cache[offset] = entry
+        return self.cache[offset]
+
+    def _convert(self, match, args):
+        flags, width, precision, conv = match.groups()
+        if conv == "%":
+            return "%"
+        value = args.pop(0)
+        spec = "%" + flags + (width or "") + ("." + precision if precision else "")
+        if conv in "di":
+            return (spec + "d") % (value - (1 << 32) if value & 0x80000000 else value)
+        if conv == "u":
+            return (spec + "d") % value
+        if conv == "c":
+            return (spec + "c") % chr(value & 0xFF)
+        if conv == "s":
+            text = self.elf.string_at(value)
+            return (spec + "s") % (text if text is not None else "<0x%08x>" % value)
+        return (spec + conv) % value
+
+    def feed(self, data):
+        """Agrega bytes recibidos y devuelve el texto de los registros completos."""
+        self.buffer += data
+        out = []
+        while len(self.buffer) >= 4:
+            header, = struct.unpack_from("<I", self.buffer)
+            nargs = header & LOG_NARGS_MASK
+            entry = None
+            if header & LOG_SYNC_MASK == LOG_SYNC:
+                entry = self._format(header >> 8)
+            if entry is None or entry[1] != nargs:
+                # No es el comienzo de un registro: buscamos la proxima cabecera
+                self.buffer = self.buffer[1:]
+                self.skipped += 1
+                continue
+            size = 4 * (1 + nargs)
+            if len(self.buffer) < size:
+                break
+            args = list(struct.unpack_from("<%dI" % nargs, self.buffer, 4))
+            self.buffer = self.buffer[size:]
+            out.append(CONVERSION.sub(lambda m: self._convert(m, args), entry[0]))
+        return "".join(out)
+
+
+def main(argv):
+    if len(argv) not in (2, 3):
+        sys.stderr.write(__doc__)
+        return 2
+    decoder = Decoder(Elf(argv[1]))
+    stream = open(argv[2], "rb") if len(argv) == 3 else sys.stdin.buffer
+    with stream:
+        while True:
+            # read1 devuelve lo que haya disponible, para mostrar el log a medida que llega
+            data = stream.read1(4096) if hasattr(stream, "read1") else stream.read(4096)
+            if not data:
+                break
+            sys.stdout.write(decoder.feed(data))
+            sys.stdout.flush()
+    if decoder.skipped:
+        sys.stderr.write("%d bytes descartados por falta de sincronismo\n" % decoder.skipped)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))